@@ -7,15 +7,15 @@
 
 using namespace QDP;
 
-#if defined(QDP_DEBUG_MEMORY)
-#define START_CODE() QDP::Allocator::theQDPAllocator::Instance().pushFunc(__func__, __LINE__)
-#define END_CODE()   QDP::Allocator::theQDPAllocator::Instance().popFunc()
-
-#else
-#define START_CODE() QDP_PUSH_PROFILE(QDP::getProfileLevel())
-#define END_CODE()   QDP_POP_PROFILE()
-
-#endif
+// Tag the memory allocated by a routine with the memory profile on (-pmem),
+// and open a profile level with profiling on. END_CODE must be in the scope
+// of START_CODE, which decides for both
+#define START_CODE() const bool qdp_code_mem_tag = QDP::getMemoryProfile(); \
+                     const bool qdp_code_prof = (QDP::getProfileLevel() != 0); \
+                     if (qdp_code_mem_tag) QDP::Allocator::theQDPAllocator::Instance().pushFunc(__func__, __LINE__); \
+                     if (qdp_code_prof) QDP_PUSH_PROFILE(QDP::getProfileLevel())
+#define END_CODE()   do { if (qdp_code_prof) QDP_POP_PROFILE(); \
+                          if (qdp_code_mem_tag) QDP::Allocator::theQDPAllocator::Instance().popFunc(); } while(0)
 
 
 enum Reunitarize {REUNITARIZE, REUNITARIZE_ERROR, REUNITARIZE_LABEL};
@@ -0,0 +1,54 @@
+/*! \file
+ *  \brief Merge MapObjectDisk files, e.g. the shards of a MapObjectDiskShard, into one
+ *
+ *  Usage:  merge_map_obj_disk -o <output> <input> [<input> ...]
+ *          merge_map_obj_disk -o <output> -shards <base>
+ */
+
+#include "qdp.h"
+#include "qdp_map_obj_disk.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace QDP;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  std::string output;
+  std::string shard_base;
+  std::vector<std::string> inputs;
+
+  for(int i=1; i < argc; i++) { 
+    if (strcmp(argv[i], "-o") == 0 && i+1 < argc) {
+      output = argv[++i];
+    }
+    else if (strcmp(argv[i], "-shards") == 0 && i+1 < argc) {
+      shard_base = argv[++i];
+    }
+    else if (argv[i][0] != '-') {
+      inputs.push_back(argv[i]);
+    }
+  }
+
+  if (shard_base != "") {
+    std::vector<std::string> shards = MapObjDiskEnv::shardFiles(shard_base);
+    inputs.insert(inputs.end(), shards.begin(), shards.end());
+  }
+
+  if (output == "" || inputs.size() == 0) { 
+    QDPIO::cerr << "Usage: " << argv[0] << " -o <output> <input> [<input> ...]" << std::endl;
+    QDPIO::cerr << "       " << argv[0] << " -o <output> -shards <base>" << std::endl;
+    QDP_abort(1);
+  }
+
+  MapObjDiskEnv::mergeFiles(inputs, output);
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
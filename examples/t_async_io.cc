@@ -0,0 +1,109 @@
+/*! \file
+ *  \brief Test files written in the background
+ *
+ *  Writes the same data with BinaryFileWriter and BinaryAsyncFileWriter,
+ *  including two background writers open at the same time and a file
+ *  larger than one buffer chunk, and checks the files read back the same
+ */
+
+#include "examples.h"
+
+//! Some data of n doubles
+void fill(multi1d<double>& d, int n, double scale)
+{
+  d.resize(n);
+  for(int i=0; i < n; ++i)
+    d[i] = scale*i;
+}
+
+//! Read an int and an array back and compare
+bool check(const std::string& file, int n, const multi1d<double>& d)
+{
+  BinaryFileReader bin(file);
+  int n2;
+  multi1d<double> d2;
+  read(bin, n2);
+  read(bin, d2);
+  bin.close();
+
+  bool ok = (n2 == n) && (d2.size() == d.size());
+  for(int i=0; ok && i < d.size(); ++i)
+    ok = (d2[i] == d[i]);
+
+  QDPIO::cout << file << ": " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,4};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  bool ok = true;
+
+  multi1d<double> a, b, big;
+  fill(a, 100, 1.0);
+  fill(b, 200, -0.5);
+  fill(big, 3*1024*1024, 0.25);   // more than one 16 MiB chunk
+
+  // Two background writers open at the same time
+  {
+    BinaryAsyncFileWriter wa("t_async_io_a.bin");
+    BinaryAsyncFileWriter wb("t_async_io_b.bin");
+    write(wa, 1);
+    write(wb, 2);
+    write(wa, a);
+    write(wb, b);
+    wa.close();
+    wb.close();
+  }
+  waitCheckpoint();
+  ok = check("t_async_io_a.bin", 1, a) && ok;
+  ok = check("t_async_io_b.bin", 2, b) && ok;
+
+  // A large file, left to the next writer to wait on
+  {
+    BinaryAsyncFileWriter w("t_async_io_c.bin");
+    write(w, 3);
+    write(w, big);
+  }
+  {
+    BinaryAsyncFileWriter w("t_async_io_d.bin");
+    write(w, 4);
+    write(w, a);
+  }
+  waitCheckpoint();
+  ok = check("t_async_io_c.bin", 3, big) && ok;
+  ok = check("t_async_io_d.bin", 4, a) && ok;
+
+  // Same bytes as the synchronous writer
+  {
+    BinaryFileWriter w("t_async_io_e.bin");
+    write(w, 3);
+    write(w, big);
+    QDPIO::cout << "checksums: " << w.getChecksum();
+    w.close();
+
+    BinaryAsyncFileWriter wc("t_async_io_f.bin");
+    write(wc, 3);
+    write(wc, big);
+    QDPIO::cout << " " << wc.getChecksum() << std::endl;
+  }
+  waitCheckpoint();
+  ok = check("t_async_io_e.bin", 3, big) && ok;
+
+  QDPIO::cout << "t_async_io: " << (ok ? "PASSED" : "FAILED") << std::endl;
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -8,6 +8,62 @@
 using namespace QDP;
 
 
+//! A set with empty subsets: only subsets 0 and 3 hold sites
+struct SparseSetFunc : public SetFunc
+{
+  int operator() (const multi1d<int>& coordinate) const
+  {
+    int s = 0;
+    for(int mu=0; mu < coordinate.size(); ++mu)
+      s += coordinate[mu];
+    return 3*(s % 2);
+  }
+
+  int numSubsets() const {return 5;}
+};
+
+
+//! Compare sumMulti, plain and on an array, with a sum on each subset
+bool checkSumMulti(XMLWriter& xml_out, const std::string& name, const Set& ss)
+{
+  const int nfield = 5;
+  multi1d<LatticeComplex> cc(nfield);
+  for(int j=0; j < nfield; ++j)
+    gaussian(cc[j]);
+
+  LatticeReal r;
+  gaussian(r);
+
+  multi1d<Complex> sm = sumMulti(cc[0]*r, ss);
+  multi2d<Complex> sma = sumMulti(cc, ss);
+
+  Double diff = 0;
+  Double diffa = 0;
+  Double norm = 0;
+  for(int k=0; k < ss.numSubsets(); ++k)
+  {
+    Complex ref = sum(cc[0]*r, ss[k]);
+    diff += norm2(sm[k] - ref);
+    norm += norm2(ref);
+
+    for(int j=0; j < nfield; ++j)
+      diffa += norm2(sma(j,k) - sum(cc[j], ss[k]));
+  }
+
+  push(xml_out, "sumMulti");
+  write(xml_out, "set", name);
+  write(xml_out, "diff", diff);
+  write(xml_out, "diffa", diffa);
+  pop(xml_out);
+
+  // The threaded sums add in another order
+  bool ok = toBool(diff <= 1.0e-24*norm) && toBool(diffa <= 1.0e-24*norm*nfield);
+  QDPIO::cout << "sumMulti on " << name << ": " << diff << " " << diffa
+	      << (ok ? "  ok" : "  FAILED") << std::endl;
+  return ok;
+}
+
+
 int main(int argc, char *argv[])
 {
   // Put the machine into a known state
@@ -146,6 +202,16 @@ int main(int argc, char *argv[])
   write(xml_out, "C_eq_traceSpin_outerProduct",lctmp1);
   pop(xml_out);
 
+  // Multiple sums, including a set with empty subsets
+  {
+    Set sparse;
+    sparse.make(SparseSetFunc());
+
+    bool ok = checkSumMulti(xml_out, "rb", rb);
+    ok = checkSumMulti(xml_out, "sparse", sparse) && ok;
+    QDPIO::cout << "sumMulti: " << (ok ? "PASSED" : "FAILED") << std::endl;
+  }
+
 
 #if 0
 
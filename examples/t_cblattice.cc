@@ -0,0 +1,146 @@
+/*! \file
+ *  \brief Test checkerboarded (half volume) lattice fields
+ *
+ *  Compares the linear algebra, shifts and reductions on checkerboarded
+ *  fermions with the same operations on full fermions under rb[cb],
+ *  and times a half volume axpy against the subset one
+ */
+
+#include "examples.h"
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  LatticeColorMatrix u;
+  gaussian(u);
+
+  LatticeFermion psi, chi;
+  gaussian(psi);
+  gaussian(chi);
+
+  Real a = 0.37;
+
+  for(int cb=0; cb < 2; ++cb)
+  {
+    LatticeFermionCB psi_cb(cb), chi_cb(cb);
+    psi_cb = psi;
+    chi_cb = chi;
+
+    // Linear algebra against the subset versions
+    LatticeFermion ref = zero;
+    ref[rb[cb]] = a*psi + chi;
+    chi_cb += a*psi_cb;
+
+    LatticeFermion full = chi_cb;
+    QDPIO::cout << "cb = " << cb << "  axpy: " << norm2(full - ref) << std::endl;
+
+    ref[rb[cb]] = Gamma(7) * psi;
+    chi_cb = Gamma(7) * psi_cb;
+    full = chi_cb;
+    QDPIO::cout << "cb = " << cb << "  gamma: " << norm2(full - ref) << std::endl;
+
+    // Reductions
+    chi_cb = chi;
+    QDPIO::cout << "cb = " << cb << "  norm2: "
+		<< norm2(psi_cb) - norm2(psi, rb[cb])
+		<< "  innerProduct: "
+		<< norm2(innerProduct(chi_cb, psi_cb) - innerProduct(chi, psi, rb[cb]))
+		<< "  other cb: " << norm2(psi_cb, rb[1-cb]) << std::endl;
+
+    // Shifts land on the other checkerboard
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeFermionCB eta_cb(1-cb);
+      LatticeFermion eta = zero;
+
+      eta_cb = u * shift(psi_cb, FORWARD, mu);
+      eta[rb[1-cb]] = u * shift(psi_cb, FORWARD, mu);
+      ref[rb[1-cb]] = u * shift(psi, FORWARD, mu);
+
+      full = eta_cb;
+      QDPIO::cout << "cb = " << cb << "  mu = " << mu << "  shift: "
+		  << norm2(full - ref, rb[1-cb]) << "  "
+		  << norm2(eta - ref, rb[1-cb])
+		  << "  back: " << norm2(shift(adj(u) * eta_cb, BACKWARD, mu), rb[1-cb]) << std::endl;
+    }
+  }
+
+  // Binary I/O round trip
+  {
+    LatticeFermionCB psi_cb(1), eta_cb(1);
+    psi_cb = psi;
+
+    BinaryBufferWriter bin;
+    write(bin, psi_cb);
+
+    BinaryBufferReader bout(bin.str());
+    read(bout, eta_cb);
+    QDPIO::cout << "binary I/O: " << norm2(eta_cb - psi_cb) << std::endl;
+  }
+
+#if __cplusplus >= 201103L
+  // Moves: the field moved from stays usable
+  {
+    LatticeFermionCB psi_cb(1), chi_cb(1), eta_cb(0);
+    psi_cb = psi;
+    chi_cb = chi;
+
+    LatticeFermionCB a_cb(std::move(psi_cb));
+    psi_cb = chi;
+    QDPIO::cout << "move then assign: " << norm2(psi_cb - chi_cb)
+		<< "  moved: " << norm2(a_cb - psi, rb[1])
+		<< "  cb: " << psi_cb.checkerboard() << std::endl;
+
+    psi_cb = psi;
+    chi_cb = std::move(psi_cb);
+    psi_cb = a_cb + chi_cb;
+    QDPIO::cout << "move assign then expr: " << norm2(psi_cb - 2*psi, rb[1])
+		<< "  " << norm2(chi_cb - psi, rb[1]) << std::endl;
+
+    // Other checkerboard: a copy, the destination keeps its own
+    eta_cb = std::move(chi_cb);
+    chi_cb = psi;
+    QDPIO::cout << "move assign other cb: " << norm2(eta_cb)
+		<< "  cb: " << eta_cb.checkerboard()
+		<< "  source: " << norm2(chi_cb - psi, rb[1]) << std::endl;
+  }
+#endif
+
+  // Timings
+  {
+    LatticeFermionCB psi_cb(0), chi_cb(0);
+    psi_cb = psi;
+    chi_cb = chi;
+
+    const int iter = 200;
+    StopWatch swatch;
+
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < iter; ++i)
+      chi[rb[0]] += a*psi;
+    swatch.stop();
+    QDPIO::cout << "subset axpy:   " << swatch.getTimeInMicroseconds()/iter << " us" << std::endl;
+
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < iter; ++i)
+      chi_cb += a*psi_cb;
+    swatch.stop();
+    QDPIO::cout << "half vol axpy: " << swatch.getTimeInMicroseconds()/iter << " us" << std::endl;
+  }
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -0,0 +1,104 @@
+/*! \file
+ *  \brief Test compressed SU(3) link storage
+ *
+ *  Compresses a random SU(3) field to 12 and 8 reals, checks the
+ *  reconstructed matrices are still unitary and that the compressed
+ *  multiplies agree with the full ones
+ */
+
+#include "examples.h"
+
+//! Check one compressed representation
+template<class L>
+void check(const char* name, const LatticeColorMatrix& u,
+	   const LatticeFermion& psi, const LatticeHalfFermion& hpsi)
+{
+  L uc;
+  compress(uc, u);
+
+  // Reconstruct and test the result with the reunitarizer
+  LatticeColorMatrix u2;
+  decompress(u2, uc);
+
+  LatticeBoolean bad;
+  int numbad;
+  reunit(u2, bad, numbad, REUNITARIZE_ERROR);
+
+  QDPIO::cout << name << ": numbad = " << numbad
+	      << "  || u - u' || / vol = "
+	      << sqrt(norm2(u - u2)) / Real(Layout::vol()) << std::endl;
+
+  // Multiplies against the full links
+  LatticeFermion chi = uc * psi;
+  LatticeFermion chi2 = u * psi;
+  QDPIO::cout << name << ": fermion      || diff || = " << sqrt(norm2(chi - chi2)) << std::endl;
+
+  LatticeHalfFermion hchi = uc * hpsi;
+  LatticeHalfFermion hchi2 = u * hpsi;
+  QDPIO::cout << name << ": half fermion || diff || = " << sqrt(norm2(hchi - hchi2)) << std::endl;
+
+  LatticeColorMatrix w = uc * u;
+  LatticeColorMatrix w2 = u * u;
+  QDPIO::cout << name << ": color matrix || diff || = " << sqrt(norm2(w - w2)) << std::endl;
+
+  // Subset version
+  chi = zero;
+  multiply(chi, uc, psi, rb[1]);
+  QDPIO::cout << name << ": rb[1] fermion || diff || = "
+	      << sqrt(norm2(chi - chi2, rb[1])) << "  || rb[0] || = "
+	      << sqrt(norm2(chi, rb[0])) << std::endl;
+
+  // Timings
+  const int iter = 100;
+  StopWatch swatch;
+
+  swatch.reset();
+  swatch.start();
+  for(int i=0; i < iter; ++i)
+    chi2 = u * psi;
+  swatch.stop();
+  double full_secs = swatch.getTimeInSeconds();
+
+  swatch.reset();
+  swatch.start();
+  for(int i=0; i < iter; ++i)
+    multiply(chi, uc, psi, all);
+  swatch.stop();
+  double comp_secs = swatch.getTimeInSeconds();
+
+  QDPIO::cout << name << ": full " << full_secs << " s, compressed "
+	      << comp_secs << " s for " << iter << " multiplies" << std::endl;
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Random SU(3) field
+  LatticeColorMatrix u;
+  gaussian(u);
+  reunit(u);
+
+  LatticeFermion psi;
+  gaussian(psi);
+
+  LatticeHalfFermion hpsi;
+  gaussian(hpsi);
+
+  check<LatticeColorMatrixR12>("R12", u, psi, hpsi);
+  check<LatticeColorMatrixR8>("R8", u, psi, hpsi);
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -0,0 +1,282 @@
+/*! \file
+ *  \brief Test the half precision (REAL16) conversions
+ *
+ *  Checks the word conversions against a reference rounding for known
+ *  values, ties, overflow, NaN and denormals, round trips every half
+ *  value, and checks convertPrecision and norm2 on lattice fields
+ */
+
+#include "examples.h"
+#include <cmath>
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+
+//! Half bits nearest to x, ties to even, done in double arithmetic
+unsigned short refToHalf(double x)
+{
+  unsigned short sign = std::signbit(x) ? 0x8000 : 0;
+  double a = std::fabs(x);
+
+  if (std::isnan(x))
+    return sign | 0x7e00;
+  if (a >= 65520.0)
+    return sign | 0x7c00;
+
+  int e;
+  std::frexp(a, &e);
+  --e;                                  // a = 1.m * 2^e
+  if (e < -14)
+    e = -14;                            // denormals share the smallest ulp
+
+  double ulp = std::ldexp(1.0, e - 10);
+  double r = std::nearbyint(a / ulp);   // default rounding is to nearest even
+
+  unsigned int bits;
+  if (r < 1024)
+    bits = (unsigned int)r;                                  // denormal or zero
+  else
+    bits = ((unsigned int)(e + 15) << 10) + (unsigned int)r - 1024;  // carries into the exponent
+
+  return sign | (unsigned short)(bits >= 0x7c00 ? 0x7c00 : bits);
+}
+
+//! Value of half bits, from the definition
+double refFromHalf(unsigned short h)
+{
+  double s = (h & 0x8000) ? -1 : 1;
+  int e = (h >> 10) & 0x1f;
+  int m = h & 0x3ff;
+
+  if (e == 0)
+    return s * std::ldexp(double(m), -24);
+  return s * std::ldexp(double(m + 1024), e - 25);
+}
+
+bool isHalfNaN(unsigned short h)
+{
+  return ((h & 0x7c00) == 0x7c00) && ((h & 0x3ff) != 0);
+}
+
+//! Compare the word converters with the reference on a list of doubles
+bool checkValues(const std::string& what, const std::vector<double>& x)
+{
+  const int n = x.size();
+  std::vector<REAL32> f(n);
+  std::vector<REAL16> hf(n), hd(n);
+
+  for(int i=0; i < n; ++i)
+    f[i] = float(x[i]);
+
+  convertWords(&(hf[0]), &(f[0]), n);
+  convertWords(&(hd[0]), &(x[0]), n);
+
+  bool ok = true;
+  for(int i=0; i < n; ++i)
+  {
+    unsigned short ef = refToHalf(f[i]);
+    unsigned short ed = refToHalf(x[i]);
+    bool okf = (hf[i].bits == ef) || (isHalfNaN(hf[i].bits) && isHalfNaN(ef));
+    bool okd = (hd[i].bits == ed) || (isHalfNaN(hd[i].bits) && isHalfNaN(ed));
+    bool oks = (REAL16(f[i]).bits == hf[i].bits);
+
+    if (! (okf && okd && oks))
+    {
+      QDPIO::cout << "  " << what << ": " << x[i]
+		  << " float " << int(hf[i].bits) << " double " << int(hd[i].bits)
+		  << " expected " << int(ef) << " " << int(ed) << std::endl;
+      ok = false;
+    }
+  }
+
+  QDPIO::cout << what << ": " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+//! Fixed values, exact and rounded
+bool checkKnown()
+{
+  struct {double x; unsigned short h;} known[] = {
+    {0.0, 0x0000}, {-0.0, 0x8000}, {1.0, 0x3c00}, {-2.0, 0xc000},
+    {0.5, 0x3800}, {65504.0, 0x7bff}, {0.1, 0x2e66}, {1.0/3.0, 0x3555},
+    {std::ldexp(1.0, -14), 0x0400}, {std::ldexp(1.0, -24), 0x0001},
+    {std::ldexp(1023.0, -24), 0x03ff}, {-std::ldexp(1.0, -24), 0x8001}};
+
+  bool ok = true;
+  for(int i=0; i < int(sizeof(known)/sizeof(known[0])); ++i)
+  {
+    ok = ok && (REAL16(float(known[i].x)).bits == known[i].h);
+    ok = ok && (refToHalf(known[i].x) == known[i].h);
+    ok = ok && (double(float(REAL16(float(known[i].x)))) == refFromHalf(known[i].h));
+  }
+
+  QDPIO::cout << "known values: " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+//! Ties, overflow, NaN and denormals
+bool checkEdges()
+{
+  const double one = 1.0;
+  const double u = std::ldexp(1.0, -11);     // half an ulp at 1
+  const double d = std::ldexp(1.0, -25);     // half the smallest denormal
+  const double inf = std::numeric_limits<double>::infinity();
+
+  std::vector<double> x;
+  x.push_back(one + u);                       // tie, down to even
+  x.push_back(one + 3*u);                     // tie, up to even
+  x.push_back(one + u + std::ldexp(1.0, -20));   // just above a tie
+  x.push_back(one + u - std::ldexp(1.0, -20));   // just below a tie
+  x.push_back(-(one + 3*u));
+  x.push_back(65504.0 + 15.99);               // rounds down to the largest
+  x.push_back(65520.0);                       // tie, to infinity
+  x.push_back(1.0e6);
+  x.push_back(-1.0e6);
+  x.push_back(inf);
+  x.push_back(-inf);
+  x.push_back(std::numeric_limits<double>::quiet_NaN());
+  x.push_back(d);                             // tie, to zero
+  x.push_back(3*d);                           // tie, up to 2
+  x.push_back(5*d);                           // tie, down to 2
+  x.push_back(d * 1.0001);                    // just above a tie
+  x.push_back(std::ldexp(1.0, -26));          // underflow to zero
+  x.push_back(-std::ldexp(1.0, -26));         // and to -0
+  x.push_back(std::ldexp(1.0, -14) - d);      // tie at the top of the denormals
+  x.push_back(std::ldexp(2047.0, -25));       // rounds up to the smallest normal
+  x.push_back(1.0e-30);
+  x.push_back(std::ldexp(1.0, -130));         // a float denormal
+
+  // Off a tie by less than a float ulp: seen only by the double converter
+  x.push_back(one + u + std::ldexp(1.0, -40));
+  x.push_back(one + 3*u - std::ldexp(1.0, -40));
+  x.push_back(d + std::ldexp(1.0, -60));
+
+  return checkValues("ties, overflow, NaN, denormals", x);
+}
+
+//! Every half value round trips, and every midpoint rounds to even
+bool checkExhaustive()
+{
+  bool ok = true;
+  for(unsigned int h=0; h < 0x10000; ++h)
+  {
+    unsigned short hs = h;
+    float f = REAL16::bitsToFloat(hs);
+
+    if (isHalfNaN(hs))
+    {
+      ok = ok && (f != f) && isHalfNaN(REAL16::floatToBits(f));
+      continue;
+    }
+
+    if ((hs & 0x7c00) != 0x7c00)
+      ok = ok && (double(f) == refFromHalf(hs));
+
+    ok = ok && (REAL16::floatToBits(f) == hs);
+  }
+  QDPIO::cout << "all half values round trip: " << (ok ? "ok" : "FAILED") << std::endl;
+
+  // Midpoints between neighbours, and a float ulp either side of them
+  std::vector<double> x;
+  for(unsigned int h=0; h < 0x7bff; ++h)
+  {
+    double lo = refFromHalf(h);
+    double hi = refFromHalf(h+1);
+    float mid = float(0.5*(lo + hi));        // exact in float
+
+    x.push_back(mid);
+    x.push_back(-mid);
+    x.push_back(std::nextafter(mid, 0.0f));
+    x.push_back(std::nextafter(mid, 1.0e6f));
+  }
+
+  return checkValues("all midpoints", x) && ok;
+}
+
+//! Lattice conversions, also on a subset, and the half norm
+bool checkLattice()
+{
+  bool ok = true;
+
+  LatticeFermionF psi_f;
+  gaussian(psi_f);
+
+  LatticeFermionH psi_h;
+  LatticeFermionF back_f;
+  LatticeFermionD back_d;
+  back_f = zero;
+
+  convertPrecision(psi_h, psi_f);
+  convertPrecision(back_d, psi_h);
+  convertPrecision(back_f, psi_h, rb[1]);
+
+  // Each word against the scalar converter
+  const int nw = sizeof(psi_f.elem(0)) / sizeof(REAL32);
+  bool words = true;
+  for(int i=0; i < Layout::sitesOnNode(); ++i)
+  {
+    const REAL32* f = (const REAL32*)&(psi_f.elem(i));
+    const REAL16* h = (const REAL16*)&(psi_h.elem(i));
+    const REAL64* d = (const REAL64*)&(back_d.elem(i));
+    for(int j=0; j < nw; ++j)
+      words = words && (h[j].bits == REAL16::floatToBits(f[j]))
+	&& (d[j] == double(REAL16::bitsToFloat(h[j].bits)));
+  }
+  QDPIO::cout << "lattice words: " << (words ? "ok" : "FAILED") << std::endl;
+  ok = words && ok;
+
+  // The subset conversion touches only its subset
+  Double n0 = norm2(back_f, rb[0]);
+  Double n1 = norm2(back_f - back_d, rb[1]);
+  QDPIO::cout << "subset conversion: " << n0 << " " << n1 << std::endl;
+  ok = toBool(n0 == 0) && toBool(n1 == 0) && ok;
+
+  // Half precision is good to about 2^-11 relative
+  Double rel = sqrt(norm2(back_d - psi_f) / norm2(psi_f));
+  QDPIO::cout << "relative error: " << rel << std::endl;
+  ok = toBool(rel < 1.0/2048) && ok;
+
+  // The half norm is exact sums of exact squares
+  Double nh = norm2(psi_h);
+  Double nd = norm2(back_d);
+  Double nh1 = norm2(psi_h, rb[1]);
+  Double nd1 = norm2(back_d, rb[1]);
+  QDPIO::cout << "norm2: " << nh << " " << nd << std::endl;
+  ok = toBool(fabs(nh - nd) <= 1.0e-12 * nd) && ok;
+  ok = toBool(fabs(nh1 - nd1) <= 1.0e-12 * nd1) && ok;
+
+  return ok;
+}
+
+#endif
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  bool ok = true;
+
+  ok = checkKnown() && ok;
+  ok = checkEdges() && ok;
+  ok = checkExhaustive() && ok;
+  ok = checkLattice() && ok;
+
+  QDPIO::cout << "t_half: " << (ok ? "PASSED" : "FAILED") << std::endl;
+#else
+  QDPIO::cout << "t_half: half precision fields are not in this architecture" << std::endl;
+#endif
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -0,0 +1,79 @@
+/*! \file
+ *  \brief Shift and multiply throughput of the configured site layout
+ *
+ *  Times the nearest neighbor pattern of a stencil operator,
+ *  u[mu] * shift(v, FORWARD, mu), for every direction. Build the
+ *  library with different --enable-layout choices to compare them.
+ */
+
+#include "qdp.h"
+
+using namespace QDP;
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {16,16,16,32};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#if QDP_USE_LEXICO_LAYOUT == 1
+  QDPIO::cout << "Layout: lexicographic" << std::endl;
+#elif QDP_USE_CB2_LAYOUT == 1
+  QDPIO::cout << "Layout: cb2" << std::endl;
+#elif QDP_USE_CB3D_LAYOUT == 1
+  QDPIO::cout << "Layout: cb3d" << std::endl;
+#elif QDP_USE_CB32_LAYOUT == 1
+  QDPIO::cout << "Layout: cb32" << std::endl;
+#elif QDP_USE_CB2_BLOCK_LAYOUT == 1
+  QDPIO::cout << "Layout: cb2block  block size =";
+  for(int mu=0; mu < Nd; ++mu)
+    QDPIO::cout << " " << Layout::blockSize()[mu];
+  QDPIO::cout << std::endl;
+#endif
+
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    gaussian(u[mu]);
+
+  LatticeColorMatrix v, w;
+  gaussian(v);
+
+  // Warm up the shift maps and the caches
+  for(int mu=0; mu < Nd; ++mu)
+    w = u[mu] * shift(v, FORWARD, mu);
+
+  const int iter = 20;
+  const double flops = 198.0 * Layout::vol() * iter;
+  StopWatch swatch;
+  double total = 0;
+
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < iter; ++i)
+      w = u[mu] * shift(v, FORWARD, mu);
+    swatch.stop();
+
+    double secs = swatch.getTimeInSeconds();
+    total += secs;
+
+    QDPIO::cout << "mu = " << mu << ":  " << secs << " s,  "
+		<< 1.0e-6 * flops / secs << " Mflops" << std::endl;
+  }
+
+  QDPIO::cout << "all directions: " << total << " s,  "
+	      << 1.0e-6 * Nd * flops / total << " Mflops" << std::endl;
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -196,6 +196,59 @@ void testMapObjLookups(MapObjectDisk<char, float>& the_map)
 
 
 
+//**********************************************************************************************
+//! The key encoding of the maps is the bytes a BinaryWriter writes
+template<typename K>
+void testKeyEncoding(const K& key)
+{
+  // Keys as written before the traits
+  BinaryBufferWriter bin;
+  write(bin, key);
+  std::string old_str = bin.str();
+
+  std::string new_str;
+  MapObjKeyTraits<K>::encode(new_str, key);
+  if (new_str != old_str)
+    fail(__LINE__);
+
+  // Old keys decoded by the traits, new keys read by a BinaryReader
+  K old_key, new_key;
+  MapObjKeyTraits<K>::decode(old_key, old_str.data(), old_str.size());
+  BinaryBufferReader bout(new_str);
+  read(bout, new_key);
+
+  BinaryBufferWriter old_bin, new_bin;
+  write(old_bin, old_key);
+  write(new_bin, new_key);
+  if (old_bin.str() != old_str || new_bin.str() != old_str)
+    fail(__LINE__);
+}
+
+
+void testKeyEncodings()
+{
+  QDPIO::cout << "Key encoding test:" << std::endl;
+
+  testKeyEncoding(int(-5));
+  testKeyEncoding(int(0x01020304));
+  testKeyEncoding((unsigned int)(0xfedcba98));
+  testKeyEncoding((short int)(-2));
+  testKeyEncoding((unsigned short int)(0x0102));
+  testKeyEncoding((long int)(-1234567));
+  testKeyEncoding((unsigned long int)(0xfedcba98UL));
+  testKeyEncoding((long long int)(0x0102030405060708LL));
+  testKeyEncoding((long long int)(-0x0102030405060708LL));
+  testKeyEncoding('q');
+
+  KeyPropColorVec_t key = {3,-7,0x01020304};
+  testKeyEncoding(key);
+  KeyPropColorVecTimeSlice_t key_t = {3,5,-7,0x01020304};
+  testKeyEncoding(key_t);
+
+  QDPIO::cout << "OK" << std::endl;
+}
+
+
 //**********************************************************************************************
 void testMapKeyPropColorVecInsertions(MapObjectDisk<KeyPropColorVec_t, LatticeFermion>& pc_map, 
 				      const multi1d<LatticeFermion>& lf_array)
@@ -306,6 +359,39 @@ void testMapKeyPropColorVecLookups(MapObjectDisk<KeyPropColorVec_t, LatticeFermi
 }
 
 
+void testMapKeyPropColorVecGetAll(MapObjectDisk<KeyPropColorVec_t, LatticeFermion>& pc_map,
+				  const multi1d<LatticeFermion>& lf_array)
+{
+  QDPIO::cout << "Collective getAll test:" << std::endl;
+
+  // All keys backwards, one twice, and one not in the map
+  std::vector<KeyPropColorVec_t> keys;
+  KeyPropColorVec_t the_key = {0,0,0};
+  for(int i=lf_array.size()-1; i >= 0; i--) {
+    the_key.colorvec_src = i;
+    keys.push_back(the_key);
+  }
+  keys.push_back(keys[2]);
+  the_key.colorvec_src = lf_array.size();
+  keys.push_back(the_key);
+
+  std::vector<LatticeFermion> vals;
+  int missing = pc_map.getAll(keys, vals);
+  if (missing != 1 || vals.size() != keys.size())
+    fail(__LINE__);
+
+  for(int j=0; j < int(keys.size()) - 1; j++) {
+    LatticeFermion diff;
+    diff = vals[j] - lf_array[keys[j].colorvec_src];
+    if( toBool( norm2(diff) != 0 ) ) {
+      QDPIO::cout << "key " << keys[j].colorvec_src << ": norm2(diff)=" << norm2(diff) << std::endl;
+      fail(__LINE__);
+    }
+  }
+  QDPIO::cout << "OK" << std::endl;
+}
+
+
 //**********************************************************************************************
 void testMapKeyPropColorVecInsertionsTimeSlice(MapObjectDisk<KeyPropColorVecTimeSlice_t, TimeSliceIO<LatticeFermion> >& pc_map, 
 					       const multi1d<LatticeFermion>& lf_array)
@@ -437,6 +523,75 @@ void testMapKeyPropColorVecLookupsTimeSlice(MapObjectDisk<KeyPropColorVecTimeSli
 
 
 
+void testInsertTimeSlices(MapObjectDisk<KeyPropColorVecTimeSlice_t, TimeSliceIO<LatticeFermion> >& pc_map, 
+			  const multi1d<LatticeFermion>& lf_array)
+{
+  QDPIO::cout << "Double buffered time slice insert test:" << std::endl;
+
+  // Some of the time slices, out of order
+  const int Lt = Layout::lattSize()[Nd-1];
+  std::vector<int> time_slices;
+  for(int t=Lt-1; t >= 0; t -= 2)
+    time_slices.push_back(t);
+  time_slices.push_back(0);
+
+  std::vector<KeyPropColorVecTimeSlice_t> keys;
+  KeyPropColorVecTimeSlice_t the_key = {0,0,0,0};
+  the_key.colorvec_src = lf_array.size() + 1;
+  for(int j=0; j < time_slices.size(); j++) {
+    the_key.t_slice = time_slices[j];
+    keys.push_back(the_key);
+  }
+
+  LatticeFermion f = lf_array[3];
+  if (insertTimeSlices(pc_map, keys, f, time_slices) != 0)
+    fail(__LINE__);
+
+  // Read back into a zero field: only the inserted slices are filled
+  LatticeFermion lf_tmp = zero;
+  LatticeFermion ref = zero;
+  for(int j=0; j < keys.size(); j++) {
+    TimeSliceIO<LatticeFermion> time_slice_lf(lf_tmp, time_slices[j]);
+    if (pc_map.get(keys[j], time_slice_lf) != 0)
+      fail(__LINE__);
+
+    ref = where(Layout::latticeCoordinate(Nd-1) == time_slices[j], f, ref);
+  }
+
+  LatticeFermion diff;
+  diff = lf_tmp - ref;
+  if( toBool( norm2(diff) != 0 ) ) {
+    QDPIO::cout << "norm2(diff)=" << norm2(diff) << std::endl;
+    fail(__LINE__);
+  }
+
+  // A write consumes its gather: writing again reads the lattice again
+  LatticeFermion g = lf_array[4];
+  TimeSliceIO<LatticeFermion> time_slice_g(g, 1);
+  LatticeTimeSliceIO::SliceGather gather;
+  time_slice_g.startGather(gather);
+  the_key.t_slice = 1;
+  if (pc_map.insert(the_key, time_slice_g) != 0)
+    fail(__LINE__);
+
+  g = lf_array[5];
+  if (pc_map.insert(the_key, time_slice_g) != 0)
+    fail(__LINE__);
+
+  lf_tmp = zero;
+  TimeSliceIO<LatticeFermion> time_slice_lf(lf_tmp, 1);
+  if (pc_map.get(the_key, time_slice_lf) != 0)
+    fail(__LINE__);
+
+  diff = lf_tmp - where(Layout::latticeCoordinate(Nd-1) == 1, g, LatticeFermion(zero));
+  if( toBool( norm2(diff) != 0 ) ) {
+    QDPIO::cout << "norm2(diff)=" << norm2(diff) << std::endl;
+    fail(__LINE__);
+  }
+  QDPIO::cout << "OK" << std::endl;
+}
+
+
 //**********************************************************************************************
 int main(int argc, char *argv[])
 {
@@ -451,6 +606,8 @@ int main(int argc, char *argv[])
   Layout::setLattSize(nrow);
   Layout::create();
 
+  testKeyEncodings();
+
   // For debugging
   {
     MapObjectNull<char,float> dumb;
@@ -518,6 +675,7 @@ int main(int argc, char *argv[])
     
     testMapKeyPropColorVecInsertions(pc_map, lf_array);
     testMapKeyPropColorVecLookups(pc_map, lf_array);
+    testMapKeyPropColorVecGetAll(pc_map, lf_array);
     QDPIO::cout << std::endl << "OK" << std::endl;
 
     // Test an update 
@@ -581,6 +739,7 @@ int main(int argc, char *argv[])
     int Lt = Layout::lattSize()[Nd-1];
     testMapKeyPropColorVecInsertionsTimeSlice(pc_map, lf_array);
     testMapKeyPropColorVecLookupsTimeSlice(pc_map, lf_array);
+    testInsertTimeSlices(pc_map, lf_array);
     QDPIO::cout << std::endl << "OK" << std::endl;
 
     // Test an update 
@@ -0,0 +1,129 @@
+/*! \file
+ *  \brief Test move construction and move assignment of lattices
+ *
+ *  Lattices moved from must stay usable: they are assigned to again,
+ *  copied from, and move assigned from lattices that do not own their
+ *  memory
+ */
+
+#include "examples.h"
+
+//! Print a difference and return whether it is zero
+bool same(const std::string& what, const LatticeFermion& a, const LatticeFermion& b)
+{
+  Double diff = norm2(a - b);
+  QDPIO::cout << what << ": " << diff << std::endl;
+  return toBool(diff == 0);
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#if __cplusplus >= 201103L
+  bool ok = true;
+
+  LatticeFermion psi, chi;
+  gaussian(psi);
+  gaussian(chi);
+
+  // Move then assign, copy and expression assign to the source
+  {
+    LatticeFermion a = psi;
+    LatticeFermion b(std::move(a));
+    ok = same("move construct", b, psi) && ok;
+
+    a = chi;
+    ok = same("assign to moved from", a, chi) && ok;
+
+    a = 2*psi + chi;
+    ok = same("expr to moved from", a, LatticeFermion(2*psi + chi)) && ok;
+
+    LatticeFermion c = std::move(b);
+    b = zero;
+    b[rb[1]] = psi;
+    LatticeFermion d = zero;
+    d[rb[1]] = psi;
+    ok = same("subset assign to moved from", b, d) && ok;
+
+    LatticeFermion e(b);
+    ok = same("copy of moved from", e, d) && ok;
+  }
+
+  // Move assignment, both ways
+  {
+    LatticeFermion a = psi, b = chi;
+    a = std::move(b);
+    ok = same("move assign", a, chi) && ok;
+
+    b = std::move(a);
+    ok = same("move assign back", b, chi) && ok;
+
+    a = psi;
+    ok = same("assign after move assign", a, psi) && ok;
+  }
+
+  // A lattice that does not own its memory, a view of another one
+  {
+    LatticeFermion store = psi;
+    LatticeFermion view(store.getF(), 1.0);
+
+    LatticeFermion a = chi;
+    LatticeFermion b(std::move(a));   // a moved from, then assigned by a view
+    a = std::move(view);
+    ok = same("move assign from view", a, psi) && ok;
+
+    view = chi;
+    ok = same("view still writes through", store, chi) && ok;
+
+    LatticeFermion c(std::move(view));
+    ok = same("move construct from view", c, chi) && ok;
+    ok = same("view keeps its memory", view, chi) && ok;
+
+    LatticeFermion f = psi;
+    view = std::move(f);
+    ok = same("move assign to view", store, psi) && ok;
+    ok = same("view source untouched", f, psi) && ok;
+  }
+
+  // A lattice filled on a subset, then moved and assigned on the other
+  {
+    LatticeFermion a = zero;
+    a[rb[0]] = psi;
+    LatticeFermion b = std::move(a);
+    a[rb[1]] = chi;
+    b[rb[1]] = chi;
+
+    LatticeFermion d;
+    d[rb[0]] = psi;
+    d[rb[1]] = chi;
+    ok = same("subset filled then moved", b, d) && ok;
+  }
+
+  // Swap
+  {
+    LatticeFermion a = psi, b = chi;
+    swap(a, b);
+    ok = same("swap", a, chi) && ok;
+    ok = same("swap back", b, psi) && ok;
+  }
+
+  QDPIO::cout << "t_move: " << (ok ? "PASSED" : "FAILED") << std::endl;
+#else
+  QDPIO::cout << "t_move: no move semantics before C++11" << std::endl;
+#endif
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
@@ -0,0 +1,225 @@
+/*! \file
+ *  \brief Test the counter based Philox lattice random numbers
+ *
+ *  Checks Philox-4x32-10 against the published known-answer vectors,
+ *  the lattice fills against the generator site by site, and that the
+ *  numbers do not change with the thread count, the subset the lattice
+ *  is filled under, or a save and restore of the counter
+ */
+
+#include "examples.h"
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+
+//! Philox-4x32-10 as written in Salmon et al, SC11
+void refPhilox(unsigned int c[4], const unsigned int k_in[2])
+{
+  unsigned int k[2] = {k_in[0], k_in[1]};
+
+  for(int r=0; r < 10; ++r)
+  {
+    if (r > 0)
+    {
+      k[0] += 0x9E3779B9u;
+      k[1] += 0xBB67AE85u;
+    }
+
+    RNG::RanWord p0 = RNG::RanWord(0xD2511F53u) * c[0];
+    RNG::RanWord p1 = RNG::RanWord(0xCD9E8D57u) * c[2];
+
+    unsigned int out[4];
+    out[0] = (unsigned int)(p1 >> 32) ^ c[1] ^ k[0];
+    out[1] = (unsigned int)(p1);
+    out[2] = (unsigned int)(p0 >> 32) ^ c[3] ^ k[1];
+    out[3] = (unsigned int)(p0);
+
+    for(int j=0; j < 4; ++j)
+      c[j] = out[j];
+  }
+}
+
+//! The known-answer vectors of the Random123 distribution
+bool checkKnownAnswers()
+{
+  const unsigned int kat[3][10] = {
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+     0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+     0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+
+  bool ok = true;
+  for(int v=0; v < 3; ++v)
+  {
+    unsigned int c[4] = {kat[v][0], kat[v][1], kat[v][2], kat[v][3]};
+    refPhilox(c, &kat[v][4]);
+
+    for(int j=0; j < 4; ++j)
+      ok = ok && (c[j] == kat[v][6+j]);
+  }
+
+  QDPIO::cout << "known answers: " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+//! Uniform j of the stream at (key, site, counter) from the reference
+float refUniform(RNG::RanWord key, RNG::RanWord site, RNG::RanWord counter, int j)
+{
+  unsigned int c[4] = {(unsigned int)(j / 4), (unsigned int)(site),
+		       (unsigned int)(counter), (unsigned int)(counter >> 32)};
+  unsigned int k[2] = {(unsigned int)(key), (unsigned int)(key >> 32)};
+  refPhilox(c, k);
+
+  return (float(c[j % 4] >> 9) + 0.5f) / 8388608.0f;
+}
+
+//! The library's uniforms against the reference
+bool checkUniforms()
+{
+  const RNG::RanWord keys[] = {0, 11, 0x123456789abcdefULL};
+  const RNG::RanWord counters[] = {0, 1, 0x100000000ULL + 7};
+  const int n = 10;   // more than two blocks
+
+  bool ok = true;
+  for(int kk=0; kk < 3; ++kk)
+    for(int cc=0; cc < 3; ++cc)
+      for(RNG::RanWord site=0; site < 300; site += 37)
+      {
+	float u[n];
+	RNG::fillCounterUniforms(u, n, keys[kk], site, counters[cc]);
+
+	for(int j=0; j < n; ++j)
+	  ok = ok && (u[j] == refUniform(keys[kk], site, counters[cc], j)) && (u[j] > 0) && (u[j] < 1);
+      }
+
+  QDPIO::cout << "uniforms: " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+//! A lattice fill against the reference at every site
+bool checkLattice(const Seed& seed)
+{
+  RNG::setrn(seed);
+  LatticeReal a;
+  random(a);
+
+  LatticeReal e;
+  const RNG::RanWord key = RNG::seedToWord(seed);
+  for(int i=0; i < Layout::sitesOnNode(); ++i)
+    e.elem(i).elem().elem().elem() = refUniform(key, RNG::globalSiteIndex(i), 0, 0);
+
+  Double diff = norm2(a - e);
+  QDPIO::cout << "lattice against reference: " << diff << std::endl;
+  return toBool(diff == 0);
+}
+
+//! Compare two fills, print and return whether they agree
+bool same(const std::string& what, const LatticeColorMatrix& a, const LatticeColorMatrix& b)
+{
+  Double diff = norm2(a - b);
+  QDPIO::cout << what << ": " << diff << std::endl;
+  return toBool(diff == 0);
+}
+
+#endif
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Select the generator before the layout, so the LCG tables are not built
+  RNG::setRNGType(RNG::RNG_PHILOX);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  bool ok = true;
+  Seed seed = 11;
+
+  ok = checkKnownAnswers() && ok;
+  ok = checkUniforms() && ok;
+  ok = checkLattice(seed) && ok;
+
+  LatticeColorMatrix ref_u, ref_g, u;
+
+  RNG::setrn(seed);
+  random(ref_u);
+  gaussian(ref_g);
+
+  // Thread count
+#if defined(QDP_USE_OMP_THREADS)
+  {
+    const int nth = omp_get_max_threads();
+    omp_set_num_threads(1);
+
+    RNG::setrn(seed);
+    random(u);
+    ok = same("random on 1 thread", u, ref_u) && ok;
+    gaussian(u);
+    ok = same("gaussian on 1 thread", u, ref_g) && ok;
+
+    omp_set_num_threads(nth);
+  }
+#else
+  QDPIO::cout << "no threads: thread count not tested" << std::endl;
+#endif
+
+  // Subsets: each checkerboard filled at the same point of the stream
+  {
+    for(int cb=0; cb < 2; ++cb)
+    {
+      RNG::setrn(seed);
+      random(u, rb[cb]);
+    }
+    ok = same("random by checkerboard", u, ref_u) && ok;
+
+    LatticeColorMatrix g, tmp;
+    for(int cb=0; cb < 2; ++cb)
+    {
+      RNG::setrn(seed);
+      random(tmp);          // to the counter ref_g was drawn at
+      gaussian(g, rb[cb]);
+    }
+    ok = same("gaussian by checkerboard", g, ref_g) && ok;
+
+    // Save and restore of key and counter
+    RNG::CounterSeed cs;
+    RNG::savern(cs);
+    random(u);
+    RNG::setrn(cs);
+    LatticeColorMatrix v;
+    random(v);
+    ok = same("restored counter", v, u) && ok;
+  }
+
+  // Different counters and seeds give different numbers
+  {
+    RNG::setrn(seed);
+    random(u);
+    random(u);
+    ok = !same("next fill (expect non-zero)", u, ref_u) && ok;
+
+    Seed seed2 = 13;
+    RNG::setrn(seed2);
+    random(u);
+    ok = !same("other seed (expect non-zero)", u, ref_u) && ok;
+  }
+
+  QDPIO::cout << "t_philox: " << (ok ? "PASSED" : "FAILED") << std::endl;
+#else
+  QDPIO::cout << "t_philox: the counter based generator is not in this architecture" << std::endl;
+#endif
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
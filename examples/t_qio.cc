@@ -376,6 +376,104 @@ int main(int argc, char **argv)
   }
 
 
+  //
+  // Precision round trips: records read into fields of the other
+  // precision, and written in the other precision
+  //
+  {
+    QDPIO::cout << "\n\n***************PRECISION tests*************\n" << std::endl;
+    test_file = "t_qio_prec.lime";
+
+    LatticeColorMatrixD a_d;
+    LatticeColorMatrixF a_f;
+    multi1d<LatticeColorMatrixD> c_d(Nd);
+    multi1d<LatticeColorMatrixF> c_f(Nd);
+
+    gaussian(a_d);
+    gaussian(a_f);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      gaussian(c_d[mu]);
+      gaussian(c_f[mu]);
+    }
+
+    {
+      XMLBufferWriter file_xml, record_xml;
+      push(file_xml, "file_prec");
+      pop(file_xml);
+      push(record_xml, "record_prec");
+      pop(record_xml);
+
+      QDPFileWriter to(file_xml,test_file,QDPIO_SINGLEFILE,serpar,QDPIO_OPEN);
+      write(to,record_xml,a_d);
+      write(to,record_xml,c_d);
+      write(to,record_xml,a_f);
+      write(to,record_xml,c_f);
+      to.write(record_xml,a_d,QDPIO_PREC_SINGLE);
+      to.write(record_xml,c_d,QDPIO_PREC_SINGLE);
+      to.write(record_xml,a_f,QDPIO_PREC_DOUBLE);
+      to.write(record_xml,c_f,QDPIO_PREC_DOUBLE);
+      close(to);
+    }
+
+    // The double records must read as the rounded values, the single
+    // ones exactly
+    LatticeColorMatrixF a_df;
+    LatticeColorMatrixD a_fd;
+    multi1d<LatticeColorMatrixF> c_df(Nd);
+    multi1d<LatticeColorMatrixD> c_fd(Nd);
+    a_df = a_d;
+    a_fd = a_f;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      c_df[mu] = c_d[mu];
+      c_fd[mu] = c_f[mu];
+    }
+
+    {
+      XMLReader file_xml, record_xml;
+      QDPFileReader from(file_xml,test_file,serpar);
+
+      bool ok = true;
+      for(int pass=0; pass < 2; ++pass)
+      {
+	const char* how = (pass == 0) ? "read as" : "written as";
+
+	LatticeColorMatrixF b_f;
+	read(from,record_xml,b_f);
+	Double diff = norm2(b_f - a_df);
+	QDPIO::cout << "double " << how << " single: " << diff << std::endl;
+	ok = toBool(diff == 0) && ok;
+
+	multi1d<LatticeColorMatrixF> e_f(Nd);
+	read(from,record_xml,e_f);
+	diff = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  diff += norm2(e_f[mu] - c_df[mu]);
+	QDPIO::cout << "double array " << how << " single: " << diff << std::endl;
+	ok = toBool(diff == 0) && ok;
+
+	LatticeColorMatrixD b_d;
+	read(from,record_xml,b_d);
+	diff = norm2(b_d - a_fd);
+	QDPIO::cout << "single " << how << " double: " << diff << std::endl;
+	ok = toBool(diff == 0) && ok;
+
+	multi1d<LatticeColorMatrixD> e_d(Nd);
+	read(from,record_xml,e_d);
+	diff = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  diff += norm2(e_d[mu] - c_fd[mu]);
+	QDPIO::cout << "single array " << how << " double: " << diff << std::endl;
+	ok = toBool(diff == 0) && ok;
+      }
+      close(from);
+
+      QDPIO::cout << "Precision round trip: " << (ok ? "PASSED" : "FAILED") << std::endl;
+      write(xml_out, "precision_ok", ok);
+    }
+  }
+
   pop(xml_out);   // t_qio
   xml_out.close();
 
@@ -49,7 +49,34 @@ int main(int argc, char *argv[])
     xml.close();
   }
 #endif
-  
+
+  // Shifts of expressions and shifts into the source itself
+  {
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeReal x = Layout::latticeCoordinate(mu);
+      LatticeReal ref = x + 1;
+      ref = where(ref >= Real(nrow[mu]), ref - Real(nrow[mu]), ref);
+
+      LatticeReal b = shift(x + x, FORWARD, mu);
+      Double d1 = norm2(b - 2*ref);
+
+      b = x;
+      b = shift(b, FORWARD, mu);
+      Double d2 = norm2(b - ref);
+
+      b = x;
+      b[rb[0]] = shift(b, FORWARD, mu);
+      Double d3 = norm2(b - ref, rb[0]) + norm2(b - x, rb[1]);
+
+      b = shift(shift(x, FORWARD, mu), BACKWARD, mu);
+      Double d4 = norm2(b - x);
+
+      QDPIO::cout << "mu = " << mu << "  expr: " << d1 << "  alias: " << d2
+		  << "  subset alias: " << d3 << "  fwd+bwd: " << d4 << std::endl;
+    }
+  }
+
   // Time to bolt
   QDP_finalize();
 
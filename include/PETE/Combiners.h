@@ -294,6 +294,17 @@ struct OrCombine
   PETE_EMPTY_CONSTRUCTORS(OrCombine)
 };
 
+template<class Op>
+struct Combine1<bool, Op, OrCombine>
+{
+  typedef bool Type_t;
+  inline static
+  Type_t combine(bool a, Op, OrCombine)
+  {
+    return a;
+  }
+};
+
 template<class Op>
 struct Combine2<bool, bool, Op, OrCombine>
 {
@@ -305,6 +316,17 @@ struct Combine2<bool, bool, Op, OrCombine>
   }
 };
 
+template<class Op>
+struct Combine3<bool, bool, bool, Op, OrCombine>
+{
+  typedef bool Type_t;
+  inline static
+  Type_t combine(bool a, bool b, bool c, Op, OrCombine)
+  {
+    return (a || b || c);
+  }
+};
+
 
 //-----------------------------------------------------------------------------
 //
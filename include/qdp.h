@@ -106,6 +106,7 @@ namespace QDP {
 #include "qdp_arrays.h"
 
 #include "qdp_params.h"
+#include "qdp_coord.h"
 #include "qdp_layout.h"
 #include "qdp_io.h"
 #include "qdp_stdio.h"
@@ -232,7 +233,20 @@ namespace ThreadReductions {
 #error "Unknown architecture ARCH"
 #endif
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+// Reduced storage types only exist for scalarsite layouts
+#include "qdp_half.h"
+#include "qdp_compressed_link.h"
+#include "qdp_cblattice.h"
+
+// Contiguous checkerboard streams for the generic BLAS kernels
+#if defined(QDP_USE_GENERIC_OPTS) && (QDP_USE_SSE != 1) && (QDP_USE_BAGEL_QDP != 1)
+#include "scalarsite_generic/qdp_scalarsite_generic_cblattice.h"
+#endif
+#endif
+
 #include "qdp_flopcount.h"
+#include "qdp_perfregion.h"
 #include "qdp_globalfuncs_subtype.h"
 
 #endif  // QDP_INCLUDE
@@ -0,0 +1,716 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Checkerboarded (half volume) lattice fields
+ *
+ * A field holding only the sites of one checkerboard of rb, stored
+ * contiguously in the order of the checkerboard site table. It reads
+ * as zero on the other checkerboard, so it mixes with full lattice
+ * fields in expressions, and a shift of it lands on the opposite
+ * checkerboard.
+ */
+
+#ifndef QDP_CBLATTICE_H
+#define QDP_CBLATTICE_H
+
+namespace QDP {
+
+/*! @defgroup cblattice Checkerboarded lattice fields
+ *
+ * Half volume fields for even/odd preconditioned solvers. E.g.
+ *
+ *   LatticeFermionCB psi(1), chi(0);
+ *   chi = shift(psi, FORWARD, mu);       // only the sites of rb[0]
+ *   Double n = norm2(chi);
+ *
+ * Expressions containing a checkerboarded field are full lattice
+ * expressions; assigning one to a checkerboarded field evaluates it
+ * on the sites of that field only.
+ *
+ * @{
+ */
+
+//! Outer grid lattice type living on one checkerboard of rb
+template<class T>
+class OCBLattice: public QDPType<T, OCBLattice<T> >
+{
+public:
+  //! Field on checkerboard 0
+  OCBLattice()
+    {
+      alloc_mem(0);
+    }
+
+  //! Field on checkerboard cb of rb
+  explicit OCBLattice(int cb_)
+    {
+      alloc_mem(cb_);
+    }
+
+  ~OCBLattice()
+    {
+      free_mem();
+    }
+
+  //! Copy constructor
+  /*! The copy lives on the checkerboard of rhs */
+  OCBLattice(const OCBLattice& rhs)
+    {
+      alloc_mem(rhs.cb);
+      copy(rhs);
+    }
+
+  //---------------------------------------------------------
+  // Operators
+  // NOTE: all assignment-like operators except operator= are
+  // inherited from QDPType
+
+  inline
+  OCBLattice& operator=(const typename WordType<T>::Type_t& rhs)
+    {
+      return this->assign(rhs);
+    }
+
+  inline
+  OCBLattice& operator=(const Zero& rhs)
+    {
+      return this->assign(rhs);
+    }
+
+  template<class T1,class C1>
+  inline
+  OCBLattice& operator=(const QDPType<T1,C1>& rhs)
+    {
+      return this->assign(rhs);
+    }
+
+  template<class T1,class C1>
+  inline
+  OCBLattice& operator=(const QDPExpr<T1,C1>& rhs)
+    {
+      return this->assign(rhs);
+    }
+
+  //! Assignment keeps the checkerboard of the destination
+  /*! A field on the other checkerboard is zero here, so gives zero */
+  inline
+  OCBLattice& operator=(const OCBLattice& rhs)
+    {
+      if (cb == rhs.cb)
+      {
+	copy(rhs);
+	return *this;
+      }
+
+      return this->assign(rhs);
+    }
+
+#if __cplusplus >= 201103L
+  //! Move constructor
+  /*!
+   * Takes over the buffer and checkerboard of rhs, leaving rhs a fresh
+   * buffer on the same checkerboard
+   */
+  OCBLattice(OCBLattice&& rhs)
+    {
+      alloc_mem(rhs.cb);
+      std::swap(F, rhs.F);
+    }
+
+  //! Move assignment
+  /*! Exchanges buffers with rhs when on the same checkerboard */
+  inline
+  OCBLattice& operator=(OCBLattice&& rhs)
+    {
+      if (cb == rhs.cb)
+      {
+	std::swap(F, rhs.F);
+	return *this;
+      }
+
+      return this->assign(rhs);
+    }
+#endif
+
+  //! Exchange contents, including the checkerboard, with rhs
+  void swap(OCBLattice& rhs)
+    {
+      std::swap(cb, rhs.cb);
+      std::swap(n, rhs.n);
+      std::swap(pos, rhs.pos);
+      std::swap(F, rhs.F);
+    }
+
+
+public:
+  //! The checkerboard of rb holding the sites
+  inline int checkerboard() const {return cb;}
+
+  //! The subset holding the sites
+  inline const Subset& subset() const {return rb[cb];}
+
+  //! Number of sites on this node
+  inline int numSites() const {return n;}
+
+  //! The backdoor
+  /*! The sites of the checkerboard in the order of its site table */
+  inline T* getF() const {return F;}
+
+  //! Value at a site of the node, zero off the checkerboard
+  inline const T& elem(int i) const {return F[pos[i]];}
+
+  //! Site j of the checkerboard, i.e. site subset().siteTable()[j] of the node
+  inline T& elemCB(int j) {return F[j];}
+  inline const T& elemCB(int j) const {return F[j];}
+
+
+private:
+  //! Internal memory allocator
+  /*!
+   * One more site than the checkerboard holds is kept zero, the
+   * position table points the sites of the other checkerboard at it
+   */
+  inline void alloc_mem(int cb_)
+    {
+      if (cb_ < 0 || cb_ >= rb.numSubsets())
+	QDP_error_exit("OCBLattice: illegal checkerboard %d", cb_);
+
+      cb  = cb_;
+      n   = rb[cb].numSiteTable();
+      pos = rb[cb].sitePositions().slice();
+
+      // Barfs if allocator fails
+      try
+      {
+	F=(T*)QDP::Allocator::theQDPAllocator::Instance().allocate(sizeof(T)*(n+1),QDP::Allocator::DEFAULT);
+      }
+      catch(std::bad_alloc)
+      {
+	QDPIO::cerr << "Allocation failed in OCBLattice alloc_mem" << std::endl;
+	QDP::Allocator::theQDPAllocator::Instance().dump();
+	QDP_abort(1);
+      }
+
+      zero_rep(F[n]);
+    }
+
+  //! Internal memory free
+  inline void free_mem()
+    {
+      if( F != 0x0 )
+	QDP::Allocator::theQDPAllocator::Instance().free(F);
+
+      F = 0x0;
+    }
+
+  //! Site by site copy from a field on the same checkerboard
+  inline void copy(const OCBLattice& rhs)
+    {
+      const T* s = rhs.F;
+#pragma omp parallel for
+      for(int j=0; j < n; ++j)
+	F[j] = s[j];
+    }
+
+
+private:
+  int cb;          // checkerboard of rb
+  int n;           // number of sites of the checkerboard on this node
+  const int *pos;  // site -> position in F, n off the checkerboard
+  T *F;
+};
+
+
+//! Exchange the contents of two checkerboarded lattices
+template<class T>
+inline void swap(OCBLattice<T>& a, OCBLattice<T>& b) {a.swap(b);}
+
+
+//-----------------------------------------------------------------------------
+// Traits
+//-----------------------------------------------------------------------------
+
+// Expressions with a checkerboarded field are full lattice expressions
+template<class T, class C>
+struct MakeReturn<T, OCBLattice<C> >
+{
+  typedef QDPExpr<T, OLattice<C> >  Expression_t;
+  inline static
+  Expression_t make(const T &a) { return Expression_t(a); }
+};
+
+template<class T>
+struct WordType<OCBLattice<T> >
+{
+  typedef typename WordType<T>::Type_t  Type_t;
+};
+
+template<class T>
+struct SinglePrecType<OCBLattice<T> >
+{
+  typedef OCBLattice<typename SinglePrecType<T>::Type_t> Type_t;
+};
+
+template<class T>
+struct DoublePrecType<OCBLattice<T> >
+{
+  typedef OCBLattice<typename DoublePrecType<T>::Type_t> Type_t;
+};
+
+template<class T>
+struct InternalScalar<OCBLattice<T> > {
+  typedef OScalar<typename InternalScalar<T>::Type_t>  Type_t;
+};
+
+template<class T>
+struct PrimitiveScalar<OCBLattice<T> > {
+  typedef OCBLattice<typename PrimitiveScalar<T>::Type_t>  Type_t;
+};
+
+template<class T>
+struct LatticeScalar<OCBLattice<T> > {
+  typedef OScalar<typename LatticeScalar<T>::Type_t>  Type_t;
+};
+
+template<class T>
+struct RealScalar<OCBLattice<T> > {
+  typedef OScalar<typename RealScalar<T>::Type_t>  Type_t;
+};
+
+
+// Return types are those of the same operation on an OLattice
+template<class T1, class Op>
+struct UnaryReturn<OCBLattice<T1>, Op> : public UnaryReturn<OLattice<T1>, Op> {};
+
+template<class T1>
+struct UnaryReturn<OCBLattice<T1>, OpNot> : public UnaryReturn<OLattice<T1>, OpNot> {};
+
+template<class T1, class C2, class Op>
+struct BinaryReturn<OCBLattice<T1>, C2, Op> : public BinaryReturn<OLattice<T1>, C2, Op> {};
+
+template<class C1, class T2, class Op>
+struct BinaryReturn<C1, OCBLattice<T2>, Op> : public BinaryReturn<C1, OLattice<T2>, Op> {};
+
+template<class T1, class T2, class Op>
+struct BinaryReturn<OCBLattice<T1>, OCBLattice<T2>, Op> : public BinaryReturn<OLattice<T1>, OLattice<T2>, Op> {};
+
+// PETE gives these operations their own defaults, so disambiguate
+#define QDP_CBLATTICE_BINARY_RETURN(Op)					\
+template<class T1, class C2>						\
+struct BinaryReturn<OCBLattice<T1>, C2, Op> : public BinaryReturn<OLattice<T1>, C2, Op> {}; \
+template<class C1, class T2>						\
+struct BinaryReturn<C1, OCBLattice<T2>, Op> : public BinaryReturn<C1, OLattice<T2>, Op> {}; \
+template<class T1, class T2>						\
+struct BinaryReturn<OCBLattice<T1>, OCBLattice<T2>, Op> : public BinaryReturn<OLattice<T1>, OLattice<T2>, Op> {};
+
+QDP_CBLATTICE_BINARY_RETURN(OpLT)
+QDP_CBLATTICE_BINARY_RETURN(OpLE)
+QDP_CBLATTICE_BINARY_RETURN(OpGT)
+QDP_CBLATTICE_BINARY_RETURN(OpGE)
+QDP_CBLATTICE_BINARY_RETURN(OpEQ)
+QDP_CBLATTICE_BINARY_RETURN(OpNE)
+QDP_CBLATTICE_BINARY_RETURN(OpAnd)
+QDP_CBLATTICE_BINARY_RETURN(OpOr)
+QDP_CBLATTICE_BINARY_RETURN(OpLeftShift)
+QDP_CBLATTICE_BINARY_RETURN(OpRightShift)
+QDP_CBLATTICE_BINARY_RETURN(OpAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpAddAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpSubtractAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpMultiplyAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpDivideAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpModAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpBitwiseOrAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpBitwiseAndAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpBitwiseXorAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpLeftShiftAssign)
+QDP_CBLATTICE_BINARY_RETURN(OpRightShiftAssign)
+
+#undef QDP_CBLATTICE_BINARY_RETURN
+
+// Every pattern of checkerboarded arguments of where()
+template<class T1, class C2, class C3, class Op>
+struct TrinaryReturn<OCBLattice<T1>, C2, C3, Op> : public TrinaryReturn<OLattice<T1>, C2, C3, Op> {};
+
+template<class C1, class T2, class C3, class Op>
+struct TrinaryReturn<C1, OCBLattice<T2>, C3, Op> : public TrinaryReturn<C1, OLattice<T2>, C3, Op> {};
+
+template<class C1, class C2, class T3, class Op>
+struct TrinaryReturn<C1, C2, OCBLattice<T3>, Op> : public TrinaryReturn<C1, C2, OLattice<T3>, Op> {};
+
+template<class T1, class T2, class C3, class Op>
+struct TrinaryReturn<OCBLattice<T1>, OCBLattice<T2>, C3, Op> : public TrinaryReturn<OLattice<T1>, OLattice<T2>, C3, Op> {};
+
+template<class T1, class C2, class T3, class Op>
+struct TrinaryReturn<OCBLattice<T1>, C2, OCBLattice<T3>, Op> : public TrinaryReturn<OLattice<T1>, C2, OLattice<T3>, Op> {};
+
+template<class C1, class T2, class T3, class Op>
+struct TrinaryReturn<C1, OCBLattice<T2>, OCBLattice<T3>, Op> : public TrinaryReturn<C1, OLattice<T2>, OLattice<T3>, Op> {};
+
+template<class T1, class T2, class T3, class Op>
+struct TrinaryReturn<OCBLattice<T1>, OCBLattice<T2>, OCBLattice<T3>, Op> : public TrinaryReturn<OLattice<T1>, OLattice<T2>, OLattice<T3>, Op> {};
+
+
+//! A checkerboarded field read through a shift
+template<class T>
+struct LeafFunctor<QDPType<T,OCBLattice<T> >, FnMapAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPType<T,OCBLattice<T> > &a, const FnMapAliasLeaf &f)
+    {return f.in_map && ((const void*)(static_cast<const OCBLattice<T>&>(a).getF()) == f.ptr);}
+};
+
+//! Print a checkerboarded field in a profiled expression
+template<class T>
+struct LeafFunctor<OCBLattice<T>, PrintTag>
+{
+  typedef int Type_t;
+  static int apply(const OCBLattice<T> &s, const PrintTag &f)
+    {
+      f.os_m << "OCBLat<";
+      LeafFunctor<T,PrintTag>::apply(s.elemCB(0),f);
+      f.os_m << ">";
+      return 0;
+    }
+};
+
+
+namespace CBLatticeInternal
+{
+  template<class T, class Op, class RHS>
+  struct EvalArgs
+  {
+    T* dest;
+    const Op& op;
+    const RHS& rhs;
+    const int* tab;
+
+    EvalArgs(T* d, const Op& o, const RHS& r, const int* t) :
+      dest(d), op(o), rhs(r), tab(t) {}
+  };
+
+  //! dest(j) op= rhs(tab[j])
+  template<class T, class Op, class RHS>
+  void evalKernel(int lo, int hi, int myId, EvalArgs<T,Op,RHS>* a)
+  {
+    T* dest = a->dest;
+    const int* tab = a->tab;
+    const Op& op = a->op;
+
+    for(int j=lo; j < hi; ++j)
+      op(dest[j], forEach(a->rhs, EvalLeaf1(tab[j]), OpCombine()));
+  }
+
+  //! dest(j) op= scalar
+  template<class T, class Op, class RHS>
+  void evalScalarKernel(int lo, int hi, int myId, EvalArgs<T,Op,RHS>* a)
+  {
+    T* dest = a->dest;
+    const Op& op = a->op;
+
+    for(int j=lo; j < hi; ++j)
+      op(dest[j], forEach(a->rhs, EvalLeaf1(0), OpCombine()));
+  }
+
+  //! Only all and the checkerboard of the field itself are allowed
+  inline
+  void checkSubset(const Subset& s, int cb)
+  {
+    if (&(s.getSet()) == &(all.getSet()))
+      return;
+
+    if (&(s.getSet()) == &rb && s.color() == cb)
+      return;
+
+    QDP_error_exit("OCBLattice: only all or the checkerboard of the field can be used as a subset");
+  }
+
+  //! Evaluate an expression on the sites of the checkerboard of dest
+  template<class T, class T1, class Op, class RHS>
+  void evaluateSites(OCBLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs)
+  {
+    typedef QDPExpr<RHS,OLattice<T1> > Expr_t;
+    EvalArgs<T,Op,Expr_t> a(dest.getF(), op, rhs, dest.subset().siteTable().slice());
+
+    dispatch_to_threads(dest.numSites(), a, evalKernel<T,Op,Expr_t>);
+  }
+
+
+  template<class R, class T1, class T2, class Op>
+  struct ReduceArgs
+  {
+    const T1* s1;
+    const T2* s2;
+    R* partial;   // one slot per thread
+  };
+
+  //! Thread partial of sum(op(s1))
+  template<class R, class T1, class T2, class Op>
+  void reduceUnaryKernel(int lo, int hi, int myId, ReduceArgs<R,T1,T2,Op>* a)
+  {
+    Op op;
+    R& d = a->partial[myId];
+
+    for(int j=lo; j < hi; ++j)
+      d.elem() += op(a->s1[j]);
+  }
+
+  //! Thread partial of sum(op(s1,s2))
+  template<class R, class T1, class T2, class Op>
+  void reduceBinaryKernel(int lo, int hi, int myId, ReduceArgs<R,T1,T2,Op>* a)
+  {
+    Op op;
+    R& d = a->partial[myId];
+
+    for(int j=lo; j < hi; ++j)
+      d.elem() += op(a->s1[j], a->s2[j]);
+  }
+
+  //! Sum over the sites of a checkerboard, thread partials reduced in a fixed order
+  template<class R, class T1, class T2, class Op>
+  R reduce(int n, const T1* s1, const T2* s2,
+	   void (*kernel)(int, int, int, ReduceArgs<R,T1,T2,Op>*))
+  {
+    const int nth = qdpNumThreads();
+
+    multi1d<R> partial(nth);
+    for(int i=0; i < nth; ++i)
+      zero_rep(partial[i].elem());
+
+    ReduceArgs<R,T1,T2,Op> arg;
+    arg.s1 = s1;
+    arg.s2 = s2;
+    arg.partial = &(partial[0]);
+
+    dispatch_to_threads(n, arg, kernel);
+
+    R d;
+    zero_rep(d.elem());
+    for(int i=0; i < nth; ++i)
+      d.elem() += partial[i].elem();
+
+    // Do a global sum on the result
+    QDPInternal::globalSum(d);
+
+    return d;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+//! OCBLattice Op Scalar(Expression(source))
+/*!
+ * The subset must be all or the checkerboard of the destination, the
+ * sites of the checkerboard are set
+ */
+template<class T, class T1, class Op, class RHS>
+void evaluate(OCBLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >& rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, dest.checkerboard());
+
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
+
+  typedef QDPExpr<RHS,OScalar<T1> > Expr_t;
+  CBLatticeInternal::EvalArgs<T,Op,Expr_t> a(dest.getF(), op, rhs, 0);
+
+  dispatch_to_threads(dest.numSites(), a, CBLatticeInternal::evalScalarKernel<T,Op,Expr_t>);
+
+  prof.stop(prof_timer, dest, op, rhs, dest.numSites());
+}
+
+
+//! OCBLattice Op OLattice(Expression(source))
+/*!
+ * The subset must be all or the checkerboard of the destination. The
+ * expression is evaluated on the sites of the checkerboard only, which
+ * are written contiguously.
+ */
+template<class T, class T1, class Op, class RHS>
+void evaluate(OCBLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, dest.checkerboard());
+
+  // A destination shifted twice on the right hand side reads its own
+  // checkerboard, so goes via a temporary
+  if (forEach(rhs, FnMapAliasLeaf(dest.getF()), OrCombine()))
+  {
+    // T1 is only the declared type, the temporary holds the evaluated sites
+    typedef typename DeReference<typename ForEach<RHS, EvalLeaf1, OpCombine>::Type_t>::Type_t Site_t;
+    OCBLattice<Site_t> tmp(dest.checkerboard());
+    evaluate(tmp, OpAssign(), rhs, s);
+    evaluate(dest, op, PETE_identity(tmp), s);
+    return;
+  }
+
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
+
+  CBLatticeInternal::evaluateSites(dest, op, rhs);
+
+  prof.stop(prof_timer, dest, op, rhs, dest.numSites());
+}
+
+
+//! dest = 0
+template<class T>
+void zero_rep(OCBLattice<T>& dest)
+{
+  T* F = dest.getF();
+  const int n = dest.numSites();
+
+#pragma omp parallel for
+  for(int j=0; j < n; ++j)
+    zero_rep(F[j]);
+}
+
+
+//! Gaussian fill of the sites of the checkerboard
+/*! Gives the same numbers as gaussian(d, d.subset()) on a full lattice field */
+template<class T>
+void gaussian(OCBLattice<T>& d)
+{
+  OLattice<T> tmp;
+  gaussian(tmp, d.subset());
+  d = tmp;
+}
+
+//! Random fill of the sites of the checkerboard
+/*! Gives the same numbers as random(d, d.subset()) on a full lattice field */
+template<class T>
+void random(OCBLattice<T>& d)
+{
+  OLattice<T> tmp;
+  random(tmp, d.subset());
+  d = tmp;
+}
+
+
+//-----------------------------------------------------------------------------
+// Global sums over the sites of the checkerboard
+
+//! OScalar = sum(OCBLattice)
+template<class T>
+inline typename UnaryReturn<OLattice<T>, FnSum>::Type_t
+sum(const OCBLattice<T>& s1)
+{
+  typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t  Ret_t;
+  return CBLatticeInternal::reduce<Ret_t,T,T,OpUnaryPlus>(s1.numSites(), s1.getF(), 0,
+					      CBLatticeInternal::reduceUnaryKernel<Ret_t,T,T,OpUnaryPlus>);
+}
+
+//! OScalar = norm2(OCBLattice)
+template<class T>
+inline typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t
+norm2(const OCBLattice<T>& s1)
+{
+  typedef typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t  Ret_t;
+  return CBLatticeInternal::reduce<Ret_t,T,T,FnLocalNorm2>(s1.numSites(), s1.getF(), 0,
+					      CBLatticeInternal::reduceUnaryKernel<Ret_t,T,T,FnLocalNorm2>);
+}
+
+//! OScalar = innerProduct(OCBLattice,OCBLattice)
+/*! Zero for fields on different checkerboards */
+template<class T1, class T2>
+inline typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t
+innerProduct(const OCBLattice<T1>& s1, const OCBLattice<T2>& s2)
+{
+  typedef typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t  Ret_t;
+  const int n = (s1.checkerboard() == s2.checkerboard()) ? s1.numSites() : 0;
+  return CBLatticeInternal::reduce<Ret_t,T1,T2,FnLocalInnerProduct>(n, s1.getF(), s2.getF(),
+					      CBLatticeInternal::reduceBinaryKernel<Ret_t,T1,T2,FnLocalInnerProduct>);
+}
+
+//! OScalar = innerProductReal(OCBLattice,OCBLattice)
+/*! Zero for fields on different checkerboards */
+template<class T1, class T2>
+inline typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t
+innerProductReal(const OCBLattice<T1>& s1, const OCBLattice<T2>& s2)
+{
+  typedef typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t  Ret_t;
+  const int n = (s1.checkerboard() == s2.checkerboard()) ? s1.numSites() : 0;
+  return CBLatticeInternal::reduce<Ret_t,T1,T2,FnLocalInnerProductReal>(n, s1.getF(), s2.getF(),
+					      CBLatticeInternal::reduceBinaryKernel<Ret_t,T1,T2,FnLocalInnerProductReal>);
+}
+
+
+//-----------------------------------------------------------------------------
+// Input and output
+// The file format is that of the full lattice field, zero on the
+// other checkerboard, so the files can be read by either type.
+
+//! Binary output
+template<class T>
+void write(BinaryWriter& bin, const OCBLattice<T>& d)
+{
+  OLattice<T> tmp;
+  tmp = d;
+  write(bin, tmp);
+}
+
+//! Binary input
+/*! Only the checkerboard of d is kept */
+template<class T>
+void read(BinaryReader& bin, OCBLattice<T>& d)
+{
+  OLattice<T> tmp;
+  read(bin, tmp);
+  d = tmp;
+}
+
+#ifdef QDP_USE_LIBXML2
+//! Writes an OCBLattice object
+/*!
+  \param qsw The writer
+  \param rec_xml The user record metadata.
+  \param s1 The data
+*/
+template<class T>
+void write(QDPFileWriter& qsw, XMLBufferWriter& rec_xml, const OCBLattice<T>& s1)
+{
+  OLattice<T> tmp;
+  tmp = s1;
+  qsw.write(rec_xml, tmp);
+}
+
+//! Reads an OCBLattice object
+/*!
+  Only the checkerboard of s1 is kept
+
+  \param qsw The reader
+  \param rec_xml The user record metadata.
+  \param s1 The data
+*/
+template<class T>
+void read(QDPFileReader& qsw, XMLReader& rec_xml, OCBLattice<T>& s1)
+{
+  OLattice<T> tmp;
+  qsw.read(rec_xml, tmp);
+  s1 = tmp;
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Checkerboarded versions of the common fields
+typedef OCBLattice< PScalar< PScalar< RScalar<REAL> > > >                      LatticeRealCB;
+typedef OCBLattice< PScalar< PScalar< RComplex<REAL> > > >                     LatticeComplexCB;
+typedef OCBLattice< PScalar< PColorVector< RComplex<REAL>, Nc> > >             LatticeColorVectorCB;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL>, Nc>, 1> >       LatticeStaggeredFermionCB;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL>, Nc>, Ns> >      LatticeFermionCB;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL>, Nc>, (Ns>>1) > > LatticeHalfFermionCB;
+
+typedef OCBLattice< PScalar< PColorVector< RComplex<REAL32>, Nc> > >           LatticeColorVectorCBF;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL32>, Nc>, Ns> >    LatticeFermionCBF;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL32>, Nc>, (Ns>>1) > > LatticeHalfFermionCBF;
+
+typedef OCBLattice< PScalar< PColorVector< RComplex<REAL64>, Nc> > >           LatticeColorVectorCBD;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL64>, Nc>, Ns> >    LatticeFermionCBD;
+typedef OCBLattice< PSpinVector< PColorVector< RComplex<REAL64>, Nc>, (Ns>>1) > > LatticeHalfFermionCBD;
+
+/*! @} */   // end of group cblattice
+
+} // namespace QDP
+
+#endif
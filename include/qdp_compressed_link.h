@@ -0,0 +1,361 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Compressed SU(3) link storage
+ *
+ * Gauge links stored as two rows (12 reals) or as 8 parameters, with
+ * the full matrix rebuilt in registers when it is multiplied
+ */
+
+#ifndef QDP_COMPRESSED_LINK_H
+#define QDP_COMPRESSED_LINK_H
+
+#include <cmath>
+
+namespace QDP {
+
+/*! @defgroup compressedlink Compressed gauge links
+ *
+ * In memory compression of SU(3) gauge fields. The matrices must be
+ * special unitary; nothing is checked when compressing
+ *
+ * @{
+ */
+
+//! SU(3) matrix stored as its first two rows
+/*! The third row is rebuilt as the conjugated cross product of the
+ *  first two */
+template<class T> class PColorMatrixR12
+{
+public:
+  //! Keep the first two rows
+  template<class T1>
+  inline
+  void compress(const PColorMatrix<RComplex<T1>,3>& u)
+    {
+      for(int i=0; i < 2; ++i)
+	for(int j=0; j < 3; ++j)
+	  F[i][j] = u.elem(i,j);
+    }
+
+  //! Rebuild the full matrix
+  inline
+  void reconstruct(PColorMatrix<RComplex<T>,3>& u) const
+    {
+      for(int i=0; i < 2; ++i)
+	for(int j=0; j < 3; ++j)
+	  u.elem(i,j) = F[i][j];
+
+      for(int k=0; k < 3; ++k)
+      {
+	int i = (k+1) % 3;
+	int j = (k+2) % 3;
+	const RComplex<T>& a0 = F[0][i];
+	const RComplex<T>& a1 = F[0][j];
+	const RComplex<T>& b0 = F[1][i];
+	const RComplex<T>& b1 = F[1][j];
+
+	// conj(a0*b1 - a1*b0)
+	u.elem(2,k).real() =  (a0.real()*b1.real() - a0.imag()*b1.imag())
+	                    - (a1.real()*b0.real() - a1.imag()*b0.imag());
+	u.elem(2,k).imag() = -(a0.real()*b1.imag() + a0.imag()*b1.real())
+	                    + (a1.real()*b0.imag() + a1.imag()*b0.real());
+      }
+    }
+
+private:
+  RComplex<T> F[2][3];
+};
+
+
+//! SU(3) matrix stored as 8 real parameters
+/*! Keeps a01, a02, a10 and the phases of a00 and a20. The remaining
+ *  elements follow from unitarity of the rows and columns. This becomes
+ *  ill conditioned as |a00| approaches 1 */
+template<class T> class PColorMatrixR8
+{
+public:
+  //! Extract the 8 parameters
+  template<class T1>
+  inline
+  void compress(const PColorMatrix<RComplex<T1>,3>& u)
+    {
+      F[0] = u.elem(0,1).real();
+      F[1] = u.elem(0,1).imag();
+      F[2] = u.elem(0,2).real();
+      F[3] = u.elem(0,2).imag();
+      F[4] = u.elem(1,0).real();
+      F[5] = u.elem(1,0).imag();
+      F[6] = atan2(u.elem(0,0).imag(), u.elem(0,0).real());
+      F[7] = atan2(u.elem(2,0).imag(), u.elem(2,0).real());
+    }
+
+  //! Rebuild the full matrix
+  inline
+  void reconstruct(PColorMatrix<RComplex<T>,3>& u) const
+    {
+      RComplex<T>& a0 = u.elem(0,0);
+      RComplex<T>& a1 = u.elem(0,1);
+      RComplex<T>& a2 = u.elem(0,2);
+      RComplex<T>& b0 = u.elem(1,0);
+      RComplex<T>& c0 = u.elem(2,0);
+
+      a1.real() = F[0];  a1.imag() = F[1];
+      a2.real() = F[2];  a2.imag() = F[3];
+      b0.real() = F[4];  b0.imag() = F[5];
+
+      // Row 0 and column 0 have unit norm
+      T row_sum = F[0]*F[0] + F[1]*F[1] + F[2]*F[2] + F[3]*F[3];
+      T a0_abs  = sqrt(fabs(T(1) - row_sum));
+      a0.real() = a0_abs * cos(F[6]);
+      a0.imag() = a0_abs * sin(F[6]);
+
+      T col_sum = a0_abs*a0_abs + F[4]*F[4] + F[5]*F[5];
+      T c0_abs  = sqrt(fabs(T(1) - col_sum));
+      c0.real() = c0_abs * cos(F[7]);
+      c0.imag() = c0_abs * sin(F[7]);
+
+      T r_inv = T(1) / row_sum;
+
+      // conj(a0) * b0 and conj(a0) * c0
+      T ab_re = a0.real()*b0.real() + a0.imag()*b0.imag();
+      T ab_im = a0.real()*b0.imag() - a0.imag()*b0.real();
+      T ac_re = a0.real()*c0.real() + a0.imag()*c0.imag();
+      T ac_im = a0.real()*c0.imag() - a0.imag()*c0.real();
+
+      // b1 = -(conj(c0) conj(a2) + conj(a0) b0 a1) / row_sum
+      u.elem(1,1).real() = -r_inv * ((c0.real()*a2.real() - c0.imag()*a2.imag())
+				     + (ab_re*a1.real() - ab_im*a1.imag()));
+      u.elem(1,1).imag() = -r_inv * (-(c0.real()*a2.imag() + c0.imag()*a2.real())
+				     + (ab_re*a1.imag() + ab_im*a1.real()));
+
+      // b2 = (conj(c0) conj(a1) - conj(a0) b0 a2) / row_sum
+      u.elem(1,2).real() = r_inv * ((c0.real()*a1.real() - c0.imag()*a1.imag())
+				    - (ab_re*a2.real() - ab_im*a2.imag()));
+      u.elem(1,2).imag() = r_inv * (-(c0.real()*a1.imag() + c0.imag()*a1.real())
+				    - (ab_re*a2.imag() + ab_im*a2.real()));
+
+      // c1 = (conj(b0) conj(a2) - conj(a0) c0 a1) / row_sum
+      u.elem(2,1).real() = r_inv * ((b0.real()*a2.real() - b0.imag()*a2.imag())
+				    - (ac_re*a1.real() - ac_im*a1.imag()));
+      u.elem(2,1).imag() = r_inv * (-(b0.real()*a2.imag() + b0.imag()*a2.real())
+				    - (ac_re*a1.imag() + ac_im*a1.real()));
+
+      // c2 = -(conj(b0) conj(a1) + conj(a0) c0 a2) / row_sum
+      u.elem(2,2).real() = -r_inv * ((b0.real()*a1.real() - b0.imag()*a1.imag())
+				     + (ac_re*a2.real() - ac_im*a2.imag()));
+      u.elem(2,2).imag() = -r_inv * (-(b0.real()*a1.imag() + b0.imag()*a1.real())
+				     + (ac_re*a2.imag() + ac_im*a2.real()));
+    }
+
+private:
+  T F[8];
+};
+
+
+// Underlying word type
+template<class T>
+struct WordType<PColorMatrixR12<T> >
+{
+  typedef T  Type_t;
+};
+
+template<class T>
+struct WordType<PColorMatrixR8<T> >
+{
+  typedef T  Type_t;
+};
+
+
+// Lattice compressed links
+typedef OLattice< PColorMatrixR12<REAL> >    LatticeColorMatrixR12;
+typedef OLattice< PColorMatrixR8<REAL> >     LatticeColorMatrixR8;
+typedef OLattice< PColorMatrixR12<REAL32> >  LatticeColorMatrixR12F;
+typedef OLattice< PColorMatrixR8<REAL32> >   LatticeColorMatrixR8F;
+typedef OLattice< PColorMatrixR12<REAL64> >  LatticeColorMatrixR12D;
+typedef OLattice< PColorMatrixR8<REAL64> >   LatticeColorMatrixR8D;
+
+
+namespace CompressedLinkInternal
+{
+  template<class L, class T1, class T2>
+  struct LinkArgs
+  {
+    const L* u;
+    L* c;             // compression target
+    const T1* s;
+    T2* d;
+    const int* tab;   // NULL for a contiguous range of sites
+  };
+
+  //! d = u * s with u rebuilt on the fly
+  template<class L, class T1, class T2>
+  void multKernel(int lo, int hi, int myId, LinkArgs<L,T1,T2>* a)
+  {
+    typedef typename WordType<L>::Type_t  W;
+    PScalar< PColorMatrix<RComplex<W>,3> > u;
+
+    for(int j=lo; j < hi; ++j)
+    {
+      int i = (a->tab == 0) ? j : a->tab[j];
+      a->u[i].reconstruct(u.elem());
+      a->d[i] = u * a->s[i];
+    }
+  }
+
+  //! Compress full links
+  template<class L, class T1, class T2>
+  void compressKernel(int lo, int hi, int myId, LinkArgs<L,T1,T2>* a)
+  {
+    for(int j=lo; j < hi; ++j)
+    {
+      int i = (a->tab == 0) ? j : a->tab[j];
+      a->c[i].compress(a->s[i].elem());
+    }
+  }
+
+  //! Rebuild full links
+  template<class L, class T1, class T2>
+  void decompressKernel(int lo, int hi, int myId, LinkArgs<L,T1,T2>* a)
+  {
+    for(int j=lo; j < hi; ++j)
+    {
+      int i = (a->tab == 0) ? j : a->tab[j];
+      a->u[i].reconstruct(a->d[i].elem());
+    }
+  }
+
+  //! Run a kernel over the sites of a subset
+  template<class L, class T1, class T2>
+  void dispatch(LinkArgs<L,T1,T2>& arg, const Subset& s,
+		void (*func)(int,int,int,LinkArgs<L,T1,T2>*))
+  {
+    if (s.hasOrderedRep())
+    {
+      // Shift the base pointers so the kernel can index from s.start()
+      int start = s.start();
+      if (arg.u) arg.u += start;
+      if (arg.c) arg.c += start;
+      if (arg.s) arg.s += start;
+      if (arg.d) arg.d += start;
+      arg.tab = 0;
+      dispatch_to_threads(s.end() - start + 1, arg, func);
+    }
+    else
+    {
+      arg.tab = s.siteTable().slice();
+      dispatch_to_threads(s.numSiteTable(), arg, func);
+    }
+  }
+}
+
+
+//! Compress a color matrix field on a subset
+template<class L, class T>
+void compress(OLattice<L>& d, const OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& u,
+	      const Subset& s)
+{
+  typedef PScalar< PColorMatrix<RComplex<T>,3> >  M;
+  CompressedLinkInternal::LinkArgs<L,M,M> arg;
+  arg.u = 0;
+  arg.c = &(d.elem(0));
+  arg.s = &(u.elem(0));
+  arg.d = 0;
+  CompressedLinkInternal::dispatch(arg, s, CompressedLinkInternal::compressKernel<L,M,M>);
+}
+
+//! Compress a color matrix field
+template<class L, class T>
+void compress(OLattice<L>& d, const OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& u)
+{
+  compress(d, u, all);
+}
+
+//! Rebuild a full color matrix field on a subset
+template<class L, class T>
+void decompress(OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& d, const OLattice<L>& u,
+		const Subset& s)
+{
+  typedef PScalar< PColorMatrix<RComplex<T>,3> >  M;
+  CompressedLinkInternal::LinkArgs<L,M,M> arg;
+  arg.u = &(u.elem(0));
+  arg.c = 0;
+  arg.s = 0;
+  arg.d = &(d.elem(0));
+  CompressedLinkInternal::dispatch(arg, s, CompressedLinkInternal::decompressKernel<L,M,M>);
+}
+
+//! Rebuild a full color matrix field
+template<class L, class T>
+void decompress(OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& d, const OLattice<L>& u)
+{
+  decompress(d, u, all);
+}
+
+
+//! d = u * s on a subset, with u a compressed link field
+/*!
+ * s may be a fermion, half fermion or color matrix field of the same
+ * precision as u
+ */
+template<class L, class T>
+void multiply(OLattice<T>& d, const OLattice<L>& u, const OLattice<T>& s, const Subset& sub)
+{
+  CompressedLinkInternal::LinkArgs<L,T,T> arg;
+  arg.u = &(u.elem(0));
+  arg.c = 0;
+  arg.s = &(s.elem(0));
+  arg.d = &(d.elem(0));
+  CompressedLinkInternal::dispatch(arg, sub, CompressedLinkInternal::multKernel<L,T,T>);
+}
+
+
+//! 12 real link times fermion or half fermion
+template<class T, int N>
+inline OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> >
+operator*(const OLattice< PColorMatrixR12<T> >& u,
+	  const OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> >& s)
+{
+  OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> > d;
+  multiply(d, u, s, all);
+  return d;
+}
+
+//! 8 real link times fermion or half fermion
+template<class T, int N>
+inline OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> >
+operator*(const OLattice< PColorMatrixR8<T> >& u,
+	  const OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> >& s)
+{
+  OLattice< PSpinVector< PColorVector<RComplex<T>,3>, N> > d;
+  multiply(d, u, s, all);
+  return d;
+}
+
+//! 12 real link times color matrix
+template<class T>
+inline OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >
+operator*(const OLattice< PColorMatrixR12<T> >& u,
+	  const OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& s)
+{
+  OLattice< PScalar< PColorMatrix<RComplex<T>,3> > > d;
+  multiply(d, u, s, all);
+  return d;
+}
+
+//! 8 real link times color matrix
+template<class T>
+inline OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >
+operator*(const OLattice< PColorMatrixR8<T> >& u,
+	  const OLattice< PScalar< PColorMatrix<RComplex<T>,3> > >& s)
+{
+  OLattice< PScalar< PColorMatrix<RComplex<T>,3> > > d;
+  multiply(d, u, s, all);
+  return d;
+}
+
+/*! @} */   // end of group compressedlink
+
+} // namespace QDP
+
+#endif
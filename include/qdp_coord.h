@@ -0,0 +1,167 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Fixed size lattice coordinates
+ *
+ * A coordinate type that lives on the stack, and the lexicographic
+ * index helpers on it. Used by the allocation free layout functions.
+ */
+
+#ifndef QDP_COORD_H
+#define QDP_COORD_H
+
+namespace QDP {
+
+/*! @addtogroup layout
+ *
+ * @{
+ */
+
+//! Lattice coordinate of fixed length
+template<int N>
+class Coord
+{
+public:
+  Coord() {}
+
+  //! Copy in the first N elements of a multi1d
+  explicit Coord(const multi1d<int>& s)
+    {
+      for(int i=0; i < N; ++i)
+	c[i] = s[i];
+    }
+
+  int& operator[](int i) {return c[i];}
+  const int& operator[](int i) const {return c[i];}
+
+  //! Number of dimensions
+  int size() const {return N;}
+
+  //! Raw pointer to the elements
+  const int* slice() const {return c;}
+
+  //! Copy out to a multi1d
+  multi1d<int> toMulti1d() const
+    {
+      multi1d<int> d(N);
+      for(int i=0; i < N; ++i)
+	d[i] = c[i];
+      return d;
+    }
+
+private:
+  int c[N];
+};
+
+
+#if QDP_USE_CB3D_LAYOUT == 1
+
+//! Decompose a lexicographic site into coordinates, the last direction fastest
+template<int N>
+inline void crtesn(Coord<N>& coord, int ipos, const Coord<N>& latt_size)
+{
+  for(int i=N-1; i < 2*N-1; ++i)
+  {
+    int ix = i % N;
+
+    coord[ix] = ipos % latt_size[ix];
+    ipos = ipos / latt_size[ix];
+  }
+}
+
+//! Lexicographic site index of a coordinate, the last direction fastest
+template<int N>
+inline int local_site(const Coord<N>& coord, const Coord<N>& latt_size)
+{
+  int order = 0;
+
+  for(int mmu=N-2; mmu >= 0; --mmu)
+  {
+    int wrapmu = (mmu + N - 1) % N;
+    order = latt_size[wrapmu]*(coord[mmu] + order);
+  }
+
+  order += coord[N-1];
+
+  return order;
+}
+
+#else
+
+//! Decompose a lexicographic site into coordinates, x fastest
+template<int N>
+inline void crtesn(Coord<N>& coord, int ipos, const Coord<N>& latt_size)
+{
+  for(int i=0; i < N; ++i)
+  {
+    coord[i] = ipos % latt_size[i];
+    ipos = ipos / latt_size[i];
+  }
+}
+
+//! Lexicographic site index of a coordinate, x fastest
+template<int N>
+inline int local_site(const Coord<N>& coord, const Coord<N>& latt_size)
+{
+  int order = 0;
+
+  for(int mmu=N-1; mmu >= 1; --mmu)
+    order = latt_size[mmu-1]*(coord[mmu] + order);
+
+  order += coord[0];
+
+  return order;
+}
+
+#endif
+
+
+//! Decompose a site index of a blocked lattice into coordinates
+/*!
+ * The lattice is cut into blocks of size block. The blocks are ordered
+ * lexicographically, and so are the sites within each block.
+ */
+template<int N>
+inline void block_crtesn(Coord<N>& coord, int ipos, 
+			 const Coord<N>& latt_size, const Coord<N>& block)
+{
+  Coord<N> nblock;
+  int block_vol = 1;
+  for(int i=0; i < N; ++i)
+  {
+    nblock[i] = latt_size[i] / block[i];
+    block_vol *= block[i];
+  }
+
+  Coord<N> bc;
+  crtesn(bc, ipos / block_vol, nblock);
+  crtesn(coord, ipos % block_vol, block);
+
+  for(int i=0; i < N; ++i)
+    coord[i] += bc[i] * block[i];
+}
+
+//! Site index of a coordinate on a blocked lattice
+/*! This is the inverse of block_crtesn */
+template<int N>
+inline int block_site(const Coord<N>& coord, 
+		      const Coord<N>& latt_size, const Coord<N>& block)
+{
+  Coord<N> nblock, bc, bs;
+  int block_vol = 1;
+  for(int i=0; i < N; ++i)
+  {
+    nblock[i] = latt_size[i] / block[i];
+    bc[i] = coord[i] / block[i];
+    bs[i] = coord[i] % block[i];
+    block_vol *= block[i];
+  }
+
+  return local_site(bc, nblock)*block_vol + local_site(bs, block);
+}
+
+/*! @} */   // end of group layout
+
+} // namespace QDP
+
+#endif
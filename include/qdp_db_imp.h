@@ -28,11 +28,21 @@ namespace QDP
    */
   const int db_pagesize = 64*1024;
 
+  /**
+   * Size in bytes of the blocks broadcast by getAll
+   */
+  const size_t db_getall_blocksize = 64*1024*1024;
+
   //--------------------------------------------------------------------------------
   //!  DB Base class
   /*!
     This class is used for writing of user data (most usefully measurements)
     into a DB file with a key/value semantics. 
+
+    Only the primary node touches the file. By default every insert
+    broadcasts its status so that all nodes stop on an error. In deferred
+    mode the inserts take no collective; failures are counted on the
+    primary node and reported by the next flush() or close().
   */
   template<typename K, typename D>
   class BinaryStoreDB
@@ -41,7 +51,7 @@ namespace QDP
     /**
      * Empty constructor for a DB
      */
-    BinaryStoreDB ()
+    BinaryStoreDB () : deferred(false), deferred_errors(0)
     {
       // Initialize default values
       if (Layout::primaryNode())
@@ -217,6 +227,8 @@ namespace QDP
 
     virtual void close (void)
     {
+      checkDeferred(__func__);
+
       int ret = 0;
       if (Layout::primaryNode()) 
 	ret = db.close();
@@ -260,6 +272,13 @@ namespace QDP
       if (Layout::primaryNode()) 
 	ret = db.insert(key, data);
 
+      if (deferred)
+      {
+	if (ret != 0)
+	  ++deferred_errors;
+	return;
+      }
+
       QDPInternal::broadcast(ret);
       if (ret != 0)
       {
@@ -282,6 +301,13 @@ namespace QDP
       if (Layout::primaryNode()) 
 	ret = db.insertBinary(key, data);
 
+      if (deferred)
+      {
+	if (ret != 0)
+	  ++deferred_errors;
+	return;
+      }
+
       QDPInternal::broadcast(ret);
       if (ret != 0)
       {
@@ -291,6 +317,57 @@ namespace QDP
     }
 
 
+    /**
+     * Insert many pairs of keys and data into the database
+     *
+     * The status of all the inserts is checked with one broadcast, or
+     * none in deferred mode.
+     * @param recs pairs of keys and user data
+     */
+    void insertBatch (const std::vector< std::pair<K,D> >& recs)
+    {
+      int nerr = 0;
+      if (Layout::primaryNode()) 
+      {
+	for(typename std::vector< std::pair<K,D> >::const_iterator r = recs.begin(); r != recs.end(); ++r)
+	  if (db.insert(r->first, r->second) != 0)
+	    ++nerr;
+      }
+
+      if (deferred)
+      {
+	deferred_errors += nerr;
+	return;
+      }
+
+      QDPInternal::broadcast(nerr);
+      if (nerr != 0)
+      {
+	QDPIO::cerr << __func__ << ": " << nerr << " errors inserting into db" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    /**
+     * Defer the status of inserts to the next flush or close
+     *
+     * All nodes must make the same choice. Switching the mode off reports
+     * any errors collected so far.
+     * @param on true to stop checking every insert
+     */
+    void setDeferredStatus (bool on)
+    {
+      checkDeferred(__func__);
+      deferred = on;
+    }
+
+    bool getDeferredStatus (void) const
+    {
+      return deferred;
+    }
+
+
     /**
      * Get data for a given key
      * @param key user supplied key
@@ -329,6 +406,97 @@ namespace QDP
       return ret;
     }
 
+
+    /**
+     * Get data for a given key on all nodes
+     *
+     * The value is read on the primary node and broadcast in binary
+     * form. This is a collective call.
+     * @param key user supplied key
+     * @param data after the call data will be populated on all nodes
+     * @return 0 on success, otherwise the key not found
+     */
+    int getBroadcast (const K& key, D& data)
+    {
+      int ret = 0;
+      std::string bin;
+      if (Layout::primaryNode())
+      {
+	std::string bkey;
+	key.writeObject(bkey);
+	ret = db.getBinary(bkey, bin);
+      }
+
+      QDPInternal::broadcast(ret);
+      if (ret != 0)
+	return ret;
+
+      QDPInternal::broadcast_str(bin);
+      data.readObject(bin);
+      return ret;
+    }
+
+
+    /**
+     * Get data for many keys on all nodes
+     *
+     * The keys must be the same on all nodes. Values are read on the
+     * primary node and broadcast in large blocks, the read of one block
+     * overlapping the broadcast of the previous one. This is a
+     * collective call.
+     * @param keys_ user supplied keys
+     * @param values_ after the call holds the data in the order of the
+     * keys; entries for keys not found are default constructed
+     * @return the number of keys not found
+     */
+    int getAll (const std::vector<K>& keys_, std::vector<D>& values_)
+    {
+      values_.clear();
+      values_.resize(keys_.size());
+
+      GetAllSource src(db, keys_, values_);
+      broadcastBlocks(src);
+
+      return src.missing;
+    }
+
+
+    /**
+     * Return all available keys on all nodes
+     *
+     * This is a collective call.
+     * @param keys user suppled an empty vector which is populated
+     * by keys after this call.
+     */
+    void keysBroadcast (std::vector<K>& keys_)
+    {
+      std::string bin;
+      if (Layout::primaryNode())
+      {
+	std::vector<K> ks;
+	db.keys(ks);
+
+	std::string bkey;
+	for(typename std::vector<K>::const_iterator k = ks.begin(); k != ks.end(); ++k)
+	{
+	  k->writeObject(bkey);
+	  appendRecord(bin, 0, bkey);
+	}
+      }
+
+      QDPInternal::broadcast_str(bin);
+
+      size_t pos = 0;
+      int status;
+      std::string bkey;
+      while (nextRecord(bin, pos, status, bkey))
+      {
+	keys_.push_back(K());
+	keys_.back().readObject(bkey);
+      }
+    }
+
+
     /**
      * Return all available keys to user
      * @param keys user suppled an empty vector which is populated
@@ -379,6 +547,8 @@ namespace QDP
     {
       if (Layout::primaryNode()) 
 	db.flush();
+
+      checkDeferred(__func__);
     }
 
     /**
@@ -450,7 +620,98 @@ namespace QDP
       QDP_error_exit("FILEDB read routines do not work (yet) in parallel - only single node");
     }
 
+    //! Append a record (status, length, bytes) to a buffer
+    static void appendRecord(std::string& buf, int status, const std::string& bytes)
+    {
+      size_t len = bytes.size();
+      buf.append((const char*)&status, sizeof(int));
+      buf.append((const char*)&len, sizeof(size_t));
+      buf.append(bytes);
+    }
+
+    //! Unpack the record at pos. Returns false at the end of the buffer
+    static bool nextRecord(const std::string& buf, size_t& pos, int& status, std::string& bytes)
+    {
+      if (pos >= buf.size())
+	return false;
+
+      size_t len;
+      buf.copy((char*)&status, sizeof(int), pos);
+      buf.copy((char*)&len, sizeof(size_t), pos + sizeof(int));
+      pos += sizeof(int) + sizeof(size_t);
+      bytes.assign(buf, pos, len);
+      pos += len;
+      return true;
+    }
+
+    //! Reads blocks of values for getAll on the primary node and unpacks them on all nodes
+    class GetAllSource : public BinaryBlockSource
+    {
+    public:
+      //! Keys are serialized here, on all nodes, as that may communicate
+      GetAllSource(FILEDB::ConfDataStoreDB<K,D>& db_, const std::vector<K>& keys_, std::vector<D>& values_) :
+	db(db_), bkeys(keys_.size()), values(values_), nread(0), nused(0), missing(0)
+      {
+	for(size_t i=0; i < keys_.size(); ++i)
+	  keys_[i].writeObject(bkeys[i]);
+      }
+
+      bool readBlock(std::string& buf)
+      {
+	buf.clear();
+	std::string bin;
+	while (nread < bkeys.size() && buf.size() < db_getall_blocksize)
+	{
+	  bin.clear();
+	  int ret = db.getBinary(bkeys[nread++], bin);
+	  appendRecord(buf, ret, bin);
+	}
+	return ! buf.empty();
+      }
+
+      void useBlock(const std::string& buf)
+      {
+	size_t pos = 0;
+	int ret;
+	std::string bin;
+	while (nextRecord(buf, pos, ret, bin))
+	{
+	  if (ret == 0)
+	    values[nused].readObject(bin);
+	  else
+	    ++missing;
+	  ++nused;
+	}
+      }
+
+      FILEDB::ConfDataStoreDB<K,D>& db;
+      std::vector<std::string> bkeys;   // serialized keys
+      std::vector<D>& values;
+      size_t nread;     // keys read on the primary node
+      size_t nused;     // values filled in
+      int    missing;   // keys not found
+    };
+
+    //! Report the inserts that failed since the last check, with one broadcast
+    void checkDeferred(const char* func)
+    {
+      if (! deferred)
+	return;
+
+      int nerr = deferred_errors;
+      deferred_errors = 0;
+
+      QDPInternal::broadcast(nerr);
+      if (nerr != 0)
+      {
+	QDPIO::cerr << func << ": " << nerr << " deferred errors inserting into db" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
     FILEDB::ConfDataStoreDB<K,D> db;
+    bool deferred;         // insert status reported at flush/close
+    int  deferred_errors;  // failed inserts not yet reported
   };
 
 
@@ -277,6 +277,20 @@ o     *
      */
     void insertBinary (const std::string& key, const std::string& data) {notImplemented();}
 
+    /**
+     * Insert many pairs of keys and data into the database
+     * @param recs pairs of keys and user data
+     */
+    void insertBatch (const std::vector< std::pair<K,D> >& recs) {notImplemented();}
+
+    /**
+     * Defer the status of inserts to the next flush or close
+     * @param on true to stop checking every insert
+     */
+    void setDeferredStatus (bool on) {notImplemented();}
+
+    bool getDeferredStatus (void) const {notImplemented();}
+
     /**
      * Get data for a given key
      * @param key user supplied key
@@ -294,6 +308,29 @@ o     *
      */
     int getBinary (std::string& key, std::string& data) {notImplemented();}
 
+    /**
+     * Get data for a given key on all nodes
+     * @param key user supplied key
+     * @param data after the call data will be populated on all nodes
+     * @return 0 on success, otherwise the key not found
+     */
+    int getBroadcast (const K& key, D& data) {notImplemented();}
+
+    /**
+     * Get data for many keys on all nodes
+     * @param keys_ user supplied keys
+     * @param values_ after the call holds the data in the order of the keys
+     * @return the number of keys not found
+     */
+    int getAll (const std::vector<K>& keys_, std::vector<D>& values_) {notImplemented();}
+
+    /**
+     * Return all available keys on all nodes
+     * @param keys user suppled an empty vector which is populated
+     * by keys after this call.
+     */
+    void keysBroadcast (std::vector<K>& keys_) {notImplemented();}
+
     /**
      * Return all available keys to user
      * @param keys user suppled an empty vector which is populated
@@ -19,6 +19,15 @@ namespace QDP
   namespace Allocator
   {
 
+    //! Memory held by the allocator on this node
+    struct MemoryStats
+    {
+      size_t current_bytes;   // bytes allocated now
+      size_t peak_bytes;      // most bytes allocated at any time
+      size_t live_objects;    // allocations not yet freed
+      size_t total_allocs;    // allocations made
+    };
+
     // Specialise allocator to the default case
     class QDPDefaultAllocator {
     private:
@@ -38,10 +47,11 @@ namespace QDP
       friend class QDP::CreateUsingNew<QDP::Allocator::QDPDefaultAllocator>;
     public:
 
-      // Pusher
+      //! Tag the following allocations with a caller
+      /*! func must outlive the allocator, as __func__ and literals do */
       void pushFunc(const char* func, int line);
   
-      // Popper
+      //! Return to the previous caller tag
       void popFunc();
   
       //! Allocator function. Allocates n_bytes, into a memory pool
@@ -54,10 +64,18 @@ namespace QDP
       void 
       free(void *mem);
 
-      //! Dump the map
+      //! Print the use of memory, and each allocation with QDP_DEBUG_MEMORY
       void
       dump();
 
+      //! Current and peak use of memory
+      MemoryStats
+      getStats() const;
+
+      //! Print the use of memory by allocation size and by caller
+      void
+      printStats();
+
     protected:
       void init();
     };
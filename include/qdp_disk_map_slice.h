@@ -25,16 +25,23 @@ namespace QDP
     int current_time;
     int start_lexico;
     int stop_lexico;
+    mutable LatticeTimeSliceIO::SliceGather* gathered;
 
   public:
 
-    TimeSliceIO(T& lattice, int time_slice);
+    TimeSliceIO(T& lattice, int time_slice, int num_slices = 1);
     ~TimeSliceIO() {}
 
-    void setTimeSlice(int time_slice);
+    //! Use num_slices consecutive time slices starting at time_slice
+    void setTimeSlice(int time_slice, int num_slices = 1);
     int getTimeSlice() const {return current_time;}
     T&   getObject() const {return data;}
 
+    //! Start gathering the slices. The next write uses the gathered sites
+    /*! The gather must live until the write, which consumes it: later 
+     *  writes read the lattice again */
+    void startGather(LatticeTimeSliceIO::SliceGather& gather);
+
     void binaryRead(BinaryReader& bin);
     void binaryWrite(BinaryWriter& bin) const;
 
@@ -42,18 +49,19 @@ namespace QDP
 
 
   template <typename T>
-  TimeSliceIO<T>::TimeSliceIO(T& lattice, int time_slice) : data(lattice)
+  TimeSliceIO<T>::TimeSliceIO(T& lattice, int time_slice, int num_slices) : data(lattice), gathered(0)
   {
-    setTimeSlice(time_slice);
+    setTimeSlice(time_slice, num_slices);
   }
 
   template <typename T>
-  void TimeSliceIO<T>::setTimeSlice(int time_slice)
+  void TimeSliceIO<T>::setTimeSlice(int time_slice, int num_slices)
   {
     current_time = time_slice;
+    gathered = 0;
     int tDir = Nd-1;
 
-    if ((current_time < 0) || (current_time >= Layout::lattSize()[tDir]))
+    if ((current_time < 0) || (num_slices < 1) || (current_time+num_slices > Layout::lattSize()[tDir]))
     {
       throw(std::string("Invalid time in Lattice TimeSliceIO"));
     }
@@ -62,15 +70,22 @@ namespace QDP
     coord = 0;
     coord[tDir] = current_time;
     start_lexico = QDP::local_site(coord,Layout::lattSize());
-    if (current_time == Layout::lattSize()[tDir]-1) 
+    if (current_time+num_slices == Layout::lattSize()[tDir]) 
       stop_lexico = Layout::vol();
     else
     {
-      coord[tDir]++; 
+      coord[tDir] += num_slices; 
       stop_lexico = QDP::local_site(coord,Layout::lattSize());
     }
   }
 
+  template <typename T>
+  void TimeSliceIO<T>::startGather(LatticeTimeSliceIO::SliceGather& gather)
+  {
+    LatticeTimeSliceIO::startGather(gather,data,start_lexico,stop_lexico);
+    gathered = &gather;
+  }
+
   template <typename T>
   void TimeSliceIO<T>::binaryRead(BinaryReader& bin)
   {
@@ -80,7 +95,62 @@ namespace QDP
   template <typename T>
   void TimeSliceIO<T>::binaryWrite(BinaryWriter& bin) const
   {
-    LatticeTimeSliceIO::writeSlice(bin,data,start_lexico,stop_lexico);
+    if (gathered)
+    {
+      gathered->wait();
+      gathered->write(bin);
+      gathered = 0;
+    }
+    else
+      LatticeTimeSliceIO::writeSlice(bin,data,start_lexico,stop_lexico);
+  }
+
+
+  //! Write time slices of a lattice object as separate records of a map
+  /*!
+   * The map holds TimeSliceIO<T> values, e.g. a MapObjectDisk. 
+   * The slices are double buffered: the gather of the next slice to the 
+   * primary node runs while the current one is written.
+   *
+   * \return the number of failed inserts
+   */
+  template <typename M, typename K, typename T>
+  int insertTimeSlices(M& map, const std::vector<K>& keys, T& lattice, 
+		       const std::vector<int>& time_slices)
+  {
+    if (keys.size() != time_slices.size())
+    {
+      QDPIO::cerr << __func__ << ": number of keys and time slices differ" << std::endl;
+      QDP_abort(1);
+    }
+
+    if (keys.empty())
+      return 0;
+
+    LatticeTimeSliceIO::SliceGather gather[2];
+    TimeSliceIO<T> slice_a(lattice, time_slices[0]);
+    TimeSliceIO<T> slice_b(lattice, time_slices[0]);
+    TimeSliceIO<T>* slice[2] = {&slice_a, &slice_b};
+
+    slice[0]->startGather(gather[0]);
+
+    int ret = 0;
+    for(int i=0; i < keys.size(); ++i)
+    {
+      int cur = i % 2;
+      int next = 1 - cur;
+
+      if (i+1 < keys.size())
+      {
+	slice[next]->setTimeSlice(time_slices[i+1]);
+	slice[next]->startGather(gather[next]);
+      }
+
+      if (map.insert(keys[i], *slice[cur]) != 0)
+	++ret;
+    }
+
+    return ret;
   }
 
 
@@ -94,4 +94,46 @@ void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)
 #endif
 #endif
 
+
+namespace QDP {
+
+//! Argument for running an ordered kernel over the runs of a subset
+template<class Arg>
+struct run_user_arg
+{
+  const SiteRun* runs;
+  int nruns;
+  Arg* a;
+  void (*func)(int,int,int,Arg*);
+};
+
+//! Calls the ordered kernel on each contiguous piece of this thread's sites
+template<class Arg>
+void run_evaluate_function(int lo, int hi, int myId, run_user_arg<Arg>* r)
+{
+  SiteRunRange range(r->runs, r->nruns, lo, hi);
+  int first, last;
+
+  while (range.next(first, last))
+    r->func(first, last, myId, r->a);
+}
+
+//! Dispatch an ordered kernel over the contiguous runs of a subset
+/*!
+ * The sites are split among the threads as by dispatch_to_threads.
+ * func is called with ranges [lo,hi) of linear sites, so any
+ * pointers held in a must be based at site 0. It may be called more
+ * than once per thread, so reductions must accumulate. Requires
+ * s.hasRunRep().
+ */
+template<class Arg>
+void dispatch_to_runs(const Subset& s, Arg a, void (*func)(int,int,int,Arg*))
+{
+  run_user_arg<Arg> r = {s.siteRuns().slice(), s.numSiteRuns(), &a, func};
+
+  dispatch_to_threads(s.numSiteTable(), r, run_evaluate_function<Arg>);
+}
+
+}
+
 #endif
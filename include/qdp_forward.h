@@ -70,6 +70,9 @@ namespace QDP
   template<class T> class OScalar;
   template<class T> class OLattice;
 
+  // Outer lattice on one checkerboard
+  template<class T> class OCBLattice;
+
   // Outer types narrowed to a subset
   template<class T> class OSubScalar;
   template<class T> class OSubLattice;
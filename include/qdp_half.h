@@ -0,0 +1,263 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Half precision (REAL16) storage support
+ *
+ * Bulk word conversions between REAL16 and REAL32/REAL64, precision
+ * conversion of whole lattice fields and norms of REAL16 fields.
+ * REAL16 fields are storage only: convert to single precision to
+ * operate on them.
+ */
+
+#ifndef QDP_HALF_H
+#define QDP_HALF_H
+
+namespace QDP {
+
+/*! @defgroup half Half precision storage
+ *
+ * Conversion between 16 bit storage fields and their single or double
+ * precision equivalents, typically used to switch precision inside a
+ * defect correction loop
+ *
+ * @{
+ */
+
+//! Convert n words from single to half precision (round to nearest even)
+void convertWords(REAL16* d, const REAL32* s, int n);
+
+//! Convert n words from double to half precision (round to nearest even)
+void convertWords(REAL16* d, const REAL64* s, int n);
+
+//! Convert n words from half to single precision (exact)
+void convertWords(REAL32* d, const REAL16* s, int n);
+
+//! Convert n words from half to double precision (exact)
+void convertWords(REAL64* d, const REAL16* s, int n);
+
+//! Local sum of squares of n half precision words, accumulated in double
+double localSumSq(const REAL16* s, int n);
+
+
+namespace HalfPrecInternal
+{
+  template<class W1, class W2>
+  struct ConvertArgs
+  {
+    W1* d;
+    const W2* s;
+    const int* tab;   // NULL for a contiguous range of sites
+    int nw;           // words per site
+  };
+
+  template<class W1, class W2>
+  void convertKernel(int lo, int hi, int myId, ConvertArgs<W1,W2>* a)
+  {
+    const int nw = a->nw;
+
+    if (a->tab == 0)
+    {
+      convertWords(a->d + lo*nw, a->s + lo*nw, (hi-lo)*nw);
+    }
+    else
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	int i = a->tab[j];
+	convertWords(a->d + i*nw, a->s + i*nw, nw);
+      }
+    }
+  }
+
+  struct SumSqArgs
+  {
+    const REAL16* s;
+    const int* tab;   // NULL for a contiguous range of sites
+    int nw;           // words per site
+    double* partial;  // one slot per thread
+  };
+
+  inline
+  void sumSqKernel(int lo, int hi, int myId, SumSqArgs* a)
+  {
+    const int nw = a->nw;
+    double sum = 0;
+
+    if (a->tab == 0)
+    {
+      sum = localSumSq(a->s + lo*nw, (hi-lo)*nw);
+    }
+    else
+    {
+      for(int j=lo; j < hi; ++j)
+	sum += localSumSq(a->s + a->tab[j]*nw, nw);
+    }
+
+    a->partial[myId] = sum;
+  }
+
+  //! Global sum of squares of a REAL16 field over a subset
+  template<class T>
+  Double norm2(const OLattice<T>& s1, const Subset& s)
+  {
+    const int nw = sizeof(T) / sizeof(REAL16);
+    const int nth = qdpNumThreads();
+
+    multi1d<double> partial(nth);
+    partial = 0;
+
+    SumSqArgs arg;
+    arg.nw = nw;
+    arg.partial = &(partial[0]);
+
+    if (s.hasOrderedRep())
+    {
+      arg.s   = (const REAL16*)&(s1.elem(s.start()));
+      arg.tab = 0;
+      dispatch_to_threads(s.end() - s.start() + 1, arg, sumSqKernel);
+    }
+    else
+    {
+      arg.s   = (const REAL16*)&(s1.elem(0));
+      arg.tab = s.siteTable().slice();
+      dispatch_to_threads(s.numSiteTable(), arg, sumSqKernel);
+    }
+
+    // Reduce the thread partials in a fixed order
+    double lsum = 0;
+    for(int i=0; i < nth; ++i)
+      lsum += partial[i];
+
+    Double gsum(lsum);
+    QDPInternal::globalSum(gsum);
+    return gsum;
+  }
+}
+
+
+//! Convert a lattice field between half and single/double precision on a subset
+/*!
+ * One of the two word types must be REAL16 and the fields must have the
+ * same shape. E.g.
+ *
+ *   LatticeFermionH psi_h;
+ *   convertPrecision(psi_h, psi_f, rb[1]);
+ */
+template<class T1, class T2>
+void convertPrecision(OLattice<T1>& d, const OLattice<T2>& s1, const Subset& s)
+{
+  typedef typename WordType<T1>::Type_t  W1;
+  typedef typename WordType<T2>::Type_t  W2;
+
+  const int nw = sizeof(T1) / sizeof(W1);
+  if (nw * sizeof(W2) != sizeof(T2))
+    QDP_error_exit("convertPrecision: fields differ in shape");
+
+  HalfPrecInternal::ConvertArgs<W1,W2> arg;
+  arg.nw = nw;
+
+  if (s.hasOrderedRep())
+  {
+    arg.d   = (W1*)&(d.elem(s.start()));
+    arg.s   = (const W2*)&(s1.elem(s.start()));
+    arg.tab = 0;
+    dispatch_to_threads(s.end() - s.start() + 1, arg, HalfPrecInternal::convertKernel<W1,W2>);
+  }
+  else
+  {
+    arg.d   = (W1*)&(d.elem(0));
+    arg.s   = (const W2*)&(s1.elem(0));
+    arg.tab = s.siteTable().slice();
+    dispatch_to_threads(s.numSiteTable(), arg, HalfPrecInternal::convertKernel<W1,W2>);
+  }
+}
+
+//! Convert a lattice field between half and single/double precision
+template<class T1, class T2>
+void convertPrecision(OLattice<T1>& d, const OLattice<T2>& s1)
+{
+  convertPrecision(d, s1, all);
+}
+
+
+//! Norm2 of a half precision spin-color vector field over a subset
+template<int N, int M>
+inline Double
+norm2(const OLattice< PSpinVector< PColorVector< RComplex<REAL16>, N>, M> >& s1, const Subset& s)
+{
+  return HalfPrecInternal::norm2(s1, s);
+}
+
+//! Norm2 of a half precision spin-color vector field
+template<int N, int M>
+inline Double
+norm2(const OLattice< PSpinVector< PColorVector< RComplex<REAL16>, N>, M> >& s1)
+{
+  return HalfPrecInternal::norm2(s1, all);
+}
+
+//! Norm2 of a half precision color matrix field over a subset
+template<int N>
+inline Double
+norm2(const OLattice< PScalar< PColorMatrix< RComplex<REAL16>, N> > >& s1, const Subset& s)
+{
+  return HalfPrecInternal::norm2(s1, s);
+}
+
+//! Norm2 of a half precision color matrix field
+template<int N>
+inline Double
+norm2(const OLattice< PScalar< PColorMatrix< RComplex<REAL16>, N> > >& s1)
+{
+  return HalfPrecInternal::norm2(s1, all);
+}
+
+//! Norm2 of a half precision color vector field over a subset
+template<int N>
+inline Double
+norm2(const OLattice< PScalar< PColorVector< RComplex<REAL16>, N> > >& s1, const Subset& s)
+{
+  return HalfPrecInternal::norm2(s1, s);
+}
+
+//! Norm2 of a half precision color vector field
+template<int N>
+inline Double
+norm2(const OLattice< PScalar< PColorVector< RComplex<REAL16>, N> > >& s1)
+{
+  return HalfPrecInternal::norm2(s1, all);
+}
+
+//! Norm2 of a half precision complex field over a subset
+inline Double
+norm2(const LatticeComplexH& s1, const Subset& s)
+{
+  return HalfPrecInternal::norm2(s1, s);
+}
+
+//! Norm2 of a half precision complex field
+inline Double
+norm2(const LatticeComplexH& s1)
+{
+  return HalfPrecInternal::norm2(s1, all);
+}
+
+//! Norm2 of a half precision real field over a subset
+inline Double
+norm2(const LatticeRealH& s1, const Subset& s)
+{
+  return HalfPrecInternal::norm2(s1, s);
+}
+
+//! Norm2 of a half precision real field
+inline Double
+norm2(const LatticeRealH& s1)
+{
+  return HalfPrecInternal::norm2(s1, all);
+}
+
+/*! @} */   // end of group half
+
+} // namespace QDP
+
+#endif
@@ -938,6 +938,103 @@ namespace QDP
   };
 
 
+  //--------------------------------------------------------------------------------
+  //!  Binary buffer input class local to each node
+  /*!
+    This class reads data from a binary buffer that every node already
+    holds, e.g. after a broadcast. Every node reads its own copy and
+    there is no communication, so the status, checksum and position
+    are local too. The data is big-endian as for BinaryBufferReader.
+  */
+  class BinaryLocalBufferReader : public BinaryReader
+  {
+  public:
+    BinaryLocalBufferReader();
+
+    //! Construct from a string
+    explicit BinaryLocalBufferReader(const std::string& s);
+
+    //! Closes the buffer
+    ~BinaryLocalBufferReader();
+
+    //! Construct from a string
+    void open(const std::string& s);
+
+    //! Clear the buffer
+    void clear();
+
+    //! Read data on this node
+    void readArrayPrimaryNode(char* output, size_t nbytes, size_t nmemb);
+
+    //! Read data on this node
+    void readArray(char* output, size_t nbytes, size_t nmemb);
+
+    //! Read little-endian data on this node
+    void readArrayLittleEndian(char* output, size_t nbytes, size_t nmemb);
+
+    void readArrayPrimaryNodeLittleEndian(char* output, size_t nbytes, size_t nmemb);
+
+    using BinaryReader::read;
+
+    void readDesc(std::string& result);
+    void read(std::string& result, size_t nbytes);
+
+    bool fail();
+    QDPUtil::n_uint32_t getChecksum();
+    pos_type currentPosition();
+    void seek(pos_type off);
+    void seekBegin(off_type off);
+    void seekRelative(off_type off);
+    void seekEnd(off_type off);
+    void rewind();
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+
+    //! Get the internal input stream
+    std::istream& getIstream() {return f;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::istringstream f;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Blocks of bytes read on the primary node and used on all nodes
+  /*!
+    Used with broadcastBlocks() to distribute large reads: the primary
+    node reads the next block while the current one is broadcast.
+  */
+  class BinaryBlockSource
+  {
+  public:
+    virtual ~BinaryBlockSource() {}
+
+    //! Fill buf with the next block
+    /*!
+      Called on the primary node only, on a helper thread while the
+      calling thread uses the previous block. It must only read: no
+      communication and no lattice allocation.
+      \return false if there is nothing left to read
+    */
+    virtual bool readBlock(std::string& buf) = 0;
+
+    //! Use a block. Called in order on all nodes by the master thread
+    virtual void useBlock(const std::string& buf) = 0;
+  };
+
+  //! Read blocks on the primary node and broadcast them to all nodes
+  /*!
+    The read of block i+1 on a helper thread of the primary node
+    overlaps the broadcast and use of block i on the calling thread.
+    This is a collective call.
+  */
+  void broadcastBlocks(BinaryBlockSource& src);
+
+
   //--------------------------------------------------------------------------------
   //!  Binary file input class
   /*!
@@ -1485,6 +1582,216 @@ namespace QDP
   };
 
 
+  //--------------------------------------------------------------------------------
+  //!  Binary output base class local to each node
+  /*!
+    Every node writes its own object. There is no communication, so the
+    status, checksum and position are local too. The data is written
+    big-endian as for BinaryWriter.
+  */
+  class BinaryLocalWriter : public BinaryWriter
+  {
+  public:
+    //! Write data on this node
+    void writeArrayPrimaryNode(const char* output, size_t nbytes, size_t nmemb);
+
+    //! Write data on this node
+    void writeArray(const char* output, size_t nbytes, size_t nmemb);
+
+    bool fail();
+    QDPUtil::n_uint32_t getChecksum();
+    pos_type currentPosition();
+    void seek(pos_type off);
+    void seekBegin(off_type off);
+    void seekRelative(off_type off);
+    void seekEnd(off_type off);
+    void rewind();
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary buffer output class local to each node
+  class BinaryLocalBufferWriter : public BinaryLocalWriter
+  {
+  public:
+    BinaryLocalBufferWriter();
+
+    //! Construct from a string
+    explicit BinaryLocalBufferWriter(const std::string& s);
+
+    //! Closes the buffer
+    ~BinaryLocalBufferWriter();
+
+    //! Construct from a string
+    void open(const std::string& s);
+
+    //! Return entire buffer of this node as a string
+    std::string str() const;
+        
+    //! Clear the buffer
+    void clear();
+
+    //! Flush the buffer
+    void flush() {}
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+  
+    //! Get the internal output stream
+    std::ostream& getOstream() {return f;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::ostringstream f;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary file output class local to each node
+  class BinaryLocalFileWriter : public BinaryLocalWriter
+  {
+  public:
+    BinaryLocalFileWriter();
+
+    /*!
+      Closes the last file opened
+    */
+    ~BinaryLocalFileWriter();
+
+    /*!
+      Opens a file for writing on this node.
+      \param p The name of the file
+    */
+    explicit BinaryLocalFileWriter(const std::string& p);
+
+    //! Queries whether the file is open
+    bool is_open();
+    
+    /*!
+      Opens a file for writing on this node.
+      \param p The name of the file
+    */
+    void open(const std::string& p);
+
+    //! Closes the last file opened   
+    void close();
+
+    //! Flushes the buffer
+    void flush();
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+  
+    //! Get the internal output stream
+    std::ostream& getOstream() {return f;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::ofstream f;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Output buffer kept in fixed-size chunks
+  /*!
+    The chunks are handed on with release() without a copy, so the
+    buffer never holds more than the data and one partly filled chunk.
+  */
+  class BinaryChunkBuffer : public std::streambuf
+  {
+  public:
+    typedef std::vector< std::vector<char> > Chunks_t;
+
+    explicit BinaryChunkBuffer(size_t chunk_size_ = 16*1024*1024) : chunk_size(chunk_size_) {}
+
+    //! Move the data into out and start again empty
+    void release(Chunks_t& out);
+
+  protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char* s, std::streamsize n);
+
+  private:
+    //! Trim the last chunk to the data written into it
+    void trim();
+
+    size_t   chunk_size;
+    Chunks_t chunks;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary file output class writing in the background
+  /*!
+    The data is collected in memory on the primary node as for
+    BinaryFileWriter. When the file is closed, a background thread writes
+    it to disk while the computation goes on. The primary node holds the
+    whole file in memory until the write is done.
+
+    Only one file is written in the background at a time. Opening or
+    closing another one first waits for the last, as does waitCheckpoint().
+  */
+  class BinaryAsyncFileWriter : public BinaryWriter
+  {
+  public:
+    explicit BinaryAsyncFileWriter();
+
+    /*!
+      Closes the last file opened
+    */
+    ~BinaryAsyncFileWriter();
+
+    /*!
+      Opens a file for writing.
+      \param p The name of the file
+    */
+    explicit BinaryAsyncFileWriter(const std::string& p);
+
+    //! Queries whether the file is open
+    /*!
+      \return true if the file is open; false otherwise.
+    */
+    bool is_open();
+    
+    /*!
+      Opens a file for writing.
+      \param p The name of the file
+    */
+    void open(const std::string& p);
+
+    //! Start writing the file in the background
+    void close();
+
+    //! Nothing to flush until the close
+    void flush() {}
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+  
+    //! Get the internal output stream
+    std::ostream& getOstream() {return out;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::ofstream f;
+    BinaryChunkBuffer buf;
+    std::ostream out;
+  };
+
+
+  //! Wait for the background write of the last BinaryAsyncFileWriter
+  /*!
+    Aborts if the write failed. This is a collective call.
+  */
+  void waitCheckpoint();
+
+
   //--------------------------------------------------------------------------------
   //!  Binary input/output base class
   /*!
@@ -208,6 +208,21 @@ void readArchiv(multi1d<LatticeColorMatrix>& u, const std::string& cfg_file);
 void writeArchiv(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, const std::string& file);
 
 
+//! Writes a NERSC Gauge Connection Archive gauge configuration file in the background
+/*!
+ * \ingroup io
+ The configuration is gathered to the primary node, then written by a
+ background thread. Call waitCheckpoint() to wait for the file.
+
+  \param header     A container for the Gauge Connection header metadata
+  \param u          The gauge configuration 
+  \param file       The file name 
+
+  \pre The information in the header should be filled in.
+ */    
+void writeArchivAsync(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, const std::string& file);
+
+
 //! Writes a NERSC Gauge Connection Archive gauge configuration file
 /*!
  * \ingroup io
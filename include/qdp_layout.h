@@ -63,6 +63,30 @@ namespace QDP {
 		* The API requires this function to be here.
 		*/
 		multi1d<int> siteCoords(int node, int index) QDP_CONST;
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+		//! The logical node number for a lattice coordinate, without allocation
+		int nodeNumber(const Coord<Nd>& coord) QDP_CONST;
+
+		//! The linearized site index within a node for a lattice coordinate, without allocation
+		int linearSiteIndex(const Coord<Nd>& coord) QDP_CONST;
+
+		//! Reconstruct the lattice coordinate from the node and site number, without allocation
+		void siteCoords(Coord<Nd>& coord, int node, int index) QDP_CONST;
+
+#if QDP_USE_CB2_BLOCK_LAYOUT == 1
+		//! Set the requested block size of the blocked layout
+		/*! 
+		* In units of checkerboard sites on a node, so x counts every second
+		* site. Must be called before create(). Each extent is reduced to the
+		* largest divisor of the checkerboarded subgrid size. Default is 4.
+		*/
+		void setBlockSize(const multi1d<int>& block);
+
+		//! The block size in use by the blocked layout
+		const multi1d<int>& blockSize() QDP_CONST;
+#endif
+#endif
   
 		extern "C" { 
 			/* Export this to "C" */
@@ -55,6 +55,63 @@ public:
   virtual int numArray() const = 0;
 };
     
+
+struct FnMap;
+
+//! Leaf tag that looks for a lattice read through a shift
+/*!
+ * A shift reads other sites of its source, so dest = shift(dest,...)
+ * must not be evaluated in place. forEach with this tag and OrCombine
+ * returns true if the lattice at ptr is a leaf under a FnMap.
+ */
+struct FnMapAliasLeaf
+{
+  const void *ptr;
+  bool in_map;
+
+  FnMapAliasLeaf(const void *p, bool m = false) : ptr(p), in_map(m) {}
+};
+
+template<class T>
+struct LeafFunctor<T, FnMapAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const T &a, const FnMapAliasLeaf &f)
+    {return false;}
+};
+
+template<class T>
+struct LeafFunctor<OLattice<T>, FnMapAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const FnMapAliasLeaf &f)
+    {return f.in_map && ((const void*)(a.getF()) == f.ptr);}
+};
+
+template<class T>
+struct LeafFunctor<QDPType<T,OLattice<T> >, FnMapAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPType<T,OLattice<T> > &a, const FnMapAliasLeaf &f)
+    {return LeafFunctor<OLattice<T>, FnMapAliasLeaf>::apply(static_cast<const OLattice<T>&>(a), f);}
+};
+
+template<class A>
+struct ForEach<UnaryNode<FnMap, A>, FnMapAliasLeaf, OrCombine>
+{
+  typedef bool Type_t;
+  inline static
+  Type_t apply(const UnaryNode<FnMap, A> &expr, const FnMapAliasLeaf &f,
+	       const OrCombine &c)
+  {
+    return ForEach<A, FnMapAliasLeaf, OrCombine>::apply(expr.child(), FnMapAliasLeaf(f.ptr, true), c);
+  }
+};
+
+//! Name of a map in the communication counters
+/*! The displacement of the origin under the map, map(+1,0,0,0) for a forward shift in direction 0 */
+std::string mapCommName(const MapFunc& func);
+
 /** @} */ // end of group map
 
 } // namespace QDP
@@ -9,6 +9,8 @@
 
 #include "qdp_map_obj.h"
 #include <unordered_map>
+#include <algorithm>
+#include <cstring>
 
 namespace QDP
 {
@@ -24,8 +26,204 @@ namespace QDP
 
     //! Check if this will be a new file
     bool checkForNewFile(const std::string& filename, std::ios_base::openmode mode);
+
+    //! Name of a shard file written by MapObjectDiskShard
+    std::string shardFileName(const std::string& base, int shard);
+
+    //! The shard files that exist for a base name, in order
+    std::vector<std::string> shardFiles(const std::string& base);
+
+    //! Remove the shard files numbered first and up, on the primary node
+    void removeShards(const std::string& base, int first);
+
+    //! Merge map files, e.g. shards, into one file
+    /*!
+      The records are copied without being unpacked. A key found in more
+      than one input keeps the value of the first. The user data is
+      taken from the first input. This is a collective call.
+    */
+    void mergeFiles(const std::vector<std::string>& inputs, const std::string& output);
+
+    //! Write the file header with a zero link to the metadata
+    void writeHeader(BinaryWriter& bin, const std::string& user_data, file_version_t version = 1);
+
+    //! Read and check the file header. Returns the start of the metadata
+    uint64_t readHeader(BinaryReader& bin, const std::string& file, std::string& user_data, 
+			file_version_t& version);
+
+    //! Write the key/position map and its checksum at the current position
+    void writeMap(BinaryWriter& bin, const std::vector< std::pair<std::string,uint64_t> >& map);
+
+    //! Read the key/position map at md_start and check its checksum
+    void readMap(BinaryReader& bin, const std::string& file, uint64_t md_start,
+		 std::vector< std::pair<std::string,uint64_t> >& map);
+
+    //! Parts of writeMap, for maps not held in a vector
+    /*! Write the size, then each entry, then the checksum */
+    void writeMapSize(BinaryWriter& bin, unsigned int num_records);
+    void writeMapEntry(BinaryWriter& bin, const std::string& key, uint64_t pos);
+    void writeMapChecksum(BinaryWriter& bin);
+
+    //! Parts of readMap, for maps not held in a vector
+    /*! Read the size, then that many entries, then check the checksum */
+    unsigned int readMapSize(BinaryReader& bin, uint64_t md_start);
+    void readMapEntry(BinaryReader& bin, std::string& key, uint64_t& pos);
+    void readMapChecksum(BinaryReader& bin, const std::string& file);
+
+    //! Point the header at the metadata. Leaves the writer at the end
+    void writeMapLink(BinaryWriter& bin, const std::string& user_data, uint64_t md_start);
+
+
+    //! Appends a key to a string on this node
+    /*!
+      The bytes are those BinaryWriter would write, but no checksum is
+      kept and nothing is communicated.
+    */
+    class KeyWriter : public BinaryWriter
+    {
+    public:
+      explicit KeyWriter(std::string& out_) : out(out_), nul(0) {}
+
+      void writeArrayPrimaryNode(const char* output, size_t nbytes, size_t nmemb);
+      void writeArray(const char* output, size_t nbytes, size_t nmemb);
+
+      bool fail() {return false;}
+      void flush() {}
+
+    protected:
+      QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+      std::ostream& getOstream() {return nul;}
+
+    private:
+      std::string& out;
+      std::ostream nul;
+      QDPUtil::n_uint32_t checksum;
+    };
+
+
+    //! Reads a key from bytes on this node
+    /*!
+      The bytes are read in place, without a copy into a stream. No
+      checksum is kept and nothing is communicated.
+    */
+    class KeyReader : public BinaryReader
+    {
+    public:
+      KeyReader(const char* buf_, size_t len_) : buf(buf_), len(len_), pos(0), bad(false), nul(0) {}
+
+      void readArrayPrimaryNode(char* output, size_t nbytes, size_t nmemb);
+      void readArray(char* output, size_t nbytes, size_t nmemb);
+      void readArrayLittleEndian(char* output, size_t nbytes, size_t nmemb);
+      void readArrayPrimaryNodeLittleEndian(char* output, size_t nbytes, size_t nmemb);
+
+      using BinaryReader::read;
+
+      void readDesc(std::string& result);
+      void read(std::string& result, size_t nbytes);
+
+      bool fail() {return bad;}
+
+    protected:
+      QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+      std::istream& getIstream() {return nul;}
+
+    private:
+      //! The next n bytes, or null past the end
+      const char* take(size_t n);
+
+      const char* buf;
+      size_t len, pos;
+      bool bad;
+      std::istream nul;
+      QDPUtil::n_uint32_t checksum;
+    };
+
+
+    //! Hash of encoded keys
+    /*! Mixes eight bytes at a time; the keys are short */
+    struct KeyHash
+    {
+      size_t operator()(const std::string& s) const
+      {
+	const char* p = s.data();
+	size_t n = s.size();
+	uint64_t h = 0x9e3779b97f4a7c15ULL ^ n;
+
+	for(; n >= 8; p += 8, n -= 8)
+	{
+	  uint64_t w;
+	  memcpy(&w, p, 8);
+	  h = (h ^ w) * 0xff51afd7ed558ccdULL;
+	  h ^= h >> 32;
+	}
+
+	if (n > 0)
+	{
+	  uint64_t w = 0;
+	  memcpy(&w, p, n);
+	  h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+	  h ^= h >> 29;
+	}
+
+	return static_cast<size_t>(h);
+      }
+    };
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! How the keys of the disk maps are encoded
+  /*!
+    The encoding is what write(BinaryWriter&, const K&) writes, so the
+    files do not depend on it. Specialize this for a fixed-size key to
+    encode it without going through a writer.
+  */
+  template<typename K>
+  struct MapObjKeyTraits
+  {
+    //! Append the encoding of key to out
+    static void encode(std::string& out, const K& key)
+    {
+      MapObjDiskEnv::KeyWriter bin(out);
+      write(bin, key);
+    }
+
+    //! Decode a key from len bytes at buf
+    static void decode(K& key, const char* buf, size_t len)
+    {
+      MapObjDiskEnv::KeyReader bin(buf, len);
+      read(bin, key);
+    }
   };
 
+  //! Encoding of keys written as a single word
+  template<typename K>
+  struct MapObjKeyTraitsWord
+  {
+    static void encode(std::string& out, const K& key)
+    {
+      size_t off = out.size();
+      out.append((const char*)&key, sizeof(K));
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(&out[off], sizeof(K), 1);
+    }
+
+    static void decode(K& key, const char* buf, size_t len)
+    {
+      memcpy(&key, buf, sizeof(K));
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap((char*)&key, sizeof(K), 1);
+    }
+  };
+
+  template<> struct MapObjKeyTraits<int> : public MapObjKeyTraitsWord<int> {};
+  template<> struct MapObjKeyTraits<unsigned int> : public MapObjKeyTraitsWord<unsigned int> {};
+  template<> struct MapObjKeyTraits<short int> : public MapObjKeyTraitsWord<short int> {};
+  template<> struct MapObjKeyTraits<unsigned short int> : public MapObjKeyTraitsWord<unsigned short int> {};
+  template<> struct MapObjKeyTraits<long int> : public MapObjKeyTraitsWord<long int> {};
+  template<> struct MapObjKeyTraits<unsigned long int> : public MapObjKeyTraitsWord<unsigned long int> {};
+  template<> struct MapObjKeyTraits<long long int> : public MapObjKeyTraitsWord<long long int> {};
+
 
 
 
@@ -75,6 +273,20 @@ namespace QDP
      */
     int get(const K& key, V& val) const;
 
+    /**
+     * Get data for many keys on all nodes
+     *
+     * The records are read on the primary node and broadcast in large
+     * blocks, the read of one block overlapping the broadcast of the
+     * previous one. Every node then unpacks and checks them. Values that
+     * are lattice fields are cheaper to read one at a time with get().
+     * This is a collective call.
+     * @param keys_ user supplied keys, the same on all nodes
+     * @param vals_ after the call holds the data in the order of the keys
+     * @return the number of keys not found
+     */
+    int getAll(const std::vector<K>& keys_, std::vector<V>& vals_) const;
+
 
     /**
      * Flush database in memory to disk
@@ -130,7 +342,7 @@ namespace QDP
     };
 
     //! Type for the map
-    typedef std::unordered_map<std::string, priv_pos_type_t> MapType_t;
+    typedef std::unordered_map<std::string, priv_pos_type_t, MapObjDiskEnv::KeyHash> MapType_t;
 
     //! State 
     enum State {INIT, UNCHANGED, MODIFIED};
@@ -155,6 +367,91 @@ namespace QDP
 
     //! Reader and writer interfaces
     mutable BinaryFileReaderWriter streamer;
+
+    //! End of the records. The metadata or nothing follows
+    priv_pos_type_t data_end;
+
+    //! Encode a key
+    std::string encodeKey(const K& key) const
+    {
+      std::string key_str;
+      MapObjKeyTraits<K>::encode(key_str, key);
+      return key_str;
+    }
+
+    //! Size in bytes of the blocks broadcast by getAll
+    static const size_t getall_blocksize = 64*1024*1024;
+
+    //! A record for getAll, in file order
+    struct GetAllRecord
+    {
+      uint64_t start;   // file position
+      uint64_t len;     // bytes up to the next record
+      size_t   index;   // position in the key list
+
+      bool operator<(const GetAllRecord& r) const {return start < r.start;}
+    };
+
+    //! Reads blocks of records for getAll on the primary node and unpacks them on all nodes
+    class GetAllSource : public BinaryBlockSource
+    {
+    public:
+      GetAllSource(BinaryFileReaderWriter& streamer_, const std::vector<GetAllRecord>& recs_, std::vector<V>& vals_) :
+	streamer(streamer_), recs(recs_), vals(vals_), nread(0), nused(0), pos(0) {}
+
+      bool readBlock(std::string& buf)
+      {
+	buf.clear();
+	while (nread < recs.size() && buf.size() < getall_blocksize)
+	{
+	  // Records next to each other in the file are read in one go
+	  size_t first = nread;
+	  uint64_t len = recs[nread++].len;
+	  while (nread < recs.size() && buf.size() + len < getall_blocksize
+		 && recs[nread].start == recs[nread-1].start + recs[nread-1].len)
+	    len += recs[nread++].len;
+
+	  if (recs[first].start != pos)
+	    streamer.seek(static_cast<pos_type>(recs[first].start));
+
+	  size_t off = buf.size();
+	  buf.resize(off + len);
+	  streamer.readArrayPrimaryNode(&buf[off], 1, len);
+	  pos = recs[first].start + len;
+	}
+	return ! buf.empty();
+      }
+
+      void useBlock(const std::string& buf)
+      {
+	BinaryLocalBufferReader bin(buf);
+	uint64_t off = 0;
+	while (off < buf.size())
+	{
+	  const GetAllRecord& r = recs[nused++];
+	  bin.seek(static_cast<pos_type>(off));
+	  read(bin, vals[r.index]);
+
+	  QDPUtil::n_uint32_t calc_checksum = bin.getChecksum();
+	  QDPUtil::n_uint32_t read_checksum;
+	  read(bin, read_checksum);
+
+	  if (bin.fail() || read_checksum != calc_checksum) { 
+	    QDPIO::cout << "Mismatched Checksums: Expected: " << calc_checksum << " but read " << read_checksum << std::endl;
+	    QDP_abort(1);
+	  }
+	  off += r.len;
+	}
+      }
+
+    private:
+      BinaryFileReaderWriter& streamer;
+      const std::vector<GetAllRecord>& recs;
+      std::vector<V>& vals;
+      size_t   nread;   // records read on the primary node
+      size_t   nused;   // records unpacked
+      uint64_t pos;     // file position after the last read
+    };
     
     //! Convert to known size
     priv_pos_type_t convertToPrivate(const pos_type& input) const;
@@ -168,9 +465,6 @@ namespace QDP
     //! Open an existing DB, and read map
     void openRead(const std::string& file, std::ios_base::openmode mode);
 
-    // Internal Utility: Create/Skip past header
-    void writeSkipHeader(void);
-    
     //! Internal Utility: Read/Check header 
     priv_pos_type_t readCheckHeader(void);
     
@@ -208,6 +502,7 @@ namespace QDP
   MapObjectDisk<K,V>::convertToPrivate(const pos_type& input) const
   {
     priv_pos_type_t f;
+    bzero(&f.c, sizeof(priv_pos_type_t));
     f.p = static_cast<uint64_t>(input);
     return f;
   }
@@ -260,63 +555,13 @@ namespace QDP
         QDPIO::cout << "sizeof(file_version)t) = " << sizeof(MapObjDiskEnv::file_version_t) << std::endl;
       }
 
-      if (level >= 2) {
-	QDPIO::cout << "Writing file magic: len= " << MapObjDiskEnv::getFileMagic().length() << std::endl;
-      }
-
-      // Write string
-      streamer.writeDesc(MapObjDiskEnv::getFileMagic());
+      MapObjDiskEnv::writeHeader(streamer, user_data, file_version);
       
       if (level >= 2) {
-	QDPIO::cout << "Wrote magic. Current Position: " << streamer.currentPosition() << std::endl;
-      }
-      
-      write(streamer, (MapObjDiskEnv::file_version_t)file_version);
-    
-      if (level >= 2) {
-	QDPIO::cout << "Wrote Version. Current Position is: " << streamer.currentPosition() << std::endl;
-      }
-      
-      if (level >= 2) {
-	QDPIO::cout << "Writing User Data string=" << user_data << std::endl;
-      }
-      writeDesc(streamer, user_data);
-      
-      if (level >= 2) {
-	QDPIO::cout << "Wrote User Data string. Current Position is: " << streamer.currentPosition() << std::endl;
-      }
-      
-      priv_pos_type_t dummypos = convertToPrivate(streamer.currentPosition());
-    
-      if (level >= 2) {
-	int user_len = user_data.length();
-	QDPInternal::broadcast(user_len);
-
-	QDPIO::cout << "Sanity Check 1" << std::endl; ;
-	uint64_t cur_pos = convertToPrivate(streamer.currentPosition()).p;
-	uint64_t exp_pos = 
-	  MapObjDiskEnv::getFileMagic().length()+sizeof(int)
-	  +user_len+sizeof(int)
-	  +sizeof(MapObjDiskEnv::file_version_t);
-
-	QDPIO::cout << "cur pos=" << (size_t)(cur_pos) << " expected " << (size_t)(exp_pos) << std::endl;
-
-	if ( cur_pos != exp_pos ) {
-	  QDPIO::cout << "ERROR: Sanity Check 1 failed." << std::endl;
-	  QDPIO::cout << "cur pos=" << (size_t)(cur_pos) << " expected " << (size_t)(exp_pos) << std::endl;
-	  QDP_abort(1);
-	}
-      }
-    
-      /* Write a dummy link - make room for it */
-      streamer.writeArray((char *)&dummypos, sizeof(priv_pos_type_t), 1);
-      
-      if (level >= 2) {
-	QDPIO::cout << "Wrote dummy link: Current Position " << streamer.currentPosition() << std::endl;
 	int user_len = user_data.length();
 	QDPInternal::broadcast(user_len);
 
-	QDPIO::cout << "Sanity Check 2" << std::endl;
+	QDPIO::cout << "Sanity Check" << std::endl;
 	uint64_t cur_pos = convertToPrivate(streamer.currentPosition()).p;
 	uint64_t exp_pos = 
 	  MapObjDiskEnv::getFileMagic().length()+sizeof(int)
@@ -327,10 +572,10 @@ namespace QDP
 	if ( cur_pos != exp_pos ) {
 	  QDPIO::cout << "Cur pos = " << (size_t)(cur_pos) << std::endl;
 	  QDPIO::cout << "Expected: " << (size_t)(exp_pos) << std::endl;
-	  QDPIO::cout << "ERROR: Sanity Check 2 failed." << std::endl;
+	  QDPIO::cout << "ERROR: Sanity Check failed." << std::endl;
 	  QDP_abort(1);
 	}
-	QDPIO::cout << "Finished sanity Check 2" << std::endl;
+	QDPIO::cout << "Finished sanity Check" << std::endl;
       }
       
       // Advance state machine state
@@ -367,6 +612,7 @@ namespace QDP
       QDPIO::cout << "MapObjectDisk: reading and checking header" << std::endl;
 
       priv_pos_type_t md_start = readCheckHeader();
+      data_end = md_start;
 	
       // Seek to metadata
       QDPIO::cout << "MapObjectDisk: reading key/fileposition data" << std::endl;
@@ -451,15 +697,15 @@ namespace QDP
   {
     if( streamer.is_open() ) 
     {
+      keys_.reserve(keys_.size() + src_map.size());
+
       typename MapType_t::const_iterator iter;
       for(iter  = src_map.begin();
 	  iter != src_map.end();
 	  ++iter) 
       { 
-	BinaryBufferReader bin(iter->first);
-	K key;
-	read(bin, key);
-	keys_.push_back(key);
+	keys_.push_back(K());
+	MapObjKeyTraits<K>::decode(keys_.back(), iter->first.data(), iter->first.size());
       }
     }
   }
@@ -538,9 +784,8 @@ namespace QDP
     case MODIFIED :
     case UNCHANGED : {
       //  Find key
-      BinaryBufferWriter bin;
-      write(bin, key);
-      typename MapType_t::const_iterator key_ptr = src_map.find(bin.str());
+      const std::string key_str = encodeKey(key);
+      typename MapType_t::const_iterator key_ptr = src_map.find(key_str);
 
       if (key_ptr != src_map.end()) { 
 	// Key does exist
@@ -573,11 +818,14 @@ namespace QDP
       else {
 	// Key does not exist
 
+	// Append: a get or an update may have moved the position
+	streamer.seekEnd(0);
+
 	// Make note of current writer position
 	priv_pos_type_t pos = convertToPrivate(streamer.currentPosition());
       
 	// Insert pos into map
-	src_map.insert(std::make_pair(bin.str(),pos));
+	src_map.insert(std::make_pair(key_str,pos));
      
 	streamer.resetChecksum();
 
@@ -604,6 +852,7 @@ namespace QDP
 
 	write(streamer, streamer.getChecksum()); // Write Checksum
 	streamer.flush();
+	data_end = convertToPrivate(streamer.currentPosition());
 	
 	if (level >= 2) {
 	  QDPIO::cout << "Wrote checksum " << streamer.getChecksum() << " to disk. Current Position: " << streamer.currentPosition() << std::endl;
@@ -636,9 +885,7 @@ namespace QDP
     switch(state) { 
     case UNCHANGED: // Deliberate fallthrough
     case MODIFIED: {
-      BinaryBufferWriter bin;
-      write(bin, key);
-      typename MapType_t::const_iterator key_ptr = src_map.find(bin.str());
+      typename MapType_t::const_iterator key_ptr = src_map.find(encodeKey(key));
 
       if (key_ptr != src_map.end())
       {
@@ -713,6 +960,63 @@ namespace QDP
   }
   
   
+  /*! 
+   * Lookup many items in the map on all nodes.
+   */
+  template<typename K, typename V>
+  int 
+  MapObjectDisk<K,V>::getAll(const std::vector<K>& keys_, std::vector<V>& vals_) const
+  { 
+    vals_.clear();
+    vals_.resize(keys_.size());
+
+    switch(state) { 
+    case UNCHANGED: // Deliberate fallthrough
+    case MODIFIED:
+      break;
+    default:
+      return keys_.size();
+    }
+
+    // A record runs up to the start of the next one, or to the end of the data
+    std::vector<uint64_t> starts;
+    starts.reserve(src_map.size());
+    for(typename MapType_t::const_iterator iter = src_map.begin(); iter != src_map.end(); ++iter)
+      starts.push_back(iter->second.p);
+
+    std::sort(starts.begin(), starts.end());
+
+    std::vector<GetAllRecord> recs;
+    recs.reserve(keys_.size());
+    int missing = 0;
+
+    for(size_t i=0; i < keys_.size(); ++i)
+    {
+      typename MapType_t::const_iterator key_ptr = src_map.find(encodeKey(keys_[i]));
+
+      if (key_ptr == src_map.end()) {
+	++missing;
+	continue;
+      }
+
+      GetAllRecord r;
+      r.start = key_ptr->second.p;
+      std::vector<uint64_t>::const_iterator next = std::upper_bound(starts.begin(), starts.end(), r.start);
+      r.len   = ((next != starts.end()) ? *next : data_end.p) - r.start;
+      r.index = i;
+      recs.push_back(r);
+    }
+
+    // Read in file order
+    std::sort(recs.begin(), recs.end());
+
+    GetAllSource src(streamer, recs, vals_);
+    broadcastBlocks(src);
+
+    return missing;
+  }
+  
+  
   /**
    * Does this key exist in the store
    * @param key a key object
@@ -722,9 +1026,7 @@ namespace QDP
   bool 
   MapObjectDisk<K,V>::exist(const K& key) const 
   {
-    BinaryBufferWriter bin;
-    write(bin, key);
-    return (src_map.find(bin.str()) == src_map.end()) ? false : true;
+    return (src_map.find(encodeKey(key)) == src_map.end()) ? false : true;
   }
   
   
@@ -732,34 +1034,6 @@ namespace QDP
   /***************** UTILITY ******************/
 
 
-  //! Skip past header
-  template<typename K, typename V>
-  void 
-  MapObjectDisk<K,V>::writeSkipHeader(void) 
-  { 
-    switch(state) { 
-    case MODIFIED: {
-      if ( streamer.is_open() ) 
-      { 
-	int user_len = user_data.length();
-	QDPInternal::broadcast(user_len);
-	
-	streamer.seek( MapObjDiskEnv::getFileMagic().length() + sizeof(int)
-		       + user_len + sizeof(int)
-		       + sizeof(MapObjDiskEnv::file_version_t) );
-      }
-      else { 
-	QDPIO::cerr << "Attempting writeSkipHeader, not in write mode" <<std::endl;
-	QDP_abort(1);
-      }
-    }
-    break;
-    default:
-      errorState("MapObjectDisk: writeSkipHeader() called not in MODIFIED state");
-      break;
-    }
-  }
-  
   //! Check the header 
   template<typename K, typename V>
   typename MapObjectDisk<K,V>::priv_pos_type_t
@@ -776,42 +1050,12 @@ namespace QDP
       
       streamer.rewind();
       
-      std::string read_magic;
-      streamer.readDesc(read_magic);
-      
-      // Check magic
-      if (read_magic != MapObjDiskEnv::getFileMagic()) { 
-	QDPIO::cerr << "Magic String Wrong: Expected: " << MapObjDiskEnv::getFileMagic() 
-		    << " but read: " << read_magic << std::endl;
-	QDP_abort(1);
-      }
-
-      if (level >= 2) {
-	QDPIO::cout << "Read File Magic. Current Position: " << streamer.currentPosition() << std::endl;
-      }
-      
       MapObjDiskEnv::file_version_t read_version;
-      read(streamer, read_version);
-      
-      if (level >= 2) {
-	QDPIO::cout << "Read File Verion. Current Position: " << streamer.currentPosition() << std::endl;
-      }
+      md_position.p = MapObjDiskEnv::readHeader(streamer, filename, user_data, read_version);
       
       // Check version
       QDPIO::cout << "MapObjectDisk: file has version: " << read_version << std::endl;
       
-      QDP::readDesc(streamer, user_data);
-      if (level >= 2) {
-	QDPIO::cout << "User data. String=" << user_data << ". Current Position: " << streamer.currentPosition() << std::endl;
-      }
-      
-      // Read MD location
-      streamer.readArray((char *)&md_position, sizeof(priv_pos_type_t), 1);
-
-      if (level >= 2) {
-	QDPIO::cout << "Read MD Location. Current position: " << streamer.currentPosition() << std::endl;
-      }
-      
       if (level >= 2) {
 	QDPIO::cout << "Metadata starts at position: " << convertFromPrivate(md_position) << std::endl;
       }
@@ -833,8 +1077,7 @@ namespace QDP
   {
     unsigned int map_size = src_map.size();
 
-    streamer.resetChecksum();
-    write(streamer, map_size);
+    MapObjDiskEnv::writeMapSize(streamer, map_size);
     if (level >= 2) {
       QDPIO::cout << "Wrote map size: " << map_size << " entries.  Current position : " << streamer.currentPosition() << std::endl;
     }
@@ -844,16 +1087,13 @@ namespace QDP
 	iter != src_map.end();
 	++iter) 
     { 
-      priv_pos_type_t pos=iter->second;
-      
-      writeDesc(streamer, iter->first); 
-      streamer.writeArray((char *)&pos,sizeof(priv_pos_type_t),1);
+      MapObjDiskEnv::writeMapEntry(streamer, iter->first, iter->second.p);
       
       if (level >= 2) {
 	QDPIO::cout << "Wrote Key/Position pair:  Current Position: " << streamer.currentPosition() << std::endl;
       }
     }
-    write(streamer, streamer.getChecksum());
+    MapObjDiskEnv::writeMapChecksum(streamer);
     QDPIO::cout << "Wrote Checksum On Map: " << streamer.getChecksum() << std::endl;
     streamer.flush();
   }
@@ -865,15 +1105,7 @@ namespace QDP
   void 
   MapObjectDisk<K,V>::readMapBinary(const priv_pos_type_t& md_start)
   {
-    streamer.seek(convertFromPrivate(md_start));
-    streamer.resetChecksum();
-
-    if (level >= 2) {
-      QDPIO::cout << "Sought start of metadata. Current position: " << streamer.currentPosition() << std::endl;
-    }
-    
-    unsigned int num_records;
-    read(streamer, num_records);
+    unsigned int num_records = MapObjDiskEnv::readMapSize(streamer, md_start.p);
 
     if (level >= 2) {
       QDPIO::cout << "Read num of entries: " << num_records << " records. Current Position: " << streamer.currentPosition() << std::endl;
@@ -881,29 +1113,17 @@ namespace QDP
     
     for(unsigned int i=0; i < num_records; i++) 
     { 
-      priv_pos_type_t rpos;
       std::string key_str;
-      readDesc(streamer, key_str);
-      
-      streamer.readArray((char *)&rpos, sizeof(priv_pos_type_t),1);
+      uint64_t pos;
+      MapObjDiskEnv::readMapEntry(streamer, key_str, pos);
       
       if (level >= 2) {
 	QDPIO::cout << "Read Key/Position pair. Current position: " << streamer.currentPosition() << std::endl;
       }
       // Add position to the map
-      src_map.insert(std::make_pair(key_str,rpos));
-    }
-    QDPUtil::n_uint32_t calc_checksum = streamer.getChecksum();
-    QDPUtil::n_uint32_t read_checksum;
-    read(streamer, read_checksum);
-
-    if (level >= 2) {
-      QDPIO::cout << "Read Map checksum: " << read_checksum << "  Current Position: " << streamer.currentPosition();
-    }
-    if( read_checksum != calc_checksum ) { 
-      QDPIO::cout << "Mismatched Checksums: Expected: " << calc_checksum << " but read " << read_checksum << std::endl;
-      QDP_abort(1);
+      src_map.insert(std::make_pair(key_str, convertToPrivate(pos)));
     }
+    MapObjDiskEnv::readMapChecksum(streamer, filename);
 
     if (level >= 2) {
       QDPIO::cout << " Map Checksum OK!" << std::endl;
@@ -941,25 +1161,8 @@ namespace QDP
       // Dump metadata
       writeMapBinary();
 	
-      // Rewind and Skip header 
-      streamer.rewind();
-      if (level >= 2) {
-	QDPIO::cout << "Rewound file. Current Position: " << streamer.currentPosition() << std::endl;
-      }
-      writeSkipHeader();
-      if (level >= 2) {
-	QDPIO::cout << "Skipped Header. Current Position: " << streamer.currentPosition() << std::endl;
-      }
-      // write start position of metadata
-      streamer.writeArray((const char *)&metadata_start,sizeof(priv_pos_type_t),1);
-	
-      if (level >= 2) {
-	QDPIO::cout << "Wrote link to metadata. Current Position: " << streamer.currentPosition() << std::endl;
-      }
-	
-      // skip to end and close
-      streamer.seekEnd(0);
-      streamer.flush();
+      // Point the header at the metadata, then back to the end
+      MapObjDiskEnv::writeMapLink(streamer, user_data, metadata_start.p);
 	
       QDPIO::cout << "MapObjectDisk: Closed file " << filename<< " for write access" <<  std::endl;
     }
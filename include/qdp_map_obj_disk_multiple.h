@@ -48,6 +48,20 @@ namespace QDP
     }
 
 
+    //! Open the shard files written by MapObjectDiskShard
+    void openShards(const std::string& base)
+    {
+      std::vector<std::string> files = MapObjDiskEnv::shardFiles(base);
+      if (files.size() == 0)
+      {
+	QDPIO::cerr << "MapObjectDiskMultiple: no shard files for " << base << std::endl;
+	QDP_abort(1);
+      }
+
+      open(files);
+    }
+
+
     //! Check if a DB file exists before opening.
     bool fileExists(const std::vector<std::string>& files) const
     {
@@ -102,7 +116,8 @@ namespace QDP
     void keys(std::vector<K>& keys_) const {
       keys_.clear();
 
-      std::unordered_map<std::string,int> unique_it;
+      std::unordered_map<std::string,int,MapObjDiskEnv::KeyHash> unique_it;
+      std::string key_str;
 
       for(int i=0; i < dbs_.size(); ++i) 
       {
@@ -111,19 +126,19 @@ namespace QDP
 
 	for(typename std::vector<K>::const_iterator k=kk.begin(); k != kk.end(); ++k)
 	{
-	  BinaryBufferWriter bin;
-	  write(bin, *k);
+	  key_str.clear();
+	  MapObjKeyTraits<K>::encode(key_str, *k);
 
-	  unique_it.insert(std::make_pair(bin.str(),1));
+	  unique_it.insert(std::make_pair(key_str,1));
 	}
       }
 
-      for(typename std::unordered_map<std::string,int>::const_iterator k=unique_it.begin(); k != unique_it.end(); ++k)
+      keys_.reserve(unique_it.size());
+
+      for(typename std::unordered_map<std::string,int,MapObjDiskEnv::KeyHash>::const_iterator k=unique_it.begin(); k != unique_it.end(); ++k)
       {
-	BinaryBufferReader bin(k->first);
-	K key;
-	read(bin, key);
-	keys_.push_back(key);
+	keys_.push_back(K());
+	MapObjKeyTraits<K>::decode(keys_.back(), k->first.data(), k->first.size());
       }
     }
     
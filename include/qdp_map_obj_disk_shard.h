@@ -0,0 +1,198 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief A write-only Map Object on Disk with one file per node
+ */
+
+
+#ifndef __qdp_map_obj_disk_shard_h__
+#define __qdp_map_obj_disk_shard_h__
+
+#include "qdp_map_obj_disk.h"
+#include <vector>
+
+namespace QDP
+{
+
+  //----------------------------------------------------------------------------
+  //! Write-only map on disk with one shard file per node
+  /*!
+    Each node writes the records it holds to its own file in the format
+    of MapObjectDisk, without any communication. This means nodes can
+    insert different numbers of records. Read the shards together with
+    MapObjectDiskMultiple::openShards(), or merge them into one file with
+    MapObjDiskEnv::mergeFiles().
+
+    Values are written as this node holds them, so do not store
+    lattice objects this way.
+  */
+  template<typename K, typename V>
+  class MapObjectDiskShard
+  {
+  public:
+    //! Empty constructor
+    MapObjectDiskShard() : level(0) {}
+
+    //! Finalizes object
+    ~MapObjectDiskShard() {close();}
+
+    //! Set debugging level
+    void setDebug(int level_) {level = level_;}
+
+    //! Get debugging level
+    int getDebug() const {return level;}
+
+    //! Open the shard of this node, replacing any old one
+    /*!
+      The file is MapObjDiskEnv::shardFileName(base, Layout::nodeNumber()).
+      Call on all nodes: the primary node also removes the shards left
+      by an earlier run on more nodes, so they are not read back later.
+    */
+    void open(const std::string& base)
+    {
+      close();
+
+      MapObjDiskEnv::removeShards(base, Layout::numNodes());
+
+      filename = MapObjDiskEnv::shardFileName(base, Layout::nodeNumber());
+      streamer.open(filename);
+      MapObjDiskEnv::writeHeader(streamer, user_data);
+
+      if (level >= 1)
+	std::cout << "MapObjectDiskShard: opened file " << filename << " for writing" << std::endl;
+    }
+
+    //! Write the map and close the shard
+    void close()
+    {
+      if (! streamer.is_open())
+	return;
+
+      streamer.seekEnd(0);
+      uint64_t md_start = static_cast<uint64_t>(streamer.currentPosition());
+
+      MapObjDiskEnv::writeMapSize(streamer, src_map.size());
+      for(typename MapType_t::const_iterator iter = src_map.begin(); iter != src_map.end(); ++iter)
+	MapObjDiskEnv::writeMapEntry(streamer, iter->first, iter->second);
+      MapObjDiskEnv::writeMapChecksum(streamer);
+
+      MapObjDiskEnv::writeMapLink(streamer, user_data, md_start);
+      streamer.close();
+
+      if (level >= 1)
+	std::cout << "MapObjectDiskShard: closed file " << filename << " with " << src_map.size() << " records" << std::endl;
+
+      src_map.clear();
+    }
+
+    /**
+     * Insert a pair of data and key into this node's shard
+     * @param key a key
+     * @param val a user provided data
+     *
+     * @return 0 on successful write, otherwise failure
+     */
+    int insert(const K& key, const V& val)
+    {
+      if (! streamer.is_open())
+	return 1;
+
+      const std::string key_str = encodeKey(key);
+      typename MapType_t::const_iterator key_ptr = src_map.find(key_str);
+
+      if (key_ptr != src_map.end())
+      {
+	// Key does exist. Overwrite in place
+	streamer.seek(static_cast<pos_type>(key_ptr->second));
+	streamer.resetChecksum();
+	write(streamer, val);
+	write(streamer, streamer.getChecksum());
+	streamer.seekEnd(0);
+      }
+      else
+      {
+	// Key does not exist. Append
+	uint64_t pos = static_cast<uint64_t>(streamer.currentPosition());
+	src_map.insert(std::make_pair(key_str, pos));
+
+	streamer.resetChecksum();
+	write(streamer, val);
+	write(streamer, streamer.getChecksum());
+      }
+
+      return streamer.fail() ? 1 : 0;
+    }
+
+    /**
+     * Does this key exist in this node's shard
+     * @param key a key object
+     * @return true if the answer is yes
+     */
+    bool exist(const K& key) const
+    {
+      return (src_map.find(encodeKey(key)) == src_map.end()) ? false : true;
+    }
+
+    //! The number of elements in this node's shard
+    unsigned int size() const {return static_cast<unsigned long>(src_map.size());}
+
+    /**
+     * Insert user data. Must be called before open
+     *
+     * @param user_data user supplied data
+     * @return returns 0 if success, else failure
+     */
+    int insertUserdata(const std::string& user_data_)
+    {
+      if (streamer.is_open())
+	return 1;
+
+      user_data = user_data_;
+      return 0;
+    }
+
+    //! Flush the records written so far. The map is written by close()
+    void flush() {streamer.flush();}
+
+    //! The name of this node's shard
+    const std::string& getFileName() const {return filename;}
+
+  private:
+    //! Hide
+    MapObjectDiskShard(const MapObjectDiskShard&) {}
+
+    //! Hide
+    void operator=(const MapObjectDiskShard&) {}
+
+  private:
+    typedef std::ostream::pos_type pos_type;
+
+    //! Type for the map
+    typedef std::unordered_map<std::string, uint64_t, MapObjDiskEnv::KeyHash> MapType_t;
+
+    //! Debugging
+    int level;
+
+    //! Map of objects
+    MapType_t src_map;
+
+    //! The file of this node
+    std::string filename;
+
+    //! Metadata
+    std::string user_data;
+
+    //! Node local writer
+    BinaryLocalFileWriter streamer;
+
+    //! Encode a key
+    std::string encodeKey(const K& key) const
+    {
+      std::string key_str;
+      MapObjKeyTraits<K>::encode(key_str, key);
+      return key_str;
+    }
+  };
+
+} // namespace QDP
+
+#endif
@@ -10,6 +10,8 @@
 #define MULTI_INCLUDE
 
 #include "qdp_config.h"
+#include <algorithm>
+
 namespace QDP {
 
 /*! @defgroup multi  Multi-dimensional arrays
@@ -51,6 +53,62 @@ public:
 	F[i] = s.F[i];
     }
 
+#if __cplusplus >= 201103L
+  //! Move constructor
+  /*! Takes over the array of s, which is left empty. Placement arrays are copied */
+  multi1d(multi1d&& s): copymem(false), n1(s.n1), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n1);
+
+	for(int i=0; i < n1; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+      }
+    }
+
+  //! Move assignment
+  /*! Takes over the array of s unless either side is placement memory */
+  multi1d& operator=(multi1d&& s1)
+    {
+      if (copymem || s1.copymem)
+	return operator=(static_cast<const multi1d&>(s1));
+
+      if (this != &s1)
+      {
+	delete[] F;
+	F = s1.F;
+	n1 = s1.n1;
+	s1.F = 0;
+	s1.n1 = 0;
+      }
+      return *this;
+    }
+#endif
+
+  //! Exchange contents with s
+  /*! No copying unless either side is placement memory */
+  void swap(multi1d& s)
+    {
+      if (copymem || s.copymem)
+      {
+	multi1d tmp(*this);
+	*this = s;
+	s = tmp;
+      }
+      else
+      {
+	std::swap(F, s.F);
+	std::swap(n1, s.n1);
+      }
+    }
+
   //! Resize routine, call a templated resize, using *this to disambiguate
   // template type
   void resize(int ns1) { resize(*this, ns1); }
@@ -655,6 +713,66 @@ public:
 	F[i] = s.F[i];
     }
 
+#if __cplusplus >= 201103L
+  //! Move constructor
+  /*! Takes over the array of s, which is left empty. Placement arrays are copied */
+  multi2d(multi2d&& s): copymem(false), n1(s.n1), n2(s.n2), sz(s.sz), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n2,n1);
+
+	for(int i=0; i < sz; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = s.n2 = s.sz = 0;
+      }
+    }
+
+  //! Move assignment
+  /*! Takes over the array of s unless either side is placement memory */
+  multi2d<T>& operator=(multi2d<T>&& s1)
+    {
+      if (copymem || s1.copymem)
+	return operator=(static_cast<const multi2d<T>&>(s1));
+
+      if (this != &s1)
+      {
+	delete[] F;
+	F = s1.F;
+	n1 = s1.n1;
+	n2 = s1.n2;
+	sz = s1.sz;
+	s1.F = 0;
+	s1.n1 = s1.n2 = s1.sz = 0;
+      }
+      return *this;
+    }
+#endif
+
+  //! Exchange contents with s
+  /*! No copying unless either side is placement memory */
+  void swap(multi2d<T>& s)
+    {
+      if (copymem || s.copymem)
+      {
+	multi2d<T> tmp(*this);
+	*this = s;
+	s = tmp;
+      }
+      else
+      {
+	std::swap(F, s.F);
+	std::swap(n1, s.n1);
+	std::swap(n2, s.n2);
+	std::swap(sz, s.sz);
+      }
+    }
+
   //! Allocate mem for the array
   void resize(int ns2, int ns1) {
     if(copymem) {
@@ -729,6 +847,15 @@ private:
 
 
 
+//! Exchange the contents of two 1D arrays
+template<class T>
+inline void swap(multi1d<T>& a, multi1d<T>& b) {a.swap(b);}
+
+//! Exchange the contents of two 2D arrays
+template<class T>
+inline void swap(multi2d<T>& a, multi2d<T>& b) {a.swap(b);}
+
+
 //------------------------------------------------------------------------------------------
 //! Container for a multi-dimensional 3D array
 template<class T> class multi3d
@@ -295,6 +295,16 @@ public:
     }
 
 
+  //! conversion by constructor  OLattice<T> = OCBLattice<T1>
+  /*! Zero off the checkerboard of rhs */
+  template<class T1>
+  OLattice(const OCBLattice<T1>& rhs)
+    {
+      alloc_mem("construct from OCBLattice");
+      this->assign(rhs);
+    }
+
+
   //! conversion by constructor  OLattice = Expr
   template<class RHS, class T1>
   OLattice(const QDPExpr<RHS, OLattice<T1> >& rhs)
@@ -380,6 +390,50 @@ public:
       this->assign(rhs);
     }
 
+#if __cplusplus >= 201103L
+  //! Move constructor
+  /*! 
+   * Takes over the buffer of rhs if rhs owns it, leaving rhs a fresh
+   * one, otherwise a deep copy
+   */
+  OLattice(OLattice&& rhs)
+    {
+      alloc_mem("move");
+      if (rhs.mem)
+	std::swap(F, rhs.F);
+      else
+	this->assign(rhs);
+    }
+
+  //! Move assignment
+  /*! Exchanges buffers with rhs when both own them, otherwise a deep copy */
+  inline
+  OLattice& operator=(OLattice&& rhs)
+    {
+      if (mem && rhs.mem)
+      {
+	std::swap(F, rhs.F);
+	return *this;
+      }
+
+      return this->assign(rhs);
+    }
+#endif
+
+  //! Exchange contents with rhs
+  /*! Swaps the buffers when both own them, otherwise three deep copies */
+  void swap(OLattice& rhs)
+    {
+      if (mem && rhs.mem)
+	std::swap(F, rhs.F);
+      else
+      {
+	OLattice tmp(rhs);
+	rhs.assign(*this);
+	this->assign(tmp);
+      }
+    }
+
 
 public:
   //! The backdoor
@@ -453,6 +507,10 @@ private:
 };
 
 
+//! Exchange the contents of two lattices
+template<class T>
+inline void swap(OLattice<T>& a, OLattice<T>& b) {a.swap(b);}
+
 /*! @} */  // end of group olattice
 
 
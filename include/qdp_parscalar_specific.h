@@ -64,27 +64,35 @@ namespace QDPInternal
 	//! Wrapper to get a functional unsigned global sum
 	inline void globalSumArray(unsigned int *dest, int len)
 	{
+		QDPTime_t t0 = commStartTime();
 		for(int i=0; i < len; i++, dest++)
 			QMP_binary_reduction(dest, sizeof(unsigned int), sumAnUnsigned);
+		if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "unsigned", len, len*sizeof(unsigned int));
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(int *dest, int len)
 	{
+		QDPTime_t t0 = commStartTime();
 		for(int i=0; i < len; i++, dest++)
 			QMP_sum_int(dest);
+		if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "int", len, len*sizeof(int));
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(float *dest, int len)
 	{
+		QDPTime_t t0 = commStartTime();
 		QMP_sum_float_array(dest, len);
+		if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "float", len, len*sizeof(float));
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(double *dest, int len)
 	{
+		QDPTime_t t0 = commStartTime();
 		QMP_sum_double_array(dest, len);
+		if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "double", len, len*sizeof(double));
 	}
 
 	//! Global sum on a multi1d
@@ -142,20 +150,26 @@ namespace QDPInternal
 #if 0 
     QDPIO::cout << "Using simple sum_double" << endl;
 #endif
+    QDPTime_t t0 = commStartTime();
     QMP_sum_double(&dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "double", 1, sizeof(double));
   }
 
 
   //! Low level hook to QMP_max_double
   inline void globalMaxValue(float* dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_max_float(dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "max", "float", 1, sizeof(float));
   }
 
   //! Low level hook to QMP_max_double
   inline void globalMaxValue(double* dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_max_double(dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "max", "double", 1, sizeof(double));
   }
 
 
@@ -172,13 +186,17 @@ namespace QDPInternal
   //! Low level hook to QMP_min_float
   inline void globalMinValue(float* dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_min_float(dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "min", "float", 1, sizeof(float));
   }
 
   //! Low level hook to QMP_min_double
   inline void globalMinValue(double* dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_min_double(dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "min", "double", 1, sizeof(double));
   }
 
 
@@ -201,7 +219,9 @@ namespace QDPInternal
   //! Wrapper to get a functional global And
   inline void globalAnd(bool& dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_binary_reduction(&dest, sizeof(bool), globalCheckAnd);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "and", "bool", 1, sizeof(bool));
   }
 
 
@@ -215,14 +235,18 @@ namespace QDPInternal
   //! Wrapper to get a functional global Or
   inline void globalOr(bool& dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_binary_reduction(&dest, sizeof(bool), globalCheckOr);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "or", "bool", 1, sizeof(bool));
   }
 
   //! Broadcast from primary node to all other nodes
   template<class T>
   inline void broadcast(T& dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_broadcast((void *)&dest, sizeof(T));
+    if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "byte", sizeof(T), sizeof(T));
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -231,7 +255,9 @@ namespace QDPInternal
   //! Broadcast from primary node to all other nodes
   inline void broadcast(void* dest, size_t nbytes)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_broadcast(dest, nbytes);
+    if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "byte", -1, nbytes);
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -323,6 +349,34 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 	 }
 }
 
+//! user function for the evaluate functions over a range of sites
+// "OLattice Op Scalar(Expression(source)) under an Subset"
+//
+template<class T, class T1, class Op, class RHS>
+void ev_run_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
+{
+	 OLattice<T>& dest = a->d;
+	 const QDPExpr<RHS,OScalar<T1> >&rhs = a->r;
+	 const Op& op= a->op;
+
+	 for(int i=lo; i < hi; ++i)
+		 op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
+}
+
+//! user function for the evaluate functions over a range of sites
+// "OLattice Op OLattice(Expression(source)) under an Subset"
+//
+template<class T, class T1, class Op, class RHS>
+void evaluate_run_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
+{
+	 OLattice<T>& dest = a->d;
+	 const QDPExpr<RHS,OLattice<T1> >&rhs = a->r;
+	 const Op& op= a->op;
+
+	 for(int i=lo; i < hi; ++i)
+		 op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+}
+
 } // namespace QDP
 
 //! include the header file for dispatch
@@ -343,16 +397,17 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 // cerr << "In evaluateSubset(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest, op, rhs);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	int numSiteTable = s.numSiteTable();
 	
 	u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
 
-	dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
+	if (s.hasRunRep())
+		dispatch_to_runs< u_arg<T,T1,Op,RHS> >(s, a, ev_run_userfunc);
+	else
+		dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
 
 	///////////////////
 	// Original code
@@ -367,11 +422,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 	//op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
 	//}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -387,16 +438,29 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //	cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest, op, rhs);
-	prof.time -= getClockTime();
-#endif
+	// A shift reads other sites of its source, so a destination that
+	// is also shifted on the right hand side goes via a temporary
+	if (forEach(rhs, FnMapAliasLeaf(dest.getF()), OrCombine()))
+	{
+		// T1 is only the declared type, the temporary holds the evaluated sites
+		typedef typename DeReference<typename ForEach<RHS, EvalLeaf1, OpCombine>::Type_t>::Type_t Site_t;
+		OLattice<Site_t> tmp;
+		evaluate(tmp, OpAssign(), rhs, s);
+		evaluate(dest, op, PETE_identity(tmp), s);
+		return;
+	}
+
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	int numSiteTable = s.numSiteTable();
 
 	user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
 
-	dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
+	if (s.hasRunRep())
+		dispatch_to_runs< user_arg<T,T1,Op,RHS> >(s, a, evaluate_run_userfunc);
+	else
+		dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
 
 	////////////////////
 	// Original code
@@ -411,11 +475,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 	//op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
 	//}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -428,11 +488,6 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
 {
   //cerr << "In evaluate_F(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
-
   // int numSiteTable = s.numSiteTable();
   // user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
   // dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
@@ -451,12 +506,6 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
     //fprintf(stderr,"eval(olattice,olattice): site %d\n",i);
     op( dest[j], forEach(rhs, EvalLeaf1(i), OpCombine()));
   }
-
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
 }
 
 
@@ -500,12 +549,35 @@ namespace RNG
 }
 
 
+//! Number of uniforms fill_random takes for one site of T
+template<class T>
+inline int randomWordsPerSite()
+{
+	RNGWordCount cnt;
+	T tmp;
+	fill_random(tmp, cnt, cnt, cnt);
+	return cnt.n;
+}
+
+
 //! dest	= random	
 /*! This implementation is correct for no inner grid */
 template<class T>
 void 
 random(OScalar<T>& d)
 {
+	if (RNG::getRNGType() == RNG::RNG_PHILOX)
+	{
+		// The scalar stream sits just past the last lattice site
+		const int nw = randomWordsPerSite<T>();
+		multi1d<float> u(nw);
+		RNG::fillCounterUniforms(&(u[0]), nw, RNG::seedToWord(RNG::ran_seed), Layout::vol(), RNG::ran_counter++);
+
+		RNGUniformStream st(&(u[0]));
+		fill_random(d.elem(), st, st, st);
+		return;
+	}
+
 	Seed seed = RNG::ran_seed;
 	Seed skewed_seed = RNG::ran_seed * RNG::ran_mult;
 
@@ -515,32 +587,96 @@ random(OScalar<T>& d)
 }
 
 
+//! Thread arguments for the lattice random fills
+template<class T>
+struct RandomThreadArgs
+{
+	OLattice<T>& d;
+	const int* tab;
+	RNG::RanWord seed;          // global seed at entry, or the Philox key
+	const RNG::RanWord* pw;     // powers of ran_mult_n
+	int nw;                     // uniforms needed per site
+	RNG::RanWord counter;       // Philox stream counter
+	bool philox;                // use the counter based generator
+
+	RandomThreadArgs(OLattice<T>& d_, const int* tab_, RNG::RanWord seed_,
+									 const RNG::RanWord* pw_, int nw_, RNG::RanWord counter_, bool philox_) : 
+		d(d_), tab(tab_), seed(seed_), pw(pw_), nw(nw_), counter(counter_), philox(philox_) {}
+};
+
+//! Uniforms for one site from the selected generator
+template<class T>
+inline void randomSiteUniforms(float* u, int n, int i, const RandomThreadArgs<T>* a)
+{
+	if (a->philox)
+		RNG::fillCounterUniforms(u, n, a->seed, RNG::globalSiteIndex(i), a->counter);
+	else
+		RNG::fillUniforms(u, n, a->seed * RNG::lattice_ran_mult_word[i], a->pw);
+}
+
+template<class T>
+void randomKernel(int lo, int hi, int my_id, RandomThreadArgs<T>* a)
+{
+	multi1d<float> u(a->nw);
+
+	for(int j=lo; j < hi; ++j) 
+	{
+		int i = a->tab[j];
+
+		randomSiteUniforms(&(u[0]), a->nw, i, a);
+
+		RNGUniformStream st(&(u[0]));
+		fill_random(a->d.elem(i), st, st, st);
+	}
+}
+
+template<class T>
+void gaussianKernel(int lo, int hi, int my_id, RandomThreadArgs<T>* a)
+{
+	multi1d<float> u(2*a->nw);
+	T r1, r2;
+
+	for(int j=lo; j < hi; ++j) 
+	{
+		int i = a->tab[j];
+
+		// r1 and r2 are consecutive pieces of the stream of the site
+		randomSiteUniforms(&(u[0]), 2*a->nw, i, a);
+
+		RNGUniformStream st(&(u[0]));
+		fill_random(r1, st, st, st);
+		fill_random(r2, st, st, st);
+		fill_gaussian(a->d.elem(i), r1, r2);
+	}
+}
+
+
 //! dest	= random		under a subset
+/*!
+ * Gives the same numbers as stepping the seeds of every site through
+ * sranf, but the 47 bit seeds are held in 64 bit words and all steps
+ * of a site are computed independently
+ */
 template<class T>
 void 
 random(OLattice<T>& d, const Subset& s)
 {
-	const int *tab = s.siteTable().slice();
+	const int nw = randomWordsPerSite<T>();
+	const bool philox = (RNG::getRNGType() == RNG::RNG_PHILOX);
 
-#pragma omp parallel
-	{
-		Seed seed;
-		Seed skewed_seed;
-#pragma omp for // need the barrier to avoid that RNG::ran_seed is changed too early!
-		for(int j=0; j < s.numSiteTable(); ++j) 
-		{
-			int i = tab[j];
-			seed = RNG::ran_seed;
+	multi1d<RNG::RanWord> pw(nw+1);
+	if (! philox)
+		RNG::ranPowers(&(pw[0]), nw+1, RNG::seedToWord(RNG::ran_mult_n));
 
-			skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
-			fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
-		}
+	RNG::RanWord seed = RNG::seedToWord(RNG::ran_seed);
+	RandomThreadArgs<T> args(d, s.siteTable().slice(), seed, &(pw[0]), nw, RNG::ran_counter, philox);
+	dispatch_to_threads(s.numSiteTable(), args, randomKernel<T>);
 
-#pragma omp critical (random)
-		{
-			RNG::ran_seed = seed;	 // The seed from any site is the same as the new global seed
-		}
-	}
+	// Next Philox fill, or the seed any site would end on for the LCG
+	if (philox)
+		++RNG::ran_counter;
+	else
+		RNG::wordToSeed(RNG::ran_seed, seed * pw[nw]);
 }
 
 
@@ -565,21 +701,28 @@ void random(OLattice<T>& d)
 
 
 //! dest	= gaussian	 under a subset
+/*!
+ * Box-Muller is applied per site on the two consecutive blocks of
+ * uniforms random() would have put in two lattice temporaries
+ */
 template<class T>
 void gaussian(OLattice<T>& d, const Subset& s)
 {
-	OLattice<T>	 r1, r2;
+	const int nw = randomWordsPerSite<T>();
+	const bool philox = (RNG::getRNGType() == RNG::RNG_PHILOX);
 
-	random(r1,s);
-	random(r2,s);
+	multi1d<RNG::RanWord> pw(2*nw+1);
+	if (! philox)
+		RNG::ranPowers(&(pw[0]), 2*nw+1, RNG::seedToWord(RNG::ran_mult_n));
 
-	const int *tab = s.siteTable().slice();
-#pragma omp parallel for
-	for(int j=0; j < s.numSiteTable(); ++j) 
-	{
-		int i = tab[j];
-		fill_gaussian(d.elem(i), r1.elem(i), r2.elem(i));
-	}
+	RNG::RanWord seed = RNG::seedToWord(RNG::ran_seed);
+	RandomThreadArgs<T> args(d, s.siteTable().slice(), seed, &(pw[0]), nw, RNG::ran_counter, philox);
+	dispatch_to_threads(s.numSiteTable(), args, gaussianKernel<T>);
+
+	if (philox)
+		++RNG::ran_counter;
+	else
+		RNG::wordToSeed(RNG::ran_seed, seed * pw[2*nw]);
 }
 
 
@@ -663,18 +806,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
 	typename UnaryReturn<OScalar<T>, FnSum>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
 	return d;
 }
@@ -691,18 +828,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnSum>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -720,10 +851,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
 	typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Must initialize to zero since we do not know if the loop will be entered
 	zero_rep(d.elem());
@@ -750,11 +879,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
 	return d;
 }
@@ -771,10 +896,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
 	typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Loop always entered - could unroll
 	zero_rep(d.elem());
@@ -798,11 +921,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -824,68 +943,127 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
 	typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t	dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// lazy - evaluate repeatedly
 	for(int i=0; i < ss.numSubsets(); ++i)
 		evaluate(dest[i],OpAssign(),s1,all);
 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
 	return dest;
 }
 
 
+//! Flattened start of each subset's site table
+/*!
+ * Subset k of the set occupies [offsets[k], offsets[k+1]) when the site
+ * tables of all subsets are laid end to end. Threads split this range,
+ * so each of them walks whole runs of a site table and only changes
+ * destination when it crosses into the next subset.
+ */
+inline void sumMultiOffsets(multi1d<int>& offsets, const Set& ss)
+{
+	offsets.resize(ss.numSubsets()+1);
+	offsets[0] = 0;
+	for(int k=0; k < ss.numSubsets(); ++k)
+		offsets[k+1] = offsets[k] + ss[k].numSiteTable();
+}
+
+
+template<class RHS, class T>
+struct SumMultiOLatticeThreadArgs
+{
+	typedef typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  Dest_t;
+
+	const QDPExpr<RHS,OLattice<T> >& s;
+	const Set& ss;
+	const multi1d<int>& offsets;
+	multi1d<Dest_t>& pdest;
+
+	SumMultiOLatticeThreadArgs(const QDPExpr<RHS,OLattice<T> >& s_, const Set& ss_,
+				   const multi1d<int>& offsets_, multi1d<Dest_t>& pdest_) : 
+		s(s_), ss(ss_), offsets(offsets_), pdest(pdest_) {}
+};
+
+template<class RHS, class T>
+void sumMultiKernel(int lo, int hi, int my_id, SumMultiOLatticeThreadArgs<RHS,T>* a)
+{
+	typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t  Acc_t;
+
+	const multi1d<int>& offsets = a->offsets;
+	int k = 0;
+
+	for(int n=lo; n < hi; )
+	{
+		// Find the subset holding flattened site n
+		while (offsets[k+1] <= n)
+			++k;
+
+		const int* tab = a->ss[k].siteTable().slice();
+		const int base = offsets[k];
+		const int end = (hi < offsets[k+1]) ? hi : offsets[k+1];
+
+		// Accumulate the run locally, then fold into this thread's partial
+		Acc_t acc;
+		zero_rep(acc);
+		for(; n < end; ++n)
+			acc.elem() += forEach(a->s, EvalLeaf1(tab[n-base]), OpCombine());
+
+		a->pdest[my_id][k].elem() += acc.elem();
+	}
+}
+
+
 //! multi1d<OScalar> dest	 = sumMulti(OLattice,Set) 
 /*!
  * Compute the global sum on multiple subsets specified by Set 
  *
- * This is a very simple implementation. There is no need for
- * anything fancier unless global sums are just so extraordinarily
- * slow. Otherwise, generalized sums happen so infrequently the slow
- * version is fine.
+ * The site tables of the subsets are split among the threads, each of
+ * which accumulates into a private array. The partial arrays are then
+ * added in thread order, so the result does not depend on scheduling.
  */
 template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t
 sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
-	typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t	 dest(ss.numSubsets());
+	typedef typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  Dest_t;
+	Dest_t dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
-	// Initialize result with zero
-	for(int k=0; k < ss.numSubsets(); ++k)
-		zero_rep(dest[k]);
-
-	// Loop over all sites and accumulate based on the coloring 
-	const multi1d<int>& lat_color =	 ss.latticeColoring();
-	const int nodeSites = Layout::sitesOnNode();
+	// Private partial sums for each thread
+	const int nthr = qdpNumThreads();
+	multi1d<Dest_t> pdest(nthr);
 
-	for(int i=0; i < nodeSites; ++i) 
+	for(int thread=0; thread < nthr; ++thread)
 	{
-		int j = lat_color[i];
-		dest[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+		pdest[thread].resize(ss.numSubsets());
+		for(int k=0; k < ss.numSubsets(); ++k)
+			zero_rep(pdest[thread][k]);
 	}
 
+	multi1d<int> offsets;
+	sumMultiOffsets(offsets, ss);
+
+	SumMultiOLatticeThreadArgs<RHS,T> args(s1, ss, offsets, pdest);
+	dispatch_to_threads(offsets[ss.numSubsets()], args, sumMultiKernel<RHS,T>);
+
+	// Reduce in a fixed order
+	for(int k=0; k < ss.numSubsets(); ++k)
+		dest[k] = pdest[0][k];
+
+	for(int thread=1; thread < nthr; ++thread)
+		for(int k=0; k < ss.numSubsets(); ++k)
+			dest[k] += pdest[thread][k];
+
 	// Do a global sum on the result
 	QDPInternal::globalSumArray(dest);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
 	return dest;
 }
@@ -907,73 +1085,128 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
 	multi2d<typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t> dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// lazy - evaluate repeatedly
 	for(int i=0; i < dest.size1(); ++i)
 		for(int j=0; j < dest.size2(); ++j)
 			dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], 1);
 
 	return dest;
 }
 
 
+template<class T>
+struct SumMultiArrayThreadArgs
+{
+	typedef multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  Dest_t;
+
+	const multi1d< OLattice<T> >& s;
+	const Set& ss;
+	const multi1d<int>& offsets;
+	multi1d<Dest_t>& pdest;
+
+	SumMultiArrayThreadArgs(const multi1d< OLattice<T> >& s_, const Set& ss_,
+				const multi1d<int>& offsets_, multi1d<Dest_t>& pdest_) : 
+		s(s_), ss(ss_), offsets(offsets_), pdest(pdest_) {}
+};
+
+template<class T>
+void sumMultiArrayKernel(int lo, int hi, int my_id, SumMultiArrayThreadArgs<T>* a)
+{
+	typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t  Acc_t;
+
+	// Number of fields accumulated in one sweep over the sites
+	const int nblock = 4;
+
+	const multi1d<int>& offsets = a->offsets;
+	const int nfield = a->s.size();
+
+	for(int f0=0; f0 < nfield; f0 += nblock)
+	{
+		const int nb = (nfield - f0 < nblock) ? nfield - f0 : nblock;
+		int k = 0;
+
+		for(int n=lo; n < hi; )
+		{
+			// Find the subset holding flattened site n
+			while (offsets[k+1] <= n)
+				++k;
+
+			const int* tab = a->ss[k].siteTable().slice();
+			const int base = offsets[k];
+			const int end = (hi < offsets[k+1]) ? hi : offsets[k+1];
+
+			Acc_t acc[nblock];
+			for(int b=0; b < nb; ++b)
+				zero_rep(acc[b]);
+
+			for(; n < end; ++n)
+			{
+				const int i = tab[n-base];
+				for(int b=0; b < nb; ++b)
+					acc[b].elem() += a->s[f0+b].elem(i);
+			}
+
+			for(int b=0; b < nb; ++b)
+				a->pdest[my_id](f0+b,k).elem() += acc[b].elem();
+		}
+	}
+}
+
+
 //! multi2d<OScalar> dest	 = sumMulti(multi1d<OLattice>,Set) 
 /*!
  * Compute the global sum on multiple subsets specified by Set 
  *
- * This is a very simple implementation. There is no need for
- * anything fancier unless global sums are just so extraordinarily
- * slow. Otherwise, generalized sums happen so infrequently the slow
- * version is fine.
+ * Threaded like the single field version. Several fields are
+ * accumulated in each sweep over the site tables.
  */
 template<class T>
 multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>
 sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
-	multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> dest(s1.size(), ss.numSubsets());
-
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	typedef multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  Dest_t;
+	Dest_t dest(s1.size(), ss.numSubsets());
 
-	// Initialize result with zero
-	for(int i=0; i < dest.size1(); ++i)
-		for(int j=0; j < dest.size2(); ++j)
-			zero_rep(dest(j,i));
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
-	// Loop over all sites and accumulate based on the coloring 
-	const multi1d<int>& lat_color =	 ss.latticeColoring();
+	// Private partial sums for each thread
+	const int nthr = qdpNumThreads();
+	multi1d<Dest_t> pdest(nthr);
 
-	for(int k=0; k < s1.size(); ++k)
+	for(int thread=0; thread < nthr; ++thread)
 	{
-		const OLattice<T>& ss1 = s1[k];
-		const int nodeSites = Layout::sitesOnNode();
-		for(int i=0; i < nodeSites; ++i) 
-		{
-			int j = lat_color[i];
-			dest(k,j).elem() += ss1.elem(i);
-		}
+		pdest[thread].resize(s1.size(), ss.numSubsets());
+		for(int i=0; i < dest.size1(); ++i)
+			for(int j=0; j < dest.size2(); ++j)
+				zero_rep(pdest[thread](j,i));
 	}
 
+	multi1d<int> offsets;
+	sumMultiOffsets(offsets, ss);
+
+	SumMultiArrayThreadArgs<T> args(s1, ss, offsets, pdest);
+	dispatch_to_threads(offsets[ss.numSubsets()], args, sumMultiArrayKernel<T>);
+
+	// Reduce in a fixed order
+	for(int i=0; i < dest.size1(); ++i)
+		for(int j=0; j < dest.size2(); ++j)
+			dest(j,i) = pdest[0](j,i);
+
+	for(int thread=1; thread < nthr; ++thread)
+		for(int i=0; i < dest.size1(); ++i)
+			for(int j=0; j < dest.size2(); ++j)
+				dest(j,i) += pdest[thread](j,i);
+
 	// Do a global sum on the result
 	QDPInternal::globalSumArray(dest);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], Layout::sitesOnNode()*s1.size());
 
 	return dest;
 }
@@ -993,10 +1226,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1007,11 +1238,7 @@ norm2(const multi1d< OScalar<T> >& s1)
 		d.elem() += localNorm2(ss1.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], 1);
 
 	return d;
 }
@@ -1039,10 +1266,8 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
 	typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1074,11 +1299,7 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1114,10 +1335,8 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 {
 	typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProduct>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1129,11 +1348,7 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 		d.elem() += localInnerProduct(ss1.elem(),ss2.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnInnerProduct(), s1[0], 1);
 
 	return d;
 }
@@ -1164,10 +1379,8 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
 {
 	typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1199,11 +1412,7 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnInnerProduct(), s1[0], s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1239,10 +1448,8 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 {
 	typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProductReal>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1254,11 +1461,7 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 		d.elem() += localInnerProductReal(ss1.elem(),ss2.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnInnerProductReal(), s1[0], 1);
 
 	return d;
 }
@@ -1289,10 +1492,8 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 {
 	typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1324,11 +1525,7 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnInnerProductReal(), s1[0], s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1365,18 +1562,12 @@ globalMax(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnGlobalMax>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global max needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnGlobalMax(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -1392,10 +1583,8 @@ globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
 {
 	typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Loop always entered so unroll
 	d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());	 // SINGLE NODE VERSION FOR NOW
@@ -1413,11 +1602,7 @@ globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
 	// Do a global max on the result
 	QDPInternal::globalMax(d); 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnGlobalMax(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -1433,18 +1618,12 @@ globalMin(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnGlobalMin>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global min needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnGlobalMin(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -1460,10 +1639,8 @@ globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
 {
 	typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof;
+	QDPProfileTimer_t prof_timer;
 
 	// Loop always entered so unroll
 	d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());	 // SINGLE NODE VERSION FOR NOW
@@ -1481,11 +1658,7 @@ globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
 	// Do a global min on the result
 	QDPInternal::globalMin(d); 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_timer, d, OpAssign(), FnGlobalMin(), s1, Layout::sitesOnNode());
 
 	return d;
 }
@@ -1516,10 +1689,8 @@ isnan(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsNan(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1529,11 +1700,7 @@ isnan(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsNan(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1561,10 +1728,8 @@ isinf(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsInf(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1574,11 +1739,7 @@ isinf(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsInf(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1606,10 +1767,8 @@ isfinite(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsFinite(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1619,11 +1778,7 @@ isfinite(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsFinite(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1651,10 +1806,8 @@ isnormal(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsNormal(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1664,11 +1817,7 @@ isnormal(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsNormal(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1825,20 +1974,149 @@ QDP_insert(OLattice<T>& dest, const multi1d<OScalar<T> >& src, const Subset& s)
 // Map
 //
 
-// Empty map
+//! Received face of a shift
+/*!
+ * Holds the sites a shift brings in from another node. It is shared,
+ * with a reference count, between the copies of the FnMap in an
+ * expression tree. The copies are made while the tree is built,
+ * so the count is not protected against threads.
+ */
+class FnMapFace
+{
+public:
+	//! Allocate space for nbytes of received data
+	FnMapFace(int nbytes) : cnt(1)
+	{
+		mem = QMP_allocate_aligned_memory(nbytes, QDP_ALIGNMENT_SIZE,
+						  (QMP_MEM_COMMS|QMP_MEM_FAST));
+		if( mem == 0x0 ) {
+			mem = QMP_allocate_aligned_memory(nbytes, QDP_ALIGNMENT_SIZE, QMP_MEM_COMMS);
+			if( mem == 0x0 ) {
+				QDP_error_exit("Unable to allocate recv_buf_mem\n");
+			}
+		}
+
+		buf = QMP_get_memory_pointer(mem);
+		if ( buf == 0x0 ) {
+			QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (recv_buf)\n");
+		}
+	}
+
+	~FnMapFace() {QMP_free_memory(mem);}
+
+	//! Pointer to the received data
+	void* slice() const {return buf;}
+
+	void addRef() {++cnt;}
+
+	//! Drop a reference, returns true when the last one is gone
+	bool release() {return (--cnt == 0);}
+
+private:
+	FnMapFace(const FnMapFace&);
+	void operator=(const FnMapFace&);
+
+	QMP_mem_t *mem;
+	void *buf;
+	int cnt;
+};
+
+
+//! This is the PETE version of a map, namely return an expression
+/*!
+ * Site i of the result is read from site goff[i] of the child,
+ * unless roff[i] >= 0 in which case it was received from another
+ * node and sits at position roff[i] of the face.
+ */
 struct FnMap
 {
-	PETE_EMPTY_CONSTRUCTORS(FnMap)
+	const int *goff;
+	const int *roff;
+	FnMapFace *face;
+
+	FnMap(const int *goffsets) : goff(goffsets), roff(0), face(0) {}
+
+	FnMap(const int *goffsets, const int *roffsets, FnMapFace *f) :
+		goff(goffsets), roff(roffsets), face(f) {}
+
+	FnMap(const FnMap& a) : goff(a.goff), roff(a.roff), face(a.face)
+	{
+		if (face)
+			face->addRef();
+	}
+
+	FnMap& operator=(const FnMap& a)
+	{
+		if (a.face)
+			a.face->addRef();
+		if (face && face->release())
+			delete face;
+
+		goff = a.goff;
+		roff = a.roff;
+		face = a.face;
+		return *this;
+	}
+
+	~FnMap()
+	{
+		if (face && face->release())
+			delete face;
+	}
+
+	template<class T>
+	inline typename UnaryReturn<T, FnMap>::Type_t
+	operator()(const T &a) const
+	{
+		return (a);
+	}
 };
 
-#if defined(QDP_USE_PROFILING)	 
 template <>
 struct TagVisitor<FnMap, PrintTag> : public ParenPrinter<FnMap>
 { 
 	static void visit(FnMap op, PrintTag t) 
 		{ t.os_m << "shift"; }
 };
-#endif
+
+
+//! Type of a site of the face, stripping a possible Reference
+template<class T>
+struct FnMapFaceType
+{
+	typedef T Type_t;
+	inline static const T& get(const T& a) {return a;}
+};
+
+template<class T>
+struct FnMapFaceType<Reference<T> >
+{
+	typedef T Type_t;
+	inline static const T& get(const Reference<T>& a) {return a.reference();}
+};
+
+
+// Specialization of ForEach deals with maps.
+template<class A, class CTag>
+struct ForEach<UnaryNode<FnMap, A>, EvalLeaf1, CTag>
+{
+	typedef typename ForEach<A, EvalLeaf1, CTag>::Type_t TypeA_t;
+	typedef typename Combine1<TypeA_t, FnMap, CTag>::Type_t Type_t;
+	typedef FnMapFaceType<TypeA_t> Face_t;
+
+	inline static
+	Type_t apply(const UnaryNode<FnMap, A> &expr, const EvalLeaf1 &f,
+		     const CTag &c)
+	{
+		const FnMap& op = expr.operation();
+		const int i = f.val1();
+
+		if (op.roff && op.roff[i] >= 0)
+			return op(((const typename Face_t::Type_t*)(op.face->slice()))[op.roff[i]]);
+
+		return op(Face_t::get(ForEach<A, EvalLeaf1, CTag>::apply(expr.child(), EvalLeaf1(op.goff[i]), c)));
+	}
+};
 
 
 //! General permutation map class for communications
@@ -1859,283 +2137,194 @@ public:
 	void make(const MapFunc& func);
 
 	//! Function call operator for a shift
-	/*! 
+	/*!
 	 * map(source)
 	 *
 	 * Implements:	dest(x) = s1(x+offsets)
 	 *
-	 * Shifts on a OLattice are non-trivial.
+	 * The shift is returned as an expression. On-node sites are read
+	 * through the offsets when the expression is evaluated, only the
+	 * face received from another node is stored.
 	 *
 	 * Notice, this implementation does not allow an Inner grid
 	 */
-	template<class T1>
-	OLattice<T1>
-	operator()(const OLattice<T1> & l)
+	template<class T1,class C1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+	operator()(const QDPType<T1,C1> & l)
 	{
-#if QDP_DEBUG >= 3
-		QDP_info("Map()");
-#endif
-
-		OLattice<T1> d;
-		const int nodeSites = Layout::sitesOnNode();
+		typedef typename CreateLeaf<QDPType<T1,C1> >::Leaf_t Leaf_t;
+		typedef UnaryNode<FnMap,Leaf_t> Tree_t;
 
-		if (offnodeP)
-		{
-	// Off-node communications required
-#if QDP_DEBUG >= 3
-			QDP_info("Map: off-node communications required");
-#endif
+		Leaf_t leaf(CreateLeaf<QDPType<T1,C1> >::make(l));
+		return MakeReturn<Tree_t,C1>::make(Tree_t(makeFnMap(leaf), leaf));
+	}
 
-	// Eventually these declarations should move into d - the return object
-			typedef T1 * T1ptr;
-			T1 **dest = new(std::nothrow) T1ptr[nodeSites];
-			if( dest == 0x0 ) { 
-				QDP_error_exit("Unable to new T1ptr in OLattice<T1>::operator()\n");
-			}
-			QMP_msgmem_t msg[2];
-			QMP_msghandle_t mh_a[2], mh;
 
-#if 0
-			// This test has been moved into Map::create.
-			// For now, will assume there is only 1 destination nod e 
-			// and receive from only 1 node
-			if (srcenodes.size() != 1)
-				QDP_error_exit("Map: for now only allow 1 destination node");
-	
-			if (destnodes.size() != 1)
-				QDP_error_exit("Map: for now only allow receives from 1 node");
-#endif
+	template<class T1>
+	OScalar<T1>
+	operator()(const OScalar<T1> & l)
+		{
+			return l;
+		}
 
-			int dstnum = destnodes_num[0]*sizeof(T1);
-			int srcnum = srcenodes_num[0]*sizeof(T1);
-
-	// Try getting fast and communicable memory
-			QMP_mem_t *send_buf_mem = QMP_allocate_aligned_memory(dstnum,QDP_ALIGNMENT_SIZE, 
-								(QMP_MEM_COMMS|QMP_MEM_FAST) ); // packed data to send
-	if( send_buf_mem == 0x0 ) { 
-				send_buf_mem = QMP_allocate_aligned_memory(dstnum, QDP_ALIGNMENT_SIZE, 
-									QMP_MEM_COMMS);
-				if( send_buf_mem == 0x0 ) { 
-					QDP_error_exit("Unable to allocate send_buf_mem\n");
-				}
-			}
+	template<class RHS, class T1>
+	OScalar<T1>
+	operator()(const QDPExpr<RHS,OScalar<T1> > & l)
+		{
+			// For now, simply evaluate the expression and then do the map
+			typedef OScalar<T1> C1;
 
-			QMP_mem_t *recv_buf_mem = QMP_allocate_aligned_memory(srcnum,QDP_ALIGNMENT_SIZE, 
-										(QMP_MEM_COMMS|QMP_MEM_FAST)); // packed receive data
-			if( recv_buf_mem == 0x0 ) { 
-				recv_buf_mem = QMP_allocate_aligned_memory(srcnum, QDP_ALIGNMENT_SIZE, QMP_MEM_COMMS); 
-				if( recv_buf_mem == 0x0 ) { 
-					QDP_error_exit("Unable to allocate recv_buf_mem\n");
-				}
-			}
-				
-			T1 *send_buf = (T1 *)QMP_get_memory_pointer(send_buf_mem);
-			T1 *recv_buf = (T1 *)QMP_get_memory_pointer(recv_buf_mem);
+//		fprintf(stderr,"map(QDPExpr<OScalar>)\n");
+			OScalar<T1> d = this->operator()(C1(l));
 
-			// Total and utter paranoia
-			if ( send_buf == 0x0 ) { 
-				QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (send_buf)\n");
-			}
+			return d;
+		}
 
-			if ( recv_buf == 0x0 ) { 
-				QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (recv_buf)\n"); 
-			}
+	//! Shift of an expression
+	/*! Only the face sites of the expression are evaluated up front */
+	template<class RHS, class T1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::Leaf_t>, OLattice<T1> >::Expression_t
+	operator()(const QDPExpr<RHS,OLattice<T1> > & l)
+		{
+			typedef typename CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::Leaf_t Leaf_t;
+			typedef UnaryNode<FnMap,Leaf_t> Tree_t;
 
-			const int my_node = Layout::nodeNumber();
+			Leaf_t leaf(CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::make(l));
+			return MakeReturn<Tree_t,OLattice<T1> >::make(Tree_t(makeFnMap(leaf), leaf));
+		}
 
-			// Gather the face of data to send
-			// For now, use the all subset
-			for(int si=0; si < soffsets.size(); ++si) 
-			{
-#if QDP_DEBUG >= 3
-				QDP_info("Map_scatter_send(buf[%d],olattice[%d])",si,soffsets[si]);
-#endif
 
-				send_buf[si] = l.elem(soffsets[si]);
-			}
+public:
+	//! Accessor to offsets
+	const multi1d<int>& goffset() const {return goffsets;}
+	const multi1d<int>& soffset() const {return soffsets;}
 
-			// Set the dest gather pointers
-			// For now, use the all subset
+private:
+	//! Hide copy constructor
+	Map(const Map&) {}
 
-		// no threading to avoid confusion with order of recv_buf (and fast anyways)
-			for(int i=0, ri=0; i < nodeSites; ++i) 
-			{
-				if (srcnode[i] != my_node)
-				{
-#if QDP_DEBUG >= 3
-					QDP_info("Map_gather_recv(olattice[%d],recv[%d])",i,ri);
-#endif
+	//! Hide operator=
+	void operator=(const Map&) {}
 
-					dest[i] = &(recv_buf[ri++]);
-				}
-				else
-				{
+	//! Make the map node for a source, receiving its face from the other node
+	template<class L>
+	FnMap makeFnMap(const L& l) const
+	{
 #if QDP_DEBUG >= 3
-					QDP_info("Map_gather_onnode(olattice[%d],olattice[%d])",i,goffsets[i]);
+		QDP_info("Map()");
 #endif
 
-					dest[i] = &(const_cast<T1&>(l.elem(goffsets[i])));
-				}
-			}
-
-			QMP_status_t err;
+		if (! offnodeP)
+			return FnMap(goffsets.slice());
 
+		// Off-node communications required
 #if QDP_DEBUG >= 3
-			QDP_info("Map: send = 0x%x	recv = 0x%x",send_buf,recv_buf);
-			QDP_info("Map: establish send=%d recv=%d",destnodes[0],srcenodes[0]);
-			{
-				const multi1d<int>& me = Layout::nodeCoord();
-				multi1d<int> scrd = Layout::getLogicalCoordFrom(destnodes[0]);
-				multi1d<int> rcrd = Layout::getLogicalCoordFrom(srcenodes[0]);
-
-				QDP_info("Map: establish-info		my_crds=[%d,%d,%d,%d]",me[0],me[1],me[2],me[3]);
-				QDP_info("Map: establish-info send_crds=[%d,%d,%d,%d]",scrd[0],scrd[1],scrd[2],scrd[3]);
-				QDP_info("Map: establish-info recv_crds=[%d,%d,%d,%d]",rcrd[0],rcrd[1],rcrd[2],rcrd[3]);
-			}
+		QDP_info("Map: off-node communications required");
 #endif
 
-			msg[0]	= QMP_declare_msgmem(recv_buf, srcnum);
-			if( msg[0] == (QMP_msgmem_t)NULL ) { 
-				QDP_error_exit("QMP_declare_msgmem for msg[0] failed in Map::operator()\n");
-			}
-			msg[1]	= QMP_declare_msgmem(send_buf, dstnum);
-			if( msg[1] == (QMP_msgmem_t)NULL ) {
-				QDP_error_exit("QMP_declare_msgmem for msg[1] failed in Map::operator()\n");
-			}
+		typedef FnMapFaceType<typename ForEach<L, EvalLeaf1, OpCombine>::Type_t> Face_t;
+		typedef typename Face_t::Type_t T1;
 
-			mh_a[0] = QMP_declare_receive_from(msg[0], srcenodes[0], 0);
-			if( mh_a[0] == (QMP_msghandle_t)NULL ) { 
-				QDP_error_exit("QMP_declare_receive_from for mh_a[0] failed in Map::operator()\n");
-			}
+		QMP_msgmem_t msg[2];
+		QMP_msghandle_t mh_a[2], mh;
 
-			mh_a[1] = QMP_declare_send_to(msg[1], destnodes[0], 0);
-			if( mh_a[1] == (QMP_msghandle_t)NULL ) {
-				QDP_error_exit("QMP_declare_send_to for mh_a[1] failed in Map::operator()\n");
-			}
+		int dstnum = destnodes_num[0]*sizeof(T1);
+		int srcnum = srcenodes_num[0]*sizeof(T1);
 
-			mh			= QMP_declare_multiple(mh_a, 2);
-			if( mh == (QMP_msghandle_t)NULL ) { 
-				QDP_error_exit("QMP_declare_multiple for mh failed in Map::operator()\n");
+		// Try getting fast and communicable memory
+		QMP_mem_t *send_buf_mem = QMP_allocate_aligned_memory(dstnum,QDP_ALIGNMENT_SIZE, 
+								      (QMP_MEM_COMMS|QMP_MEM_FAST) ); // packed data to send
+		if( send_buf_mem == 0x0 ) { 
+			send_buf_mem = QMP_allocate_aligned_memory(dstnum, QDP_ALIGNMENT_SIZE, 
+								   QMP_MEM_COMMS);
+			if( send_buf_mem == 0x0 ) { 
+				QDP_error_exit("Unable to allocate send_buf_mem\n");
 			}
+		}
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: calling start send=%d recv=%d",destnodes[0],srcenodes[0]);
-#endif
+		T1 *send_buf = (T1 *)QMP_get_memory_pointer(send_buf_mem);
 
-			// Launch the faces
-			if ((err = QMP_start(mh)) != QMP_SUCCESS)
-				QDP_error_exit(QMP_error_string(err));
+		// Total and utter paranoia
+		if ( send_buf == 0x0 ) { 
+			QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (send_buf)\n");
+		}
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: calling wait");
-#endif
+		// Packed receive data, lives as long as the expression
+		FnMapFace *face = new FnMapFace(srcnum);
+		T1 *recv_buf = (T1 *)(face->slice());
 
-			// Wait on the faces
-			if ((err = QMP_wait(mh)) != QMP_SUCCESS)
-				QDP_error_exit(QMP_error_string(err));
+		QDPTime_t t0 = commStartTime();
 
+		// Gather the face of data to send. Only these sites of the
+		// source are evaluated here
+		for(int si=0; si < soffsets.size(); ++si) 
+		{
 #if QDP_DEBUG >= 3
-			QDP_info("Map: calling free msgs");
+			QDP_info("Map_scatter_send(buf[%d],olattice[%d])",si,soffsets[si]);
 #endif
 
-			//	QMP_free_msghandle(mh_a[1]);
-			//	QMP_free_msghandle(mh_a[0]);
-			QMP_free_msghandle(mh);
-			QMP_free_msgmem(msg[1]);
-			QMP_free_msgmem(msg[0]);
+			send_buf[si] = Face_t::get(forEach(l, EvalLeaf1(soffsets[si]), OpCombine()));
+		}
 
-			// Scatter the data into the destination
-			// Some of the data maybe in receive buffers
-			// For now, use the all subset
-#pragma omp parallel for
-			for(int i=0; i < nodeSites; ++i) 
-			{
-#if QDP_DEBUG >= 3
-				QDP_info("Map_scatter(olattice[%d],olattice[0x%x])",i,dest[i]);
-#endif
-				d.elem(i) = *(dest[i]);
-			}
+		QDPTime_t t1 = (t0) ? getClockTimeNs() : 0;
 
-			// Cleanup
-			QMP_free_memory(recv_buf_mem);
-			QMP_free_memory(send_buf_mem);
-			delete[] dest;
+		QMP_status_t err;
 
 #if QDP_DEBUG >= 3
-			QDP_info("finished cleanup");
-#endif
-		}
-		else 
-		{
-			// No off-node communications - copy on node
-#if QDP_DEBUG >= 3
-			QDP_info("Map: copy on node - no communications, try this");
+		QDP_info("Map: send = 0x%x	recv = 0x%x",send_buf,recv_buf);
+		QDP_info("Map: establish send=%d recv=%d",destnodes[0],srcenodes[0]);
 #endif
 
-			// For now, use the all subset
-#pragma omp parallel for
-			for(int i=0; i < nodeSites; ++i) 
-			{
-#if QDP_DEBUG >= 3
-				QDP_info("Map(olattice[%d],olattice[%d])",i,goffsets[i]);
-#endif
-				d.elem(i) = l.elem(goffsets[i]);
-			}
+		msg[0]	= QMP_declare_msgmem(recv_buf, srcnum);
+		if( msg[0] == (QMP_msgmem_t)NULL ) { 
+			QDP_error_exit("QMP_declare_msgmem for msg[0] failed in Map::operator()\n");
 		}
-
-#if QDP_DEBUG >= 3
-		QDP_info("exiting Map()");
-#endif
-
-		return d;
-	}
-
-
-	template<class T1>
-	OScalar<T1>
-	operator()(const OScalar<T1> & l)
-		{
-			return l;
+		msg[1]	= QMP_declare_msgmem(send_buf, dstnum);
+		if( msg[1] == (QMP_msgmem_t)NULL ) {
+			QDP_error_exit("QMP_declare_msgmem for msg[1] failed in Map::operator()\n");
 		}
 
-	template<class RHS, class T1>
-	OScalar<T1>
-	operator()(const QDPExpr<RHS,OScalar<T1> > & l)
-		{
-			// For now, simply evaluate the expression and then do the map
-			typedef OScalar<T1> C1;
+		mh_a[0] = QMP_declare_receive_from(msg[0], srcenodes[0], 0);
+		if( mh_a[0] == (QMP_msghandle_t)NULL ) { 
+			QDP_error_exit("QMP_declare_receive_from for mh_a[0] failed in Map::operator()\n");
+		}
 
-//		fprintf(stderr,"map(QDPExpr<OScalar>)\n");
-			OScalar<T1> d = this->operator()(C1(l));
+		mh_a[1] = QMP_declare_send_to(msg[1], destnodes[0], 0);
+		if( mh_a[1] == (QMP_msghandle_t)NULL ) {
+			QDP_error_exit("QMP_declare_send_to for mh_a[1] failed in Map::operator()\n");
+		}
 
-			return d;
+		mh			= QMP_declare_multiple(mh_a, 2);
+		if( mh == (QMP_msghandle_t)NULL ) { 
+			QDP_error_exit("QMP_declare_multiple for mh failed in Map::operator()\n");
 		}
 
-	template<class RHS, class T1>
-	OLattice<T1>
-	operator()(const QDPExpr<RHS,OLattice<T1> > & l)
-		{
-			// For now, simply evaluate the expression and then do the map
-			typedef OLattice<T1> C1;
+		// Launch the faces
+		if ((err = QMP_start(mh)) != QMP_SUCCESS)
+			QDP_error_exit(QMP_error_string(err));
 
-//		fprintf(stderr,"map(QDPExpr<OLattice>)\n");
-			OLattice<T1> d = this->operator()(C1(l));
+		// Wait on the faces
+		if ((err = QMP_wait(mh)) != QMP_SUCCESS)
+			QDP_error_exit(QMP_error_string(err));
 
-			return d;
-		}
+		QMP_free_msghandle(mh);
+		QMP_free_msgmem(msg[1]);
+		QMP_free_msgmem(msg[0]);
 
+		// The face is read in place by the evaluation, so nothing to unpack
+		if (t0) recordComm(comm_id, dstnum, t1 - t0, getClockTimeNs() - t1, 0);
 
-public:
-	//! Accessor to offsets
-	const multi1d<int>& goffset() const {return goffsets;}
-	const multi1d<int>& soffset() const {return soffsets;}
+		// Cleanup
+		QMP_free_memory(send_buf_mem);
 
-private:
-	//! Hide copy constructor
-	Map(const Map&) {}
+#if QDP_DEBUG >= 3
+		QDP_info("exiting Map()");
+#endif
 
-	//! Hide operator=
-	void operator=(const Map&) {}
+		return FnMap(goffsets.slice(), roffsets.slice(), face);
+	}
 
 private:
 	//! Offset table used for communications. 
@@ -2148,6 +2337,9 @@ private:
 	multi1d<int> srcnode;
 	multi1d<int> dstnode;
 
+	//! Position of each site in the received face, -1 if on node
+	multi1d<int> roffsets;
+
 	multi1d<int> srcenodes;
 	multi1d<int> destnodes;
 
@@ -2156,6 +2348,9 @@ private:
 
 	// Indicate off-node communications is needed;
 	bool offnodeP;
+
+	//! Index in the communication counters
+	int comm_id;
 };
 
 
@@ -2187,9 +2382,10 @@ public:
 	 * Notice, there may be an ILattice underneath which requires shift args.
 	 * This routine is very architecture dependent.
 	 */
-	template<class T1>
-	OLattice<T1>
-	operator()(const OLattice<T1> & l, int dir)
+	template<class T1,class C1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+	operator()(const QDPType<T1,C1> & l, int dir)
 		{
 #if QDP_DEBUG >= 3
 			QDP_info("ArrayMap(OLattice,%d)",dir);
@@ -2221,12 +2417,12 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::Leaf_t>, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int dir)
 		{
 //		fprintf(stderr,"ArrayMap(QDPExpr<OLattice>,%d)\n",dir);
 
-			// For now, simply evaluate the expression and then do the map
 			return mapsa[dir](l);
 		}
 
@@ -2271,9 +2467,10 @@ public:
 	 * Notice, there may be an ILattice underneath which requires shift args.
 	 * This routine is very architecture dependent.
 	 */
-	template<class T1>
-	OLattice<T1>
-	operator()(const OLattice<T1> & l, int isign)
+	template<class T1,class C1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+	operator()(const QDPType<T1,C1> & l, int isign)
 		{
 #if QDP_DEBUG >= 3
 			QDP_info("BiDirectionalMap(OLattice,%d)",isign);
@@ -2306,12 +2503,12 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::Leaf_t>, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int isign)
 		{
 //		fprintf(stderr,"BiDirectionalMap(QDPExpr<OLattice>,%d)\n",isign);
 
-			// For now, simply evaluate the expression and then do the map
 			return bimaps[(isign+1)>>1](l);
 		}
 
@@ -2365,9 +2562,10 @@ public:
 	 * Notice, there may be an ILattice underneath which requires shift args.
 	 * This routine is very architecture dependent.
 	 */
-	template<class T1>
-	OLattice<T1>
-	operator()(const OLattice<T1> & l, int isign, int dir)
+	template<class T1,class C1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+	operator()(const QDPType<T1,C1> & l, int isign, int dir)
 		{
 #if QDP_DEBUG >= 3
 			QDP_info("ArrayBiDirectionalMap(OLattice,%d,%d)",isign,dir);
@@ -2399,12 +2597,12 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	inline typename MakeReturn<UnaryNode<FnMap,
+		typename CreateLeaf<QDPExpr<RHS,OLattice<T1> > >::Leaf_t>, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int isign, int dir)
 		{
 //		fprintf(stderr,"ArrayBiDirectionalMap(QDPExpr<OLattice>,%d,%d)\n",isign,dir);
 
-			// For now, simply evaluate the expression and then do the map
 			return bimapsa((isign+1)>>1,dir)(l);
 		}
 
@@ -2469,9 +2667,11 @@ XMLWriter& operator<<(XMLWriter& xml, const OLattice<T>& d)
 	XMLWriterAPI::AttributeList alist;
 
 	// Find the location of each site and send to primary node
+	const Coord<Nd> nrow(Layout::lattSize());
 	for(int site=0; site < Layout::vol(); ++site)
 	{
-		multi1d<int> coord = crtesn(site, Layout::lattSize());
+		Coord<Nd> coord;
+		crtesn(coord, site, nrow);
 
 		int node	 = Layout::nodeNumber(coord);
 		int linear = Layout::linearSiteIndex(coord);
@@ -2634,6 +2834,64 @@ namespace LatticeTimeSliceIO
 				int start_lexico, int stop_lexico);
 
 
+	//! Gather of time slices to the primary node
+	/*!
+	  Each node packs the sites it holds in the range of lexicographic sites
+	  and sends them to the primary node in one message. The messages are
+	  started by start() and completed by wait(), so other work (like
+	  writing the previous slice) can go on in between.
+	*/
+	class SliceGather
+	{
+	public:
+		SliceGather();
+		~SliceGather();
+
+		//! Pack the sites of this node and start sending them
+		void start(const char* data, size_t size, size_t nmemb,
+			   int start_lexico, int stop_lexico);
+
+		//! Complete the messages. The primary node then holds the sites in lexicographic order
+		void wait();
+
+		//! Write the gathered sites
+		void write(BinaryWriter& bin) const;
+
+	private:
+		//! Hide
+		SliceGather(const SliceGather&);
+		void operator=(const SliceGather&);
+
+		size_t size, nmemb, sizemem;
+		int start_lexico, stop_lexico;
+		std::vector<char> buf;                   // sites in lexicographic order (primary node)
+		std::vector<char> stage;                 // sites grouped by node
+		std::vector<size_t> offset;              // start of each node in stage (primary node)
+		std::vector<QMP_msgmem_t> msg;
+		std::vector<QMP_msghandle_t> mh;
+	};
+
+	//! Scatter of time slices from the primary node
+	/*!
+	  The primary node sends each node all of its sites in the range of
+	  lexicographic sites in one message.
+	*/
+	void scatterOLatticeSlice(const char* buf, char* data, 
+				  size_t sizemem,
+				  int start_lexico, int stop_lexico);
+
+	//! Start the gather of a range of sites of a lattice quantity
+	template<class T>
+	void startGather(SliceGather& gather, const OLattice<T>& data, 
+			 int start_lexico, int stop_lexico)
+	{
+		gather.start((const char *)&(data.elem(0)), 
+			     sizeof(typename WordType<T>::Type_t), 
+			     sizeof(T) / sizeof(typename WordType<T>::Type_t),
+			     start_lexico, stop_lexico);
+	}
+
+
 	// Read a time slice of a lattice quantity (time must be most slowly varying)
 	template<class T>
 	void readSlice(BinaryReader& bin, OLattice<T>& data, 
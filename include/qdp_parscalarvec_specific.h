@@ -63,27 +63,35 @@ namespace QDPInternal
   //! Wrapper to get a functional unsigned global sum
   inline void globalSumArray(unsigned int *dest, int len)
   {
+    QDPTime_t t0 = commStartTime();
     for(int i=0; i < len; i++, dest++)
       QMP_binary_reduction(dest, sizeof(unsigned int), sumAnUnsigned);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "unsigned", len, len*sizeof(unsigned int));
   }
 
   //! Low level hook to QMP_global_sum
   inline void globalSumArray(int *dest, int len)
   {
+    QDPTime_t t0 = commStartTime();
     for(unsigned int i=0; i < len; i++, dest++)
       QMP_sum_int(dest);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "int", len, len*sizeof(int));
   }
 
   //! Low level hook to QMP_global_sum
   inline void globalSumArray(float *dest, int len)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_sum_float_array(dest, len);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "float", len, len*sizeof(float));
   }
 
   //! Low level hook to QMP_global_sum
   inline void globalSumArray(double *dest, int len)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_sum_double_array(dest, len);
+    if (t0) recordComm(t0, QDP_COMM_SUM, "sum", "double", len, len*sizeof(double));
   }
 
   //! Sum across all nodes
@@ -100,7 +108,9 @@ namespace QDPInternal
   template<class T>
   inline void broadcast(T& dest)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_broadcast((void *)&dest, sizeof(T));
+    if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "byte", sizeof(T), sizeof(T));
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -109,7 +119,9 @@ namespace QDPInternal
   //! Broadcast from primary node to all other nodes
   inline void broadcast(void* dest, size_t nbytes)
   {
+    QDPTime_t t0 = commStartTime();
     QMP_broadcast(dest, nbytes);
+    if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "byte", -1, nbytes);
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -136,10 +148,8 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 //  cerr << "In evaluateUnorderedSubet(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
 #if ! defined(QDP_NOT_IMPLEMENTED)
   const int *tab = s.siteTable().slice();
@@ -154,11 +164,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
   QDP_error("evaluateSubset not implemented");
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -174,10 +180,8 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //  cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
 #if ! defined(QDP_NOT_IMPLEMENTED)
   // General form of loop structure
@@ -192,11 +196,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
   QDP_error("evaluateSubset not implemented");
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -405,18 +405,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -433,18 +427,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)  
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -468,10 +456,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
   OScalar<T> tmp;   // Note, expect to have ILattice inner grid
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Must initialize to zero since we do not know if the loop will be entered
   zero_rep(d.elem());
@@ -504,11 +490,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
   // Do a global sum on the result
   QDPInternal::globalSum(d);
   
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -546,20 +528,14 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     dest[i] = sum(s1,ss[i]);
   
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -580,20 +556,14 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     dest[i] = sum(s1,ss[i]);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -615,21 +585,15 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OScalar<T>, FnSum>::Type_t>  dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < dest.size1(); ++i)
     for(int j=0; j < dest.size2(); ++j)
       dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], 1);
 
   return dest;
 }
@@ -650,21 +614,15 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int k=0; k < s1.size(); ++k)
     for(int i=0; i < ss.numSubsets(); ++i)
       dest(k,i) = sum(s1[k],ss[i]);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], Layout::sitesOnNode()*s1.size());
 
   return dest;
 }
@@ -684,10 +642,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -698,11 +654,7 @@ norm2(const multi1d< OScalar<T> >& s1)
     d.elem() += localNorm2(ss1.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], 1);
 
   return d;
 }
@@ -730,10 +682,8 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -756,11 +706,7 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
   // Do a global sum on the result
   QDPInternal::globalSum(d);
   
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -953,14 +899,12 @@ struct FnMap
   PETE_EMPTY_CONSTRUCTORS(FnMap)
 };
 
-#if defined(QDP_USE_PROFILING)   
 template <>
 struct TagVisitor<FnMap, PrintTag> : public ParenPrinter<FnMap>
 { 
   static void visit(FnMap op, PrintTag t) 
     { t.os_m << "shift"; }
 };
-#endif
 
 
 //! General permutation map class for communications
@@ -1069,6 +1013,8 @@ public:
 
 	const int my_node = Layout::nodeNumber();
 
+	QDPTime_t t0 = commStartTime();
+
 	// Gather the face of data to send
 	// For now, use the all subset
 	for(int si=0; si < soffsets.size(); ++si) 
@@ -1102,6 +1048,8 @@ public:
 	  }
 	}
 
+	QDPTime_t t1 = (t0) ? getClockTimeNs() : 0;
+
 	QMP_status_t err;
 
 #if QDP_DEBUG >= 3
@@ -1159,6 +1107,8 @@ public:
 	QMP_free_msgmem(msg[1]);
 	QMP_free_msgmem(msg[0]);
 
+	QDPTime_t t2 = (t0) ? getClockTimeNs() : 0;
+
 	// Scatter the data into the destination
 	// Some of the data maybe in receive buffers
 	// For now, use the all subset
@@ -1173,6 +1123,8 @@ public:
 	  copy_site(d.elem(iouter), iinner, *(dest[i]));    // slow - should use gather_sites
 	}
 
+	if (t0) recordComm(comm_id, dstnum, t1 - t0, t2 - t1, getClockTimeNs() - t2);
+
 	// Cleanup
 	QMP_free_memory(recv_buf_mem_t);
 	QMP_free_memory(send_buf_mem_t);
@@ -1301,6 +1253,9 @@ private:
 
   // Indicate off-node communications is needed;
   bool offnodeP;
+
+  //! Index in the communication counters
+  int comm_id;
 };
 
 
@@ -0,0 +1,101 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Hardware counter regions
+ *
+ * Named regions timed with the hardware performance counters and
+ * compared against a measured roofline of the node.
+ */
+
+#ifndef QDP_PERFREGION_H
+#define QDP_PERFREGION_H
+
+namespace QDP {
+
+/*! @defgroup perfregion Hardware counter regions
+ *
+ * @ingroup qdp
+ *
+ * A PerfRegion counts cycles, instructions and last level cache misses
+ * with Linux perf_event_open between start() and stop(). Every thread of
+ * a parallel region may start and stop the region; the counts of each
+ * thread are kept apart. Where the counters cannot be opened (not Linux,
+ * or forbidden by perf_event_paranoid) only the time is measured.
+ *
+ * Regions are looked up by name, so all PerfRegion objects of one name
+ * accumulate into the same counts. The regions are reported at
+ * QDP_finalize with the achieved GFlop/s and GB/s. With -proofline, or
+ * after a call of perfRoofline(), they are also compared against a
+ * STREAM-like roofline measured on the node.
+ *
+ * @{
+ */
+
+struct PerfRegionData;
+
+//! Measured limits of a node
+struct PerfRoofline
+{
+  double bandwidth;   // GB/s of a triad over all threads
+  double peak;        // GFlop/s of a multiply-add loop over all threads
+};
+
+//! The roofline of this node, measured on the first call
+/*! Takes a few seconds: a triad over a few hundred MB and a multiply-add loop */
+const PerfRoofline& perfRoofline();
+
+//! Measure the roofline for the report at QDP_finalize
+/*! Also switched on with -proofline */
+bool setPerfRoofline(bool on);
+bool getPerfRoofline();
+
+//! Whether the hardware counters could be opened by this thread
+bool perfCountersAvailable();
+
+
+//! Named region timed with the hardware counters
+class PerfRegion
+{
+public:
+  //! Region of this name, created on first use
+  PerfRegion(const std::string& name);
+
+  //! Destructor - the counts stay with the name
+  ~PerfRegion() {}
+
+  //! Start counting on the calling thread
+  void start();
+
+  //! Stop counting on the calling thread
+  void stop();
+
+  //! Add flops done in the region
+  void addFlops(unsigned long long flops);
+
+  //! Add the flops of a counter
+  void addFlops(const FlopCounter& fc) {addFlops(fc.getFlops());}
+
+  //! Add the bytes moved from memory, if known
+  /*! Otherwise the traffic is estimated from the cache misses */
+  void addBytes(unsigned long long bytes);
+
+  //! Zero the counts
+  void reset();
+
+  //! Print the counts of this region
+  void report();
+
+private:
+  PerfRegionData* data;
+};
+
+//! Print all regions. Called by QDP_finalize
+void printPerfRegions();
+
+//! Close the hardware counters of all threads. Called by QDP_finalize
+void finalizePerfRegions();
+
+/*! @} */  // end of group perfregion
+
+} // namespace QDP
+
+#endif
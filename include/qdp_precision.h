@@ -24,12 +24,95 @@ typedef float     REAL32;
 typedef double    REAL64;
 typedef bool      LOGICAL;
 
+//! 16-bit IEEE half precision storage word
+/*!
+ * REAL16 is a storage-only type. It converts implicitly to and from
+ * float so all arithmetic is carried out in single precision; bulk
+ * conversions of lattice fields are provided in qdp_half.h
+ */
+class REAL16
+{
+public:
+  REAL16() {}
+  REAL16(float f) : bits(floatToBits(f)) {}
+
+  operator float() const {return bitsToFloat(bits);}
+
+  //! Raw IEEE 754 binary16 bit pattern
+  unsigned short bits;
+
+  //! Round-to-nearest-even conversion of a float to binary16 bits
+  static unsigned short floatToBits(float f)
+  {
+    union {float f; unsigned int u;} v;
+    v.f = f;
+    unsigned int sign = (v.u >> 16) & 0x8000u;
+    unsigned int absu = v.u & 0x7fffffffu;
+
+    if (absu >= 0x7f800000u)                 // Inf or NaN
+      return sign | (absu > 0x7f800000u ? 0x7e00u : 0x7c00u);
+
+    if (absu >= 0x477ff000u)                 // rounds to overflow
+      return sign | 0x7c00u;
+
+    if (absu < 0x38800000u)                  // subnormal or zero
+    {
+      if (absu < 0x33000000u)
+	return sign;
+      unsigned int e = absu >> 23;
+      unsigned int m = (absu & 0x007fffffu) | 0x00800000u;
+      unsigned int shift = 126 - e;
+      unsigned int h = m >> shift;
+      unsigned int rem = m & ((1u << shift) - 1);
+      unsigned int half = 1u << (shift - 1);
+      if (rem > half || (rem == half && (h & 1u)))
+	++h;
+      return sign | h;
+    }
+
+    unsigned int h = (absu - 0x38000000u) >> 13;
+    unsigned int rem = absu & 0x1fffu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u)))
+      ++h;
+    return sign | h;
+  }
+
+  //! Exact conversion of binary16 bits to a float
+  static float bitsToFloat(unsigned short h)
+  {
+    union {float f; unsigned int u;} v;
+    unsigned int sign = (unsigned int)(h & 0x8000u) << 16;
+    unsigned int e = (h >> 10) & 0x1fu;
+    unsigned int m = h & 0x3ffu;
+
+    if (e == 0x1fu)                          // Inf or NaN
+      v.u = sign | 0x7f800000u | (m << 13);
+    else if (e != 0)                         // normal
+      v.u = sign | ((e + 112) << 23) | (m << 13);
+    else if (m == 0)                         // zero
+      v.u = sign;
+    else                                     // subnormal: renormalize
+    {
+      e = 113;
+      while ((m & 0x400u) == 0)
+      {
+	m <<= 1;
+	--e;
+      }
+      v.u = sign | (e << 23) | ((m & 0x3ffu) << 13);
+    }
+    return v.f;
+  }
+};
+
 // Set the base floating precision
 #if BASE_PRECISION == 32
 // Use single precision for base precision
 typedef REAL32    REAL;
 typedef REAL64    DOUBLE;
 
+} // namespace QDP 
+
 #define INNER_LOG 2
 
 #elif BASE_PRECISION == 64
@@ -15,9 +15,16 @@ typedef unsigned long  QDPTime_t;
 
 //! Get the wallclock time
 /*!
-  \return The wallclock time (since Epoch) in seconds.
+  \return The wallclock time (since Epoch) in microseconds.
 */
 QDPTime_t getClockTime();
+
+//! Get a monotonic clock
+/*!
+  \return Nanoseconds from an arbitrary origin; only differences are meaningful.
+*/
+QDPTime_t getClockTimeNs();
+
 void initProfile(const std::string& file, const std::string& caller, int line);
 void closeProfile();
 void printProfile();
@@ -28,17 +35,76 @@ int getProgramProfileLevel();
 void pushProfileInfo(int level, const std::string& file, const std::string& caller, int line);
 void popProfileInfo();
 
+//! Also write the final profile report to  prefix.json  and  prefix.csv
+void setProfileOutput(const std::string& prefix);
+
 
 //--------------------------------------------------------------------------------------
-// Selectively turn on profiling
+// Communication counters
+//
+// Messages of the shifts, global reductions and broadcasts are counted
+// when switched on with setCommProfile (or -pcomm on the command line, or
+// the QDP_COMM_PROFILE environment variable). Otherwise a communication
+// only pays for one test of the switch. Communications are issued by the
+// master thread, so the counters are not locked.
 //--------------------------------------------------------------------------------------
 
-#if ! defined(QDP_USE_PROFILING)   
-// No profiling
-#define QDP_PUSH_PROFILE(a)
-#define QDP_POP_PROFILE()
+//! Kinds of counted communications
+enum QDPCommKind_t {QDP_COMM_SHIFT, QDP_COMM_SUM, QDP_COMM_BROADCAST, QDP_COMM_SEND};
+
+//! Counters of one communication call site on this node
+struct QDPCommStat_t
+{
+  std::string    name;
+  QDPCommKind_t  kind;
+  double         count;     // messages
+  double         bytes;     // bytes sent by this node
+  double         pack_ns;   // gathering the data to send
+  double         wait_ns;   // from starting the message to its completion
+  double         unpack_ns; // scattering the received data
+
+  QDPCommStat_t() : kind(QDP_COMM_SHIFT), count(0), bytes(0), pack_ns(0), wait_ns(0), unpack_ns(0) {}
+};
+
+//! Switch the communication counters on or off, returns the old setting
+bool setCommProfile(bool on);
+bool getCommProfile();
+
+//! Counter index of a call site, registered under its name on first use
+int commProfileId(QDPCommKind_t kind, const std::string& name);
+
+//! Add one message to a call site
+void recordComm(int id, double bytes, QDPTime_t pack_ns, QDPTime_t wait_ns, QDPTime_t unpack_ns);
+
+//! Add one reduction or broadcast started at start
+/*! The call site is named by the operation and the size of its payload */
+void recordComm(QDPTime_t start, QDPCommKind_t kind, const char* op, const char* word, int len,
+		double bytes);
+
+//! Start time of a counted communication, 0 when the counters are off
+inline QDPTime_t commStartTime() {return getCommProfile() ? getClockTimeNs() : 0;}
 
-#else   // Profiling enabled
+//! The counters of this node
+std::vector<QDPCommStat_t> getCommStats();
+
+//! Zero the counters
+void resetCommStats();
+
+//! Print the counters summed over nodes. All nodes must call
+void printCommProfile();
+
+
+//! Print the allocator's use of memory at QDP_finalize
+/*! Also switched on with -pmem or the QDP_MEMORY_PROFILE environment variable */
+bool setMemoryProfile(bool on);
+bool getMemoryProfile();
+
+
+//--------------------------------------------------------------------------------------
+// Profiling is switched on at run time with setProfileLevel (or -p on the
+// command line, or the QDP_PROFILE environment variable). With level 0 an
+// evaluation only pays for one test of the level.
+//--------------------------------------------------------------------------------------
 
 #define QDP_PUSH_PROFILE(a) pushProfileInfo(a, __FILE__, __func__, __LINE__)
 #define QDP_POP_PROFILE()  popProfileInfo()
@@ -49,79 +115,110 @@ void popProfileInfo();
 // Support of printing
 //-----------------------------------------------------------------------------
 
+//! Estimated cost of one site of an evaluation
+struct QDPProfileCost_t
+{
+  double bytes;     // bytes read and written
+  double flops;     // floating point operations
+
+  QDPProfileCost_t() : bytes(0), flops(0) {}
+};
+
 struct QDPProfile_t;
-void registerProfile(QDPProfile_t* qp);
+void registerProfile(QDPProfile_t* qp, const std::string& expr, const QDPProfileCost_t& cost);
+void recordProfile(int id, QDPTime_t ns, int nsites);
 
 
-//! Profiling object
+//! Start time of one profiled evaluation
+/*! Zero when profiling is off, in which case nothing is recorded */
+struct QDPProfileTimer_t
+{
+  QDPTime_t  start;
+
+  QDPProfileTimer_t() : start((getProfileLevel() > 0) ? getClockTimeNs() : 0) {}
+};
+
+
+//! Profiling slot
 /*!
- * Hold profiling state
+ * There is one static slot per instantiation of an evaluation. The
+ * expression is printed and its cost estimated on the first call made
+ * while profiling is on. Timings are accumulated in per-thread counters
+ * kept under the expression string, so recording takes no lock.
  */
 struct QDPProfile_t
 {
-  QDPTime_t     time;
-  std::string   expr;
-  int           count;
-  QDPProfile_t* next;
+  int  id;      // counter index, -1 until registered
 
-  void print();
+  QDPProfile_t() : id(-1) {}
 
-  void init();
-  QDPProfile_t() {init();}
-
-  //! Profile rhs
+  //! Record  dest op rhs  over nsites sites
   template<class T, class C, class Op, class RHS, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+  void stop(const QDPProfileTimer_t& t, 
+	    const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs, int nsites)
     {
-      init();
+      if (t.start == 0)
+	return;
+
+      QDPTime_t ns = getClockTimeNs() - t.start;
 
-      if (getProfileLevel() > 0)
+      if (id < 0)
       {
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, rhs);
-	expr = os.str();
-	registerProfile(this);
+	registerProfile(this, os.str(), profileCost(dest, op, rhs));
       }
+      recordProfile(id, ns, nsites);
     }
 
-  //! Profile  opOuter(rhs)
+  //! Record  dest op opOuter(rhs)  over nsites sites
   template<class T, class C, class Op, class OpOuter, class RHS, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs)
+  void stop(const QDPProfileTimer_t& t, 
+	    const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs,
+	    int nsites)
     {
-      init();
+      if (t.start == 0)
+	return;
 
-      if (getProfileLevel() > 0)
+      QDPTime_t ns = getClockTimeNs() - t.start;
+
+      if (id < 0)
       {
 	typedef UnaryNode<OpOuter, typename CreateLeaf<QDPExpr<RHS,C1> >::Leaf_t> Tree_t;
 	typedef typename UnaryReturn<C1,OpOuter>::Type_t Container_t;
 
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, 
 		      MakeReturn<Tree_t,Container_t>::make(Tree_t(
 			CreateLeaf<QDPExpr<RHS,C1> >::make(rhs))));
-	expr = os.str();
-	registerProfile(this);
+	registerProfile(this, os.str(), profileCost(dest, op, opOuter, rhs));
       }
+      recordProfile(id, ns, nsites);
     }
 
-  //! Profile  opOuter(rhs)
+  //! Record  dest op opOuter(rhs)  over nsites sites
   template<class T, class C, class Op, class OpOuter, class T1, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPType<T1,C1>& rhs)
+  void stop(const QDPProfileTimer_t& t, 
+	    const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPType<T1,C1>& rhs,
+	    int nsites)
     {
-      init();
+      if (t.start == 0)
+	return;
+
+      QDPTime_t ns = getClockTimeNs() - t.start;
 
-      if (getProfileLevel() > 0)
+      if (id < 0)
       {
 	typedef UnaryNode<OpOuter, typename CreateLeaf<QDPType<T1,C1> >::Leaf_t> Tree_t;
 	typedef typename UnaryReturn<C1,OpOuter>::Type_t Container_t;
 
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, 
 		      MakeReturn<Tree_t,Container_t>::make(Tree_t(
 			CreateLeaf<QDPType<T1,C1> >::make(rhs))));
-	expr = os.str();
-	registerProfile(this);
+	registerProfile(this, os.str(), profileCost(dest, op, opOuter, rhs));
       }
+      recordProfile(id, ns, nsites);
     }
 };
 
@@ -143,17 +240,216 @@ struct QDPProfileInfo_t
 };
 
 
-struct QDPProfileHead_t
+
+//-----------------------------------------------------------------------------
+// Cost estimates
+//-----------------------------------------------------------------------------
+
+//! Number of real words in a site object
+/*! Objects that are not fields (gamma matrices, plain numbers) count one */
+template<class T> struct ProfileWords {enum {value = 1};};
+
+template<class T> struct ProfileWords<RScalar<T> > {enum {value = ProfileWords<T>::value};};
+template<class T> struct ProfileWords<RComplex<T> > {enum {value = 2*ProfileWords<T>::value};};
+template<class T> struct ProfileWords<IScalar<T> > {enum {value = ProfileWords<T>::value};};
+template<class T, int N> struct ProfileWords<ILattice<T,N> > {enum {value = N*ProfileWords<T>::value};};
+template<class T> struct ProfileWords<PScalar<T> > {enum {value = ProfileWords<T>::value};};
+template<class T> struct ProfileWords<PSeed<T> > {enum {value = 4*ProfileWords<T>::value};};
+template<class T, int N> struct ProfileWords<PColorVector<T,N> > {enum {value = N*ProfileWords<T>::value};};
+template<class T, int N> struct ProfileWords<PSpinVector<T,N> > {enum {value = N*ProfileWords<T>::value};};
+template<class T, int N> struct ProfileWords<PColorMatrix<T,N> > {enum {value = N*N*ProfileWords<T>::value};};
+template<class T, int N> struct ProfileWords<PSpinMatrix<T,N> > {enum {value = N*N*ProfileWords<T>::value};};
+
+//! Length of the sums in a product with a T on the left
+template<class T> struct ProfileInner {enum {value = 1};};
+
+template<class T> struct ProfileInner<PScalar<T> > {enum {value = ProfileInner<T>::value};};
+template<class T, int N> struct ProfileInner<PColorVector<T,N> > {enum {value = ProfileInner<T>::value};};
+template<class T, int N> struct ProfileInner<PSpinVector<T,N> > {enum {value = ProfileInner<T>::value};};
+template<class T, int N> struct ProfileInner<PColorMatrix<T,N> > {enum {value = N*ProfileInner<T>::value};};
+template<class T, int N> struct ProfileInner<PSpinMatrix<T,N> > {enum {value = N*ProfileInner<T>::value};};
+
+//! How an operation is counted
+/*!
+ * 0: data movement only, 1: one flop per real word of the result,
+ * 2: product, 3: contraction to a number
+ */
+template<class Op> struct ProfileOpKind {enum {value = 1};};
+
+template<> struct ProfileOpKind<OpIdentity> {enum {value = 0};};
+template<> struct ProfileOpKind<OpUnaryPlus> {enum {value = 0};};
+template<> struct ProfileOpKind<FnMap> {enum {value = 0};};
+template<> struct ProfileOpKind<FnAdjoint> {enum {value = 0};};
+template<> struct ProfileOpKind<FnConjugate> {enum {value = 0};};
+template<> struct ProfileOpKind<FnTranspose> {enum {value = 0};};
+template<> struct ProfileOpKind<OpMultiply> {enum {value = 2};};
+template<> struct ProfileOpKind<OpAdjMultiply> {enum {value = 2};};
+template<> struct ProfileOpKind<OpMultiplyAdj> {enum {value = 2};};
+template<> struct ProfileOpKind<OpAdjMultiplyAdj> {enum {value = 2};};
+template<> struct ProfileOpKind<FnLocalNorm2> {enum {value = 3};};
+template<> struct ProfileOpKind<FnNorm2> {enum {value = 3};};
+template<> struct ProfileOpKind<FnLocalInnerProduct> {enum {value = 3};};
+template<> struct ProfileOpKind<FnInnerProduct> {enum {value = 3};};
+template<> struct ProfileOpKind<FnLocalInnerProductReal> {enum {value = 3};};
+template<> struct ProfileOpKind<FnInnerProductReal> {enum {value = 3};};
+
+//! Flops per site of  Op(A,...)  giving an R
+template<class Op, class A, class R>
+inline double profileOpFlops()
 {
-  QDPProfileInfo_t  info;
-  QDPProfile_t*     start;
-  QDPProfile_t*     end;
+  switch (int(ProfileOpKind<Op>::value))
+  {
+  case 0:
+    return 0;
+  case 2:
+    // a complex multiply-add per inner term, scaling when A is a number
+    return (ProfileWords<A>::value <= 1) ? double(ProfileWords<R>::value) :
+      double(ProfileWords<R>::value) * (4*ProfileInner<A>::value - 1);
+  case 3:
+    return 2.0 * ProfileWords<A>::value;
+  default:
+    return ProfileWords<R>::value;
+  }
+}
+
 
-  QDPProfileHead_t() {start=0; end=0;}
-  QDPProfileHead_t(const QDPProfileInfo_t& a) : info(a), start(0), end(0) {}
-  QDPProfileHead_t(const QDPProfileHead_t& a) : info(a.info), start(a.start), end(a.end) {}
+//! Leaf and combine tag for the cost of an expression
+struct ProfileCostLeaf {};
+
+//! Cost of a subtree whose site value is a T
+template<class T>
+struct ProfileCost
+{
+  double bytes;
+  double flops;
+
+  ProfileCost(double b = 0, double f = 0) : bytes(b), flops(f) {}
 };
 
+//! Site type of a leaf
+template<class T> struct ProfileSite {typedef T Type_t;};
+template<class T> struct ProfileSite<Reference<T> > {typedef T Type_t;};
+
+template<class T>
+struct LeafFunctor<T, ProfileCostLeaf>
+{
+  typedef typename ProfileSite<typename LeafFunctor<T,EvalLeaf1>::Type_t>::Type_t Site_t;
+  typedef ProfileCost<Site_t> Type_t;
+  inline static Type_t apply(const T &a, const ProfileCostLeaf &f)
+    {return Type_t();}
+};
+
+//! Fields are read once per site, scalars are broadcast
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, ProfileCostLeaf>
+{
+  typedef ProfileCost<T> Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const ProfileCostLeaf &f)
+    {return Type_t(sizeof(T));}
+};
+
+template<class T>
+struct LeafFunctor<QDPType<T,OScalar<T> >, ProfileCostLeaf>
+{
+  typedef ProfileCost<T> Type_t;
+  inline static Type_t apply(const QDPType<T,OScalar<T> > &a, const ProfileCostLeaf &f)
+    {return Type_t();}
+};
+
+template<class A, class Op>
+struct Combine1<ProfileCost<A>, Op, ProfileCostLeaf>
+{
+  typedef typename UnaryReturn<A, Op>::Type_t R_t;
+  typedef ProfileCost<R_t> Type_t;
+  inline static
+  Type_t combine(const ProfileCost<A>& a, const Op&, const ProfileCostLeaf&)
+    {return Type_t(a.bytes, a.flops + profileOpFlops<Op,A,R_t>());}
+};
+
+template<class A, class B, class Op>
+struct Combine2<ProfileCost<A>, ProfileCost<B>, Op, ProfileCostLeaf>
+{
+  typedef typename BinaryReturn<A, B, Op>::Type_t R_t;
+  typedef ProfileCost<R_t> Type_t;
+  inline static
+  Type_t combine(const ProfileCost<A>& a, const ProfileCost<B>& b, const Op&, const ProfileCostLeaf&)
+    {return Type_t(a.bytes + b.bytes, a.flops + b.flops + profileOpFlops<Op,A,R_t>());}
+};
+
+template<class A, class B, class C, class Op>
+struct Combine3<ProfileCost<A>, ProfileCost<B>, ProfileCost<C>, Op, ProfileCostLeaf>
+{
+  typedef typename TrinaryReturn<A, B, C, Op>::Type_t R_t;
+  typedef ProfileCost<R_t> Type_t;
+  inline static
+  Type_t combine(const ProfileCost<A>& a, const ProfileCost<B>& b, const ProfileCost<C>& c,
+		 const Op&, const ProfileCostLeaf&)
+    {return Type_t(a.bytes + b.bytes + c.bytes, 
+		   a.flops + b.flops + c.flops + ProfileWords<R_t>::value);}
+};
+
+//! Plain assignment does not read the destination
+template<class Op> struct ProfileIsAssign {enum {value = 0};};
+template<> struct ProfileIsAssign<OpAssign> {enum {value = 1};};
+
+//! Destination bytes per site; accumulations also read it and add
+template<class T, class C>
+struct ProfileDest
+{
+  template<class Op>
+  static void add(QDPProfileCost_t& c, const Op&)
+    {
+      c.bytes += sizeof(T);
+      if (! ProfileIsAssign<Op>::value)
+      {
+	c.bytes += sizeof(T);
+	c.flops += ProfileWords<T>::value;
+      }
+    }
+};
+
+template<class T>
+struct ProfileDest<T, OScalar<T> >
+{
+  template<class Op>
+  static void add(QDPProfileCost_t& c, const Op&) {}
+};
+
+//! Flops per site of a reduction over a subtree giving an A
+template<class OpOuter, class A>
+inline double profileOuterFlops(const OpOuter&, const ProfileCost<A>&)
+{
+  return (ProfileOpKind<OpOuter>::value == 3) ? 2.0*ProfileWords<A>::value : double(ProfileWords<A>::value);
+}
+
+//! Estimated cost per site of  dest op rhs
+template<class T, class C, class Op, class RHS, class C1>
+QDPProfileCost_t profileCost(const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+{
+  typename ForEach<QDPExpr<RHS,C1>, ProfileCostLeaf, ProfileCostLeaf>::Type_t e =
+    forEach(rhs, ProfileCostLeaf(), ProfileCostLeaf());
+
+  QDPProfileCost_t c;
+  c.bytes = e.bytes;
+  c.flops = e.flops;
+  ProfileDest<T,C>::add(c, op);
+  return c;
+}
+
+//! Estimated cost per site of  dest op opOuter(rhs)
+/*! The outer operation is a reduction whose destination is a scalar */
+template<class T, class C, class Op, class OpOuter, class RHS>
+QDPProfileCost_t profileCost(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const RHS& rhs)
+{
+  typedef typename ForEach<RHS, ProfileCostLeaf, ProfileCostLeaf>::Type_t E_t;
+  E_t e = forEach(rhs, ProfileCostLeaf(), ProfileCostLeaf());
+
+  QDPProfileCost_t c;
+  c.bytes = e.bytes;
+  c.flops = e.flops + profileOuterFlops(opOuter, e);
+  return c;
+}
+
 
 
 //! Print an expression tree
@@ -163,12 +459,9 @@ struct QDPProfileHead_t
  */
 template<class T, class C, class Op, class RHS, class C1>
 //inline
-void printExprTree(ostream& os, 
+void printExprTree(std::ostream& os, 
 		   const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
 {
-  typedef EvalLeaf1    FTag_t;
-  typedef OpCombine    CTag_t;
-  typedef NullCombine  VTag_t;
   typedef QDPExpr<RHS,C1>  Expr;
     
   typedef typename CreateLeaf<Expr>::Leaf_t Expr_t;
@@ -201,8 +494,37 @@ void printExprTree(ostream& os,
 
 struct PrintTag
 {
-  mutable ostream &os_m;
-  PrintTag(ostream &os) : os_m(os) {}
+  std::ostream &os_m;
+  PrintTag(std::ostream &os) : os_m(os) {}
+};
+
+
+//
+// struct LeafFunctor<T, PrintTag>
+//
+// Leaves without a printer of their own. Every expression is printed
+// once profiling is on, so this must not fail to compile.
+//
+
+template<class T>
+struct LeafFunctor<T, PrintTag>
+{
+  typedef int Type_t;
+  static int apply(const T &s, const PrintTag &f)
+    { 
+      f.os_m << "leaf"; 
+      return 0;
+    }
+};
+
+template<class T>
+struct LeafFunctor<Scalar<T>, PrintTag>
+{
+  typedef int Type_t;
+  static int apply(const Scalar<T> &s, const PrintTag &f)
+    { 
+      return LeafFunctor<T,PrintTag>::apply(s.value(),f);
+    }
 };
 
 
@@ -1411,8 +1733,6 @@ struct TagVisitor<FnTraceSpinQuarkContract13, PrintTag> : public ParenPrinter<Fn
     { t.os_m << "traceSpinQuarkContract13"; }
 };
 
-#endif  // ! defined(QDP_USE_PROFILING)
-
 } // namespace QDP
 
 #endif  // QDP_PROFILE_INCLUDE
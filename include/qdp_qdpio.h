@@ -44,6 +44,14 @@ namespace QDP
     QDPIO_APPEND,
   };
 
+  //! Precision of lattice data in a file
+  enum QDP_precision_t
+  {
+    QDPIO_PREC_NATIVE,   // as in memory
+    QDPIO_PREC_SINGLE,
+    QDPIO_PREC_DOUBLE
+  };
+
   //! QDPIO state
   enum QDP_iostate_t
   {
@@ -490,6 +498,16 @@ namespace QDP
     template<class T>
     void write(XMLBufferWriter& xml, const OLattice<T>& s1);
 
+    //! Writes an OLattice object in a given precision
+    /*!
+      The sites are converted as QIO asks for them, without a temporary lattice.
+      \param xml The user record metadata.
+      \param sl The data
+      \param prec The precision in the file
+    */
+    template<class T>
+    void write(XMLBufferWriter& xml, const OLattice<T>& s1, QDP_precision_t prec);
+
     //! Writes a hypercube from an OLattice object
     /*!
       \param xml The user record metadata.
@@ -518,6 +536,16 @@ namespace QDP
     template<class T>
     void write(XMLBufferWriter& xml, const multi1d< OLattice<T> >& s1);
 
+    //! Writes an array of objects all to a single record in a given precision
+    /*!
+      The sites are converted as QIO asks for them, without temporary lattices.
+      \param xml The user record metadata.
+      \param sl The data
+      \param prec The precision in the file
+    */
+    template<class T>
+    void write(XMLBufferWriter& xml, const multi1d< OLattice<T> >& s1, QDP_precision_t prec);
+
 
     //! Writes a hypercube of an array of objects all to a single record
     /*!
@@ -554,6 +582,14 @@ namespace QDP
   protected:
     QIO_Writer *get() const {return qio_out;}
 
+    //! Writes an OLattice object with sites of type D in the file
+    template<class T, class D>
+    void writeAs(XMLBufferWriter& xml, const OLattice<T>& s1);
+
+    //! Writes an array of OLattice objects with sites of type D in the file
+    template<class T, class D>
+    void writeAs(XMLBufferWriter& xml, const multi1d< OLattice<T> >& s1);
+
   private:
     QDP_iostate_t iostate;
     bool iop;
@@ -1055,6 +1091,100 @@ namespace QDP
   }
 
 
+  //! Copy words with a change of precision
+  /*!
+    The QIO site buffers are plain char arrays with no alignment
+    guarantee, so the buffer side is accessed a word at a time through
+    memcpy. The compiler turns that into unaligned loads and stores and
+    still vectorizes the loop. Words of the same type are just copied.
+  */
+  template<class S, class D>
+  struct QDPConvertWords
+  {
+    //! Convert n words from the buffer src
+    static void fromBuffer(const char* src, D* dest, size_t n)
+    {
+      for(size_t i=0; i < n; ++i)
+      {
+	S s;
+	memcpy(&s, src + i*sizeof(S), sizeof(S));
+	dest[i] = D(s);
+      }
+    }
+
+    //! Convert n words into the buffer dest
+    static void toBuffer(const S* src, char* dest, size_t n)
+    {
+      for(size_t i=0; i < n; ++i)
+      {
+	D d = D(src[i]);
+	memcpy(dest + i*sizeof(D), &d, sizeof(D));
+      }
+    }
+  };
+
+  template<class S>
+  struct QDPConvertWords<S,S>
+  {
+    static void fromBuffer(const char* src, S* dest, size_t n)
+    {
+      memcpy(dest, src, n*sizeof(S));
+    }
+
+    static void toBuffer(const S* src, char* dest, size_t n)
+    {
+      memcpy(dest, src, n*sizeof(S));
+    }
+  };
+
+  //! Function for moving data with a change of precision
+  /*!
+    Data of type D is moved from the buffer into the lattice of type T
+    with a specified offset, converting each word.
+
+    \param buf The source buffer
+    \param linear The destination buffer offset
+    \param count The number of data to move
+    \param arg The destination buffer.
+  */
+  template<class T, class D> void QDPOLatticeFactoryPutConvert(char *buf, size_t linear, int count, void *arg)
+  {
+    typedef typename WordType<T>::Type_t WT;
+    typedef typename WordType<D>::Type_t WD;
+
+    /* Translate arg */
+    T *field = (T *)arg;
+
+    QDPConvertWords<WD,WT>::fromBuffer(buf, (WT*)(field+linear), 
+				       count*(sizeof(D)/sizeof(WD)));
+  }
+
+  //! Function for moving array data with a change of precision
+  /*!
+    The data is taken to be in multi1d< OLattice<T> > form.
+
+    \param buf The source buffer
+    \param linear The destination buffer offset
+    \param count Ignored
+    \param arg The destination buffer.
+  */
+  template<class T, class D> void QDPOLatticeFactoryPutArrayConvert(char *buf, size_t linear, int count, void *arg)
+  {
+    typedef typename WordType<T>::Type_t WT;
+    typedef typename WordType<D>::Type_t WD;
+
+    /* Translate arg */
+    multi1d< OLattice<T> >& field = *(multi1d< OLattice<T> > *)arg;
+
+    for(int i=0; i < field.size(); ++i)
+    {
+      QDPConvertWords<WD,WT>::fromBuffer(buf, (WT*)&(field[i].elem(linear)), 
+					 sizeof(D)/sizeof(WD));
+      buf += sizeof(D);
+    }
+  }
+
+
   //! Reads an OLattice object
   /*!
     This implementation is only correct for scalar ILattice.
@@ -1081,15 +1211,13 @@ namespace QDP
     case 'F' :
     {
       QDPIO::cout << "Single Precision Read" << std::endl;
-      OLattice< typename SinglePrecType<T>::Type_t > from_disk;
-      zero_rep(from_disk);
 
-      
+      // Convert each site as it arrives
       status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPut<typename SinglePrecType<T>::Type_t> ),
+				    &(QDPOLatticeFactoryPutConvert<T, typename SinglePrecType<T>::Type_t> ),
 				    sizeof(typename SinglePrecType<T>::Type_t),
 				    sizeof(typename WordType< typename SinglePrecType<T>::Type_t >::Type_t),
-				    (void *)from_disk.getF());
+				    (void *)s1.getF());
       
       if (status != QIO_SUCCESS) { 
 	QDPIO::cerr << "Failed to read data" << std::endl;
@@ -1097,21 +1225,18 @@ namespace QDP
 	QDP_abort(1);
       }
       QDPIO::cout << "QIO_read_finished" << std::endl;
-      s1 = from_disk; // Cast
     }
     break;
     case 'D' :
     {
       QDPIO::cout << "Reading Double Precision" << std::endl;
-      OLattice< typename DoublePrecType<T>::Type_t > from_disk;
-      zero_rep(from_disk);
 
-      /* Disagnostics */
+      // Convert each site as it arrives
       status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPut< typename DoublePrecType<T>::Type_t>),
+				    &(QDPOLatticeFactoryPutConvert<T, typename DoublePrecType<T>::Type_t>),
 				    sizeof(typename DoublePrecType<T>::Type_t),
 				    sizeof(typename WordType< typename DoublePrecType<T>::Type_t >::Type_t),
-				    (void *)from_disk.getF());
+				    (void *)s1.getF());
       
       if (status != QIO_SUCCESS) { 
 	QDPIO::cerr << "Failed to read data" << std::endl;
@@ -1119,10 +1244,6 @@ namespace QDP
 	QDP_abort(1);
       }
       QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      s1= from_disk;
-	
     }
     break;
     default:
@@ -1181,50 +1302,37 @@ namespace QDP
     case 'F' :
     {
       QDPIO::cout << "Single Precision Read" << std::endl;
-      multi1d< OLattice< typename SinglePrecType<T>::Type_t > > from_disk(s1.size());
-      for(int i=0; i < s1.size(); i++) { zero_rep(from_disk[i]); }
 
+      // Convert each site as it arrives
       status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPutArray<typename SinglePrecType<T>::Type_t> ),
+				    &(QDPOLatticeFactoryPutArrayConvert<T, typename SinglePrecType<T>::Type_t> ),
 				    s1.size()*sizeof(typename SinglePrecType<T>::Type_t),
 				    sizeof(typename WordType< typename SinglePrecType<T>::Type_t >::Type_t),
-				    (void *)&from_disk);
+				    (void *)&s1);
       if (status != QIO_SUCCESS) { 
 	QDPIO::cerr << "Failed to read data" << std::endl;
 	clear(QDPIO_badbit);
 	QDP_abort(1);
       }
       QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      for(int i=0; i < from_disk.size(); i++) { 
-	s1[i] = from_disk[i];
-      }
-      
     }
     break;
     case 'D' :
     {
       QDPIO::cout << "Reading Double Precision" << std::endl;
-      multi1d< typename DoublePrecType< OLattice<T> >::Type_t > from_disk(s1.size());
-      for(int i=0; i < s1.size(); i++) { zero_rep(from_disk[i]); }
 
+      // Convert each site as it arrives
       status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPutArray< typename DoublePrecType<T>::Type_t > ),
+				    &(QDPOLatticeFactoryPutArrayConvert<T, typename DoublePrecType<T>::Type_t > ),
 				    s1.size()*sizeof(typename DoublePrecType<T>::Type_t),
 				    sizeof(typename WordType< typename DoublePrecType<T>::Type_t >::Type_t),
-				    (void *)&from_disk);
+				    (void *)&s1);
       if (status != QIO_SUCCESS) { 
 	QDPIO::cerr << "Failed to read data" << std::endl;
 	clear(QDPIO_badbit);
 	QDP_abort(1);
       }
       QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      for(int i=0; i < from_disk.size(); i++) { 
-	s1[i] = from_disk[i];
-      }
     }
     break;
     default:
@@ -1305,6 +1413,55 @@ namespace QDP
 
 
 
+  //! Function for moving data with a change of precision
+  /*!
+    Data of type T is moved from the lattice into the buffer of type D
+    with a specified offset, converting each word.
+
+    \param buf The destination buffer
+    \param linear The source buffer offset
+    \param count The number of data to move
+    \param arg The source buffer.
+  */
+  template<class T, class D> void QDPOLatticeFactoryGetConvert(char *buf, size_t linear, int count, void *arg)
+  {
+    typedef typename WordType<T>::Type_t WT;
+    typedef typename WordType<D>::Type_t WD;
+
+    /* Translate arg */
+    T *field = (T *)arg;
+
+    QDPConvertWords<WT,WD>::toBuffer((const WT*)(field+linear), buf, 
+				     count*(sizeof(T)/sizeof(WT)));
+  }
+
+  //! Function for moving array data with a change of precision
+  /*!
+    The data is taken to be in multi1d< OLattice<T> > form.
+
+    \param buf The destination buffer
+    \param linear The source buffer offset
+    \param count Ignored
+    \param arg The source buffer.
+  */
+  template<class T, class D> void QDPOLatticeFactoryGetArrayConvert(char *buf, size_t linear, int count, void *arg)
+  {
+    typedef typename WordType<T>::Type_t WT;
+    typedef typename WordType<D>::Type_t WD;
+
+    /* Translate arg */
+    multi1d< OLattice<T> >& field = *(multi1d< OLattice<T> > *)arg;
+
+    for(int i=0; i < field.size(); ++i)
+    {
+      QDPConvertWords<WT,WD>::toBuffer((const WT*)&(field[i].elem(linear)), buf, 
+				       sizeof(T)/sizeof(WT));
+      buf += sizeof(D);
+    }
+  }
+
+
+
   //! Writes an OLattice object
   /*!
     This implementation is only correct for scalar ILattice.
@@ -1507,6 +1664,131 @@ namespace QDP
     QIO_destroy_record_info(info);
   }
 
+
+  //! Writes an OLattice object in a given precision
+  template<class T>
+  void QDPFileWriter::write(XMLBufferWriter& rec_xml, const OLattice<T>& s1, QDP_precision_t prec)
+  {
+    switch (prec) {
+    case QDPIO_PREC_SINGLE:
+      writeAs<T, typename SinglePrecType<T>::Type_t>(rec_xml, s1);
+      break;
+    case QDPIO_PREC_DOUBLE:
+      writeAs<T, typename DoublePrecType<T>::Type_t>(rec_xml, s1);
+      break;
+    default:
+      write(rec_xml, s1);
+      break;
+    }
+  }
+
+
+  //! Writes an array of OLattice objects in a given precision
+  template<class T>
+  void QDPFileWriter::write(XMLBufferWriter& rec_xml, const multi1d< OLattice<T> >& s1, QDP_precision_t prec)
+  {
+    switch (prec) {
+    case QDPIO_PREC_SINGLE:
+      writeAs<T, typename SinglePrecType<T>::Type_t>(rec_xml, s1);
+      break;
+    case QDPIO_PREC_DOUBLE:
+      writeAs<T, typename DoublePrecType<T>::Type_t>(rec_xml, s1);
+      break;
+    default:
+      write(rec_xml, s1);
+      break;
+    }
+  }
+
+
+  //! Writes an OLattice object with sites of type D in the file
+  /*!
+    This implementation is only correct for scalar ILattice.
+
+    \param rec_xml The user record metadata.
+    \param sl The data
+  */
+  template<class T, class D>
+  void QDPFileWriter::writeAs(XMLBufferWriter& rec_xml, const OLattice<T>& s1)
+  {
+    QIO_RecordInfo* info = QIO_create_record_info(QIO_FIELD, NULL, NULL,0,
+						  QIOStringTraits< OLattice<D> >::tname,
+						  QIOStringTraits<typename WordType<D>::Type_t >::tprec,
+						  Nc, Ns, 
+						  sizeof(D),1 );
+  
+    // Copy metadata string into simple qio string container
+    QIO_String* xml_c = QIO_string_create();
+    if (Layout::primaryNode())
+      QIO_string_set(xml_c, rec_xml.str().c_str());
+
+    if (xml_c == NULL)
+    {
+      QDPIO::cerr << "QDPFileWriter::write - error in creating XML string" << std::endl;
+      QDP_abort(1);
+    }
+
+    // Big call to qio. Each site is converted as it is gathered
+    if (QIO_write(get(), info, xml_c,
+		  &(QDPOLatticeFactoryGetConvert<T,D>),
+		  sizeof(D), 
+		  sizeof(typename WordType<D>::Type_t), 
+		  (void *)s1.getF()) != QIO_SUCCESS)
+    {
+      QDPIO::cerr << "QDPFileWriter: error in write" << std::endl;
+      clear(QDPIO_badbit);
+    }
+
+    // Cleanup
+    QIO_string_destroy(xml_c);
+    QIO_destroy_record_info(info);
+  }
+
+
+  //! Writes an array of OLattice objects with sites of type D in the file
+  /*!
+    This implementation is only correct for scalar ILattice.
+
+    \param rec_xml The (user) record metadata.
+    \param sl The data
+  */
+  template<class T, class D>
+  void QDPFileWriter::writeAs(XMLBufferWriter& rec_xml, const multi1d< OLattice<T> >& s1)
+  {
+    QIO_RecordInfo* info = QIO_create_record_info(QIO_FIELD, 
+						  NULL, NULL, 0,
+						  QIOStringTraits<multi1d< OLattice<D> > >::tname,
+						  QIOStringTraits<typename WordType<D>::Type_t>::tprec,
+						  Nc, Ns, 
+						  sizeof(D), s1.size() );
+
+    // Copy metadata string into simple qio string container
+    QIO_String* xml_c = QIO_string_create();
+    if (Layout::primaryNode())
+      QIO_string_set(xml_c, rec_xml.str().c_str());
+
+    if (xml_c == NULL)
+    {
+      QDPIO::cerr << "QDPFileWriter::write - error in creating XML string" << std::endl;
+      QDP_abort(1);
+    }
+
+    // Big call to qio. Each site is converted as it is gathered
+    if (QIO_write(get(), info, xml_c,
+		  &(QDPOLatticeFactoryGetArrayConvert<T,D>),
+		  s1.size()*sizeof(D), 
+		  sizeof(typename WordType<D>::Type_t), 
+		  (void*)&s1) != QIO_SUCCESS)
+    {
+      QDPIO::cerr << "QDPFileWriter: error in write" << std::endl;
+      clear(QDPIO_badbit);
+    }
+
+    // Cleanup
+    QIO_string_destroy(xml_c);
+    QIO_destroy_record_info(info);
+  }
+
   /*! @} */   // end of group qio
 } // namespace QDP
 
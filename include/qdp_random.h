@@ -29,7 +29,8 @@ namespace RNG
 
   //! Initialize the RNG seed
   /*!
-   * Seeds are big-ints
+   * Seeds are big-ints. The counter of the counter based generator
+   * restarts at zero.
    */
   void setrn(const Seed& lseed);
 
@@ -46,6 +47,120 @@ namespace RNG
 
   //! Internal seed multiplier
   void sranf(float* d, int N, Seed& seed, ILatticeSeed&, const Seed&);
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  //! A seed packed into one 64 bit word (47 significant bits)
+  typedef unsigned long long RanWord;
+
+  //! Pack a seed into a word
+  RanWord seedToWord(const Seed& seed);
+
+  //! Unpack a word into a seed
+  void wordToSeed(Seed& seed, RanWord w);
+
+  //! Powers mult^k mod 2^47 for k = 0 .. n-1
+  void ranPowers(RanWord* pw, int n, RanWord mult);
+
+  //! Uniforms of the stream starting at a skewed seed
+  /*!
+   * u[k] is the number sranf() would return after k steps of seed_mult,
+   * given pw[k] = seed_mult^k. The steps are independent so the loop
+   * vectorizes over k.
+   */
+  void fillUniforms(float* u, int n, RanWord skewed_seed, const RanWord* pw);
+
+  //! The site multipliers of lattice_ran_mult in word form
+  extern RanWord *lattice_ran_mult_word;
+
+
+  //! Lattice random number generators
+  enum RNGType
+  {
+    RNG_LCG,       /*!< Linear congruential with skewed site multipliers (default) */
+    RNG_PHILOX     /*!< Counter based Philox-4x32-10 */
+  };
+
+  //! Select the generator used by random() and gaussian()
+  /*!
+   * The Philox generator is keyed on (seed, global site, counter). It keeps
+   * no per-site state and its numbers do not depend on the node layout.
+   * Selecting it before Layout::create() skips building the site
+   * multipliers of the LCG altogether.
+   */
+  void setRNGType(RNGType type);
+
+  //! The generator used by random() and gaussian()
+  RNGType getRNGType();
+
+  //! Full state of the counter based generator
+  struct CounterSeed
+  {
+    Seed     key;        // the seed given to setrn
+    RanWord  counter;    // number of fills done since then
+  };
+
+  //! Set the key and counter of the counter based generator
+  void setrn(const CounterSeed& lseed);
+
+  //! Recover the key and counter of the counter based generator
+  void savern(CounterSeed& lseed);
+
+  //! Stream counter of the counter based generator
+  extern RanWord ran_counter;
+
+  //! Global lexicographic index of a site on this node
+  RanWord globalSiteIndex(int linear);
+
+  //! Uniforms of the counter based generator at one global site
+  /*!
+   * n numbers in (0,1) from Philox applied to the counter
+   * (block, site, counter) under the key
+   */
+  void fillCounterUniforms(float* u, int n, RanWord key, RanWord site, RanWord counter);
+#endif
+}
+
+
+//! Counts the words a fill_random call consumes
+struct RNGWordCount
+{
+  RNGWordCount() : n(0) {}
+  int n;
+};
+
+//! Hands out precomputed uniforms to fill_random
+struct RNGUniformStream
+{
+  RNGUniformStream(const float* u_) : u(u_) {}
+  const float* u;
+};
+
+//! dest  = random
+inline void
+fill_random(float& d, RNGWordCount& seed, RNGWordCount& skewed_seed, const RNGWordCount& seed_mult)
+{
+  ++seed.n;
+}
+
+//! dest  = random
+inline void
+fill_random(double& d, RNGWordCount& seed, RNGWordCount& skewed_seed, const RNGWordCount& seed_mult)
+{
+  ++seed.n;
+}
+
+//! dest  = random
+inline void
+fill_random(float& d, RNGUniformStream& seed, RNGUniformStream& skewed_seed, const RNGUniformStream& seed_mult)
+{
+  d = *seed.u++;
+}
+
+//! dest  = random
+inline void
+fill_random(double& d, RNGUniformStream& seed, RNGUniformStream& skewed_seed, const RNGUniformStream& seed_mult)
+{
+  d = double(*seed.u++);
 }
 
 //! dest  = random
@@ -388,6 +388,56 @@ private:
 } QDP_ALIGN8;   // possibly force alignment
 
 
+//! Reality complex of half precision storage words
+/*! Not padded to 8 bytes so a REAL16 field takes half the space of a
+ *  REAL32 one. Only the copy interface is provided: convert to single
+ *  precision for arithmetic */
+template<> class RComplex<REAL16>
+{
+public:
+  RComplex() {}
+  ~RComplex() {}
+
+  //! Construct from two scalars
+  template<class T1, class T2>
+  RComplex(const T1& _re, const T2& _im): re(_re), im(_im) {}
+
+  //! RComplex = RScalar
+  template<class T1>
+  inline
+  RComplex& operator=(const RScalar<T1>& rhs)
+    {
+      real() = rhs.elem();
+      imag() = 0.0f;
+      return *this;
+    }
+
+  //! RComplex = RComplex
+  template<class T1>
+  inline
+  RComplex& operator=(const RComplex<T1>& rhs)
+    {
+      real() = rhs.real();
+      imag() = rhs.imag();
+      return *this;
+    }
+
+  //! Deep copy constructor
+  RComplex(const RComplex& a): re(a.re), im(a.im) {}
+
+public:
+  REAL16& real() {return re;}
+  const REAL16& real() const {return re;}
+
+  REAL16& imag() {return im;}
+  const REAL16& imag() const {return im;}
+
+private:
+  REAL16 re;
+  REAL16 im;
+};
+
+
 //! Stream output
 template<class T>
 inline
@@ -139,6 +139,34 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
    }
 }
 
+//! user function for the evaluate functions over a range of sites
+// "OLattice Op Scalar(Expression(source)) under an Subset"
+//
+template<class T, class T1, class Op, class RHS>
+void ev_run_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
+{
+   OLattice<T>& dest = a->d;
+   const QDPExpr<RHS,OScalar<T1> >&rhs = a->r;
+   const Op& op= a->op;
+
+   for(int i=lo; i < hi; ++i)
+     op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
+}
+
+//! user function for the evaluate functions over a range of sites
+// "OLattice Op OLattice(Expression(source)) under an Subset"
+//
+template<class T, class T1, class Op, class RHS>
+void evaluate_run_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
+{
+   OLattice<T>& dest = a->d;
+   const QDPExpr<RHS,OLattice<T1> >&rhs = a->r;
+   const Op& op= a->op;
+
+   for(int i=lo; i < hi; ++i)
+     op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+}
+
 } // namespace QDP 
 
 //! include the header file for dispatch
@@ -159,16 +187,17 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 //  cerr << "In evaluateUnorderedSubet(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   int numSiteTable = s.numSiteTable();
   
   u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
 
-  dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
+  if (s.hasRunRep())
+    dispatch_to_runs< u_arg<T,T1,Op,RHS> >(s, a, ev_run_userfunc);
+  else
+    dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
  
   ///////////////////
   // Original code
@@ -182,11 +211,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
   //op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
   //}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -203,16 +228,29 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //  cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  // A shift reads other sites of its source, so a destination that
+  // is also shifted on the right hand side goes via a temporary
+  if (forEach(rhs, FnMapAliasLeaf(dest.getF()), OrCombine()))
+  {
+    // T1 is only the declared type, the temporary holds the evaluated sites
+    typedef typename DeReference<typename ForEach<RHS, EvalLeaf1, OpCombine>::Type_t>::Type_t Site_t;
+    OLattice<Site_t> tmp;
+    evaluate(tmp, OpAssign(), rhs, s);
+    evaluate(dest, op, PETE_identity(tmp), s);
+    return;
+  }
+
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   int numSiteTable = s.numSiteTable();
 
   user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
 
-  dispatch_to_threads<user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
+  if (s.hasRunRep())
+    dispatch_to_runs<user_arg<T,T1,Op,RHS> >(s, a, evaluate_run_userfunc);
+  else
+    dispatch_to_threads<user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
 
   ////////////////////
   // Original code
@@ -227,11 +265,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
   //op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
   //}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -244,11 +278,6 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
 {
   //cerr << "In evaluate_F(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
-
   // int numSiteTable = s.numSiteTable();
   // user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
   // dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
@@ -269,12 +298,6 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
     //fprintf(stderr,"eval(olattice,olattice): site %d\n",i);
     op( dest[j], forEach(rhs, EvalLeaf1(i), OpCombine()));
   }
-
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
 }
 
 
@@ -322,12 +345,35 @@ namespace RNG
 }
 
 
+//! Number of uniforms fill_random takes for one site of T
+template<class T>
+inline int randomWordsPerSite()
+{
+  RNGWordCount cnt;
+  T tmp;
+  fill_random(tmp, cnt, cnt, cnt);
+  return cnt.n;
+}
+
+
 //! dest  = random  
 /*! This implementation is correct for no inner grid */
 template<class T>
 void 
 random(OScalar<T>& d)
 {
+  if (RNG::getRNGType() == RNG::RNG_PHILOX)
+  {
+    // The scalar stream sits just past the last lattice site
+    const int nw = randomWordsPerSite<T>();
+    multi1d<float> u(nw);
+    RNG::fillCounterUniforms(&(u[0]), nw, RNG::seedToWord(RNG::ran_seed), Layout::vol(), RNG::ran_counter++);
+
+    RNGUniformStream st(&(u[0]));
+    fill_random(d.elem(), st, st, st);
+    return;
+  }
+
   Seed seed = RNG::ran_seed;
   Seed skewed_seed = RNG::ran_seed * RNG::ran_mult;
 
@@ -337,36 +383,100 @@ random(OScalar<T>& d)
 }
 
 
-//! dest  = random    under a subset
+//! Thread arguments for the lattice random fills
 template<class T>
-void 
-random(OLattice<T>& d, const Subset& s)
+struct RandomThreadArgs
+{
+  OLattice<T>& d;
+  const int* tab;
+  RNG::RanWord seed;          // global seed at entry, or the Philox key
+  const RNG::RanWord* pw;     // powers of ran_mult_n
+  int nw;                     // uniforms needed per site
+  RNG::RanWord counter;       // Philox stream counter
+  bool philox;                // use the counter based generator
+
+  RandomThreadArgs(OLattice<T>& d_, const int* tab_, RNG::RanWord seed_,
+                   const RNG::RanWord* pw_, int nw_, RNG::RanWord counter_, bool philox_) : 
+    d(d_), tab(tab_), seed(seed_), pw(pw_), nw(nw_), counter(counter_), philox(philox_) {}
+};
+
+//! Uniforms for one site from the selected generator
+template<class T>
+inline void randomSiteUniforms(float* u, int n, int i, const RandomThreadArgs<T>* a)
 {
-  // Grab table array
-  const int *tab = s.siteTable().slice();
+  if (a->philox)
+    RNG::fillCounterUniforms(u, n, a->seed, RNG::globalSiteIndex(i), a->counter);
+  else
+    RNG::fillUniforms(u, n, a->seed * RNG::lattice_ran_mult_word[i], a->pw);
+}
 
-#pragma omp parallel 
+template<class T>
+void randomKernel(int lo, int hi, int my_id, RandomThreadArgs<T>* a)
+{
+  multi1d<float> u(a->nw);
+
+  for(int j=lo; j < hi; ++j) 
   {
-    Seed seed;
-    Seed skewed_seed;
+    int i = a->tab[j];
 
-#pragma omp for // need the barrier to avoid that RNG::ran_seed is changed too early
-    for(int j=0; j < s.numSiteTable(); ++j) {
-      int i = tab[j];
-      seed = RNG::ran_seed;
-      skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
-      fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
-    }
+    randomSiteUniforms(&(u[0]), a->nw, i, a);
 
-#pragma omp critical (random)
-    {
-      RNG::ran_seed = seed;  // The seed from any site is the same as the new global seed
-    }
+    RNGUniformStream st(&(u[0]));
+    fill_random(a->d.elem(i), st, st, st);
   }
+}
+
+template<class T>
+void gaussianKernel(int lo, int hi, int my_id, RandomThreadArgs<T>* a)
+{
+  multi1d<float> u(2*a->nw);
+  T r1, r2;
+
+  for(int j=lo; j < hi; ++j) 
+  {
+    int i = a->tab[j];
+
+    // r1 and r2 are consecutive pieces of the stream of the site
+    randomSiteUniforms(&(u[0]), 2*a->nw, i, a);
+
+    RNGUniformStream st(&(u[0]));
+    fill_random(r1, st, st, st);
+    fill_random(r2, st, st, st);
+    fill_gaussian(a->d.elem(i), r1, r2);
+  }
+}
+
+
+//! dest  = random    under a subset
+/*!
+ * Gives the same numbers as stepping the seeds of every site through
+ * sranf, but the 47 bit seeds are held in 64 bit words and all steps
+ * of a site are computed independently
+ */
+template<class T>
+void 
+random(OLattice<T>& d, const Subset& s)
+{
+  const int nw = randomWordsPerSite<T>();
+  const bool philox = (RNG::getRNGType() == RNG::RNG_PHILOX);
+
+  multi1d<RNG::RanWord> pw(nw+1);
+  if (! philox)
+    RNG::ranPowers(&(pw[0]), nw+1, RNG::seedToWord(RNG::ran_mult_n));
+
+  RNG::RanWord seed = RNG::seedToWord(RNG::ran_seed);
+  RandomThreadArgs<T> args(d, s.siteTable().slice(), seed, &(pw[0]), nw, RNG::ran_counter, philox);
+  dispatch_to_threads(s.numSiteTable(), args, randomKernel<T>);
 
+  // Next Philox fill, or the seed any site would end on for the LCG
+  if (philox)
+    ++RNG::ran_counter;
+  else
+    RNG::wordToSeed(RNG::ran_seed, seed * pw[nw]);
 }
 
 
+
 //! dest  = random   under a subset
 template<class T>
 void random(OSubLattice<T> dd)
@@ -387,22 +497,28 @@ void random(OLattice<T>& d)
 
 
 //! dest  = gaussian   under a subset
+/*!
+ * Box-Muller is applied per site on the two consecutive blocks of
+ * uniforms random() would have put in two lattice temporaries
+ */
 template<class T>
 void gaussian(OLattice<T>& d, const Subset& s)
 {
-  OLattice<T>  r1, r2;
+  const int nw = randomWordsPerSite<T>();
+  const bool philox = (RNG::getRNGType() == RNG::RNG_PHILOX);
 
-  random(r1,s);
-  random(r2,s);
+  multi1d<RNG::RanWord> pw(2*nw+1);
+  if (! philox)
+    RNG::ranPowers(&(pw[0]), 2*nw+1, RNG::seedToWord(RNG::ran_mult_n));
 
-  const int *tab = s.siteTable().slice();
+  RNG::RanWord seed = RNG::seedToWord(RNG::ran_seed);
+  RandomThreadArgs<T> args(d, s.siteTable().slice(), seed, &(pw[0]), nw, RNG::ran_counter, philox);
+  dispatch_to_threads(s.numSiteTable(), args, gaussianKernel<T>);
 
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    fill_gaussian(d.elem(i), r1.elem(i), r2.elem(i));
-  }
+  if (philox)
+    ++RNG::ran_counter;
+  else
+    RNG::wordToSeed(RNG::ran_seed, seed * pw[2*nw]);
 }
 
 
@@ -481,18 +597,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -509,18 +619,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -538,10 +642,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Must initialize to zero since we do not know if the loop will be entered
   zero_rep(d.elem());
@@ -567,11 +669,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -588,10 +686,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Loop always entered - could unroll
   zero_rep(d.elem());
@@ -614,11 +710,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
     }
   }
 
-#if defined(QDP_USE_PROFILING)	 
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
   
   return d;
 }
@@ -636,10 +728,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
   
-#if defined(QDP_USE_PROFILING)	 
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
   
   // Loop always entered - could unroll
   zero_rep(d.elem());
@@ -661,11 +751,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
     }
   }
 	
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -687,20 +773,14 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     evaluate(dest[i],OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -744,10 +824,8 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   multi1d< typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t > pdest(qdpNumThreads());
 
@@ -785,11 +863,7 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
   }
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -802,10 +876,8 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Initialize result with zero
   for(int k=0; k < ss.numSubsets(); ++k)
@@ -821,11 +893,7 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
     dest[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -847,21 +915,15 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OScalar<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < dest.size1(); ++i)
     for(int j=0; j < dest.size2(); ++j)
       dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], 1);
 
   return dest;
 }
@@ -882,10 +944,8 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Initialize result with zero
   for(int i=0; i < dest.size1(); ++i)
@@ -907,11 +967,7 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
     }
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], Layout::sitesOnNode()*s1.size());
 
   return dest;
 }
@@ -931,10 +987,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -945,11 +999,7 @@ norm2(const multi1d< OScalar<T> >& s1)
     d.elem() += localNorm2(ss1.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], 1);
 
   return d;
 }
@@ -978,10 +1028,8 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1012,11 +1060,7 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
   }
 
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -1053,10 +1097,8 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 {
   typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProduct>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1068,11 +1110,7 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
     d.elem() += localInnerProduct(ss1.elem(),ss2.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnInnerProduct(), s1[0], 1);
 
   return d;
 }
@@ -1102,10 +1140,8 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
 {
   typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1134,11 +1170,7 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
     }
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnInnerProduct(), s1[0], s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -1174,10 +1206,8 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 {
   typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProductReal>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1189,11 +1219,7 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
     d.elem() += localInnerProductReal(ss1.elem(),ss2.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnInnerProductReal(), s1[0], 1);
 
   return d;
 }
@@ -1224,10 +1250,8 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 {
   typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1257,11 +1281,7 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
     }
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnInnerProductReal(), s1[0], s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -1296,18 +1316,12 @@ globalMax(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnGlobalMax>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global max needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnGlobalMax(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1324,10 +1338,8 @@ globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
 {
   typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Loop always entered so unroll
   d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());   // SINGLE NODE VERSION FOR NOW
@@ -1342,11 +1354,7 @@ globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
       d.elem() = dd;
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnGlobalMax(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1362,18 +1370,12 @@ globalMin(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnGlobalMin>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global min needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnGlobalMin(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1390,10 +1392,8 @@ globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
 {
   typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Loop always entered so unroll
   d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());   // SINGLE NODE VERSION FOR NOW
@@ -1408,11 +1408,7 @@ globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
       d.elem() = dd;
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnGlobalMin(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1443,10 +1439,8 @@ isnan(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsNan(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1456,11 +1450,7 @@ isnan(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsNan(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1488,10 +1478,8 @@ isinf(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsInf(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1501,11 +1489,7 @@ isinf(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsInf(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1533,10 +1517,8 @@ isfinite(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsFinite(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1546,11 +1528,7 @@ isfinite(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsFinite(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1578,10 +1556,8 @@ isnormal(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnIsNormal(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1591,11 +1567,7 @@ isnormal(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnIsNormal(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -1753,14 +1725,12 @@ struct FnMap
 };
 
 
-#if defined(QDP_USE_PROFILING)   
 template <>
 struct TagVisitor<FnMap, PrintTag> : public ParenPrinter<FnMap>
 { 
   static void visit(FnMap op, PrintTag t) 
     { t.os_m << "shift"; }
 };
-#endif
 
 
 // Specialization of ForEach deals with maps. 
@@ -2248,6 +2218,67 @@ namespace LatticeTimeSliceIO
     }
   }
 
+  //! Gather of time slices into lexicographic order
+  /*! On a single node this is a copy; wait() has nothing to do */
+  class SliceGather
+  {
+  public:
+    SliceGather() : size(0), nmemb(0), sizemem(0), nsites(0) {}
+
+    //! Copy the sites in lexicographic order
+    void start(const char* data, size_t size_, size_t nmemb_,
+	       int start_lexico, int stop_lexico)
+    {
+      size    = size_;
+      nmemb   = nmemb_;
+      sizemem = size*nmemb;
+      nsites  = stop_lexico - start_lexico;
+      buf.resize(sizemem*nsites);
+
+      for(int site=start_lexico; site < stop_lexico; ++site)
+	memcpy(&buf[sizemem*(site-start_lexico)], data+Layout::linearSiteIndex(site)*sizemem, sizemem);
+    }
+
+    //! Complete the gather
+    void wait() {}
+
+    //! Write the gathered sites
+    void write(BinaryWriter& bin) const
+    {
+      if (! buf.empty())
+	bin.writeArray(&buf[0], size, nmemb*nsites);
+    }
+
+  private:
+    //! Hide
+    SliceGather(const SliceGather&);
+    void operator=(const SliceGather&);
+
+    size_t size, nmemb, sizemem;
+    int nsites;
+    std::vector<char> buf;
+  };
+
+  //! Scatter of time slices from lexicographic order
+  inline void scatterOLatticeSlice(const char* buf, char* data, 
+				   size_t sizemem,
+				   int start_lexico, int stop_lexico)
+  {
+    for(int site=start_lexico; site < stop_lexico; ++site)
+      memcpy(data+Layout::linearSiteIndex(site)*sizemem, buf+sizemem*(site-start_lexico), sizemem);
+  }
+
+  //! Start the gather of a range of sites of a lattice quantity
+  template<class T>
+  void startGather(SliceGather& gather, const OLattice<T>& data, 
+		   int start_lexico, int stop_lexico)
+  {
+    gather.start((const char *)&(data.elem(0)), 
+		 sizeof(typename WordType<T>::Type_t), 
+		 sizeof(T) / sizeof(typename WordType<T>::Type_t),
+		 start_lexico, stop_lexico);
+  }
+
 } // namespace LatticeTimeSliceIO
 } // namespace QDP
 
@@ -426,6 +426,28 @@ typedef OLattice< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComple
 typedef OScalar< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComplex<REAL64>, Nc>, (Ns>>1) >, Nc>, (Ns>>1) > > HalfFourquarkD;
 typedef OLattice< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComplex<REAL64>, Nc>, (Ns>>1) >, Nc>, (Ns>>1) > > LatticeHalfFourquarkD;
 
+// REAL16 types: storage only, convert to REAL32 for arithmetic (see qdp_half.h)
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, 4> > LatticeDiracFermionH;
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, 3>, 4> > LatticeDiracFermionH3;
+
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, 1> > LatticeStaggeredFermionH;
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, 3>, 1> > LatticeStaggeredFermionH3;
+
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, Ns> > LatticeFermionH;
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, 3>, Ns> > LatticeFermionH3;
+
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, (Ns>>1) > > LatticeHalfFermionH;
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, 3>, (Ns>>1) > > LatticeHalfFermionH3;
+
+typedef OLattice< PScalar< PColorMatrix< RComplex<REAL16>, Nc> > > LatticeColorMatrixH;
+typedef OLattice< PScalar< PColorMatrix< RComplex<REAL16>, 3> > > LatticeColorMatrixH3;
+
+typedef OLattice< PScalar< PColorVector< RComplex<REAL16>, Nc> > > LatticeColorVectorH;
+typedef OLattice< PScalar< PColorVector< RComplex<REAL16>, 3> > > LatticeColorVectorH3;
+
+typedef OLattice< PScalar< PScalar< RComplex<REAL16> > > > LatticeComplexH;
+typedef OLattice< PScalar< PScalar< RScalar<REAL16> > > > LatticeRealH;
+
 // Equivalent names
 typedef Integer  Int;
 
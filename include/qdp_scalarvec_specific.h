@@ -71,10 +71,8 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 //  cerr << "In evaluateUnorderedSubet(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
 #if ! defined(QDP_NOT_IMPLEMENTED)
   const int *tab = s.siteTable().slice();
@@ -89,11 +87,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
   QDP_error_exit("evaluateSubset not implemented");
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 //! OLattice Op OLattice(Expression(source)) under an Subset
@@ -108,10 +102,8 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //  cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
 #if ! defined(QDP_NOT_IMPLEMENTED)
   // General form of loop structure
@@ -126,11 +118,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
   QDP_error_exit("evaluateSubset not implemented");
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest, op, rhs, s.numSiteTable());
 }
 
 
@@ -341,18 +329,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -369,18 +351,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   evaluate(d,OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return d;
 }
@@ -404,10 +380,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
   OScalar<T> tmp;   // Note, expect to have ILattice inner grid
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Must initialize to zero since we do not know if the loop will be entered
   zero_rep(d.elem());
@@ -437,11 +411,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
     }
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnSum(), s1, s.numSiteTable());
 
   return d;
 }
@@ -479,20 +449,14 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OScalar<T>, FnSum>::Type_t>  dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     dest[i] = sum(s1,ss[i]);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -513,20 +477,14 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     dest[i] = sum(s1,ss[i]);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest[0], OpAssign(), FnSum(), s1, Layout::sitesOnNode());
 
   return dest;
 }
@@ -548,21 +506,15 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OScalar<T>, FnSum>::Type_t>  dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int i=0; i < dest.size1(); ++i)
     for(int j=0; j < dest.size2(); ++j)
       dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], 1);
 
   return dest;
 }
@@ -583,21 +535,15 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // lazy - evaluate repeatedly
   for(int k=0; k < s1.size(); ++k)
     for(int i=0; i < ss.numSubsets(); ++i)
       dest(k,i) = sum(s1[k],ss[i]);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, dest(0,0), OpAssign(), FnSum(), s1[0], Layout::sitesOnNode()*s1.size());
 
   return dest;
 }
@@ -617,10 +563,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -631,11 +575,7 @@ norm2(const multi1d< OScalar<T> >& s1)
     d.elem() += localNorm2(ss1.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], 1);
 
   return d;
 }
@@ -664,10 +604,8 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof;
+  QDPProfileTimer_t prof_timer;
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -687,11 +625,7 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
   QDP_error_exit("norm2-Subset not implemented");
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_timer, d, OpAssign(), FnNorm2(), s1[0], s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -865,14 +799,12 @@ struct FnMap
   PETE_EMPTY_CONSTRUCTORS(FnMap)
 };
 
-#if defined(QDP_USE_PROFILING)   
 template <>
 struct TagVisitor<FnMap, PrintTag> : public ParenPrinter<FnMap>
 { 
   static void visit(FnMap op, PrintTag t) 
     { t.os_m << "shift"; }
 };
-#endif
 
 
 //! General permutation map class for communications
@@ -29,6 +29,15 @@ public:
   virtual int numSubsets() const = 0;
 };
 
+//-----------------------------------------------------------------------
+//! A contiguous run of sites of a subset
+struct SiteRun
+{
+  int start;    // first linear site of the run
+  int length;   // number of sites in the run
+  int offset;   // position of the first site within the site table
+};
+
 //-----------------------------------------------------------------------
 // Forward declaration
 class Set;
@@ -43,8 +52,8 @@ public:
 
   //! Copy constructor
   Subset(const Subset& s):
-    ordRep(s.ordRep), startSite(s.startSite), endSite(s.endSite), 
-    sub_index(s.sub_index), sitetable(s.sitetable), set(s.set)
+    ordRep(s.ordRep), runRep(s.runRep), startSite(s.startSite), endSite(s.endSite), 
+    sub_index(s.sub_index), sitetable(s.sitetable), siteruns(s.siteruns), set(s.set)
     {}
 
   // Simple constructor
@@ -63,8 +72,12 @@ protected:
   // Simple constructor
   void make(bool rep, int start, int end, multi1d<int>* ind, int cb, Set* set);
 
+  //! Attach the run-length form of the site table
+  void makeRuns(bool rep, multi1d<SiteRun>* runs);
+
 private:
   bool ordRep;
+  bool runRep;
   int startSite;
   int endSite;
   int sub_index;
@@ -72,6 +85,9 @@ private:
   //! Site lookup table
   multi1d<int>* sitetable;
 
+  //! Site table as contiguous runs
+  multi1d<SiteRun>* siteruns;
+
   //! Original set
   Set *set;
 
@@ -83,9 +99,19 @@ public:
   const multi1d<int>& siteTable() const {return *sitetable;}
   inline int numSiteTable() const {return sitetable->size();}
 
+  //! Whether the sites are few enough contiguous runs to loop over directly
+  inline bool hasRunRep() const {return runRep;}
+
+  const multi1d<SiteRun>& siteRuns() const {return *siteruns;}
+  inline int numSiteRuns() const {return siteruns->size();}
+
   //! The super-set of this subset
   const Set& getSet() const { return *set; }
 
+  //! Position of each site of the node within the site table
+  /*! Sites outside the subset give numSiteTable() */
+  const multi1d<int>& sitePositions() const;
+
   friend class Set;
 };
 
@@ -126,13 +152,71 @@ protected:
   //! Array of sitetable arrays
   multi1d<multi1d<int> > sitetables;
 
+  //! Array of the sitetables as contiguous runs
+  multi1d<multi1d<SiteRun> > siteruns;
+
+  //! Inverse of the sitetables, made on first use
+  mutable multi1d<multi1d<int> > sitepos;
+
 public:
   //! The coloring of the lattice sites
   const multi1d<int>& latticeColoring() const {return lat_color;}
+
+  //! Position of each site within the sitetable of a subset
+  const multi1d<int>& sitePositions(int subset_index) const;
 };
 
 
 
+//-----------------------------------------------------------------------
+//! Walks the contiguous pieces of a range of site table positions
+/*!
+ * Splits the positions [lo,hi) of a site table, given as runs, into
+ * ranges of linear sites [first,last). Used by the threaded dispatch
+ * so each thread can call an ordered kernel on its pieces.
+ */
+class SiteRunRange
+{
+public:
+  SiteRunRange(const SiteRun* runs_, int nruns, int lo, int hi_) : 
+    runs(runs_), j(lo), hi(hi_)
+    {
+      // Find the run holding position lo
+      int l = 0, h = nruns;
+      while (h - l > 1)
+      {
+	int m = (l + h) >> 1;
+	if (runs[m].offset <= lo)
+	  l = m;
+	else
+	  h = m;
+      }
+      r = l;
+    }
+
+  //! The next piece of linear sites; false when the range is done
+  bool next(int& first, int& last)
+    {
+      if (j >= hi)
+	return false;
+
+      const SiteRun& run = runs[r++];
+      int n = run.offset + run.length - j;
+      if (n > hi - j)
+	n = hi - j;
+
+      first = run.start + (j - run.offset);
+      last  = first + n;
+      j += n;
+      return true;
+    }
+
+private:
+  const SiteRun* runs;
+  int j, hi, r;
+};
+
+
 //-----------------------------------------------------------------------
 //! Default all subset
 extern Subset all;
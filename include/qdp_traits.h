@@ -70,6 +70,19 @@ struct DoublePrecType<REAL32>
 
 template<>
 struct DoublePrecType<REAL64>
+{
+  typedef REAL64 Type_t;
+};
+
+// REAL16 is a storage type: its arithmetic precision is single
+template<>
+struct SinglePrecType<REAL16>
+{
+  typedef REAL32 Type_t;
+};
+
+template<>
+struct DoublePrecType<REAL16>
 {
   typedef REAL64 Type_t;
 };
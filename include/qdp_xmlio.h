@@ -39,6 +39,10 @@ namespace QDP
 
     Note that only the primary node opens and reads XML files. Results from
     Xpath queries are broadcast to all nodes.
+
+    With setLocalParse(true) the primary node instead broadcasts the whole
+    document once when it is opened, and every node parses its own copy.
+    Queries are then answered locally without any communication.
   */
   class XMLReader : protected XMLXPathReader::BasicXPathReader
   {
@@ -120,6 +124,26 @@ namespace QDP
     //! Xpath query
     void get(const std::string& xpath, bool& result);
 
+    //! Xpath query of a whitespace separated list of numbers
+    /*! The list is parsed in one pass and the result broadcast as one block */
+    void get(const std::string& xpath, multi1d<int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<unsigned int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<short int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<unsigned short int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<long int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<unsigned long int>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<float>& result);
+    //! Xpath query of a whitespace separated list of numbers
+    void get(const std::string& xpath, multi1d<double>& result);
+    //! Xpath query of a whitespace separated list of 0 and 1
+    void get(const std::string& xpath, multi1d<bool>& result);
+
     //! read integer attributes so that I can read Matrices in XML
     void getAttribute(const std::string& xpath,
 		      const std::string& attrib_name, 
@@ -129,7 +153,7 @@ namespace QDP
     template<typename T>
     void set(const std::string& xpath, const T& to_set) 
       {
-	if (Layout::primaryNode())
+	if (local || Layout::primaryNode())
 	{  
 	  BasicXPathReader::set<T>(xpath, to_set);
 	}
@@ -147,6 +171,17 @@ namespace QDP
 
     void registerNamespace(const std::string& prefix, const std::string& uri);
 
+    //! Point this reader at the node selected by xpath relative to another reader
+    /*! Used to walk arrays element by element; the reader is closed first */
+    void open(XMLReader& old, const std::string& xpath);
+
+    //! Parse documents opened from now on on every node
+    /*! All nodes must make the same choice */
+    static void setLocalParse(bool on);
+
+    //! Whether documents are parsed on every node
+    static bool getLocalParse();
+
   private:
     //! Hide the = operator
     void operator=(const XMLReader&) {}
@@ -154,13 +189,20 @@ namespace QDP
     //! Hide the copy constructor
     XMLReader(const XMLReader&) {}
   
-    void open(XMLReader& old, const std::string& xpath);
+
+    //! Broadcast a document read on the primary node and parse it everywhere
+    void openLocal(std::string& doc);
   protected:
     // The universal data-reader. All the read functions call this
     template<typename T>
     void
     readPrimitive(const std::string& xpath, T& output);
   
+    // The universal list reader
+    template<typename T>
+    void
+    readArray(const std::string& xpath, multi1d<T>& result);
+
     // The universal attribute reader
     template<typename T>
     void
@@ -170,6 +212,7 @@ namespace QDP
   private:
     bool  iop;  //file open or closed?
     bool  derived; // is this reader derived from another reader?
+    bool  local;   // is the document parsed on every node?
   };
 
 
@@ -198,47 +241,51 @@ namespace QDP
   void read(XMLReader& xml, const std::string& s, bool& input);
 
 
-  //! Read a XML multi1d element
-  template<class T>
-  inline
-  void read(XMLReader& xml, const std::string& s, multi1d<T>& input)
+  //! Read the elements of an XML array in one pass
+  /*!
+    Each element is found from the previous one through its following
+    sibling, so the cost is linear in the length of the array.
+  */
+  template<class A>
+  void readElems(XMLReader& xml, const std::string& s, A& input)
   {
     XMLReader arraytop(xml, s);
 
     std::ostringstream error_message;
+    std::string elem_base_query = "elem";
   
     // Count the number of elements
-    std::string elem_base_query = "elem";
-	
     int array_size;
     try {
       array_size = arraytop.count(elem_base_query);
     }
     catch( const std::string& e) { 
       error_message << "Exception occurred while counting " << elem_base_query 
-		    << " during array read " << std::endl;
+		    << " during array read " << s << std::endl;
+      throw error_message.str();
     }
       
     // Now resize the array to hold the no of elements.
     input.resize(array_size);
 
-    // Get the elements one by one
-    for(int i=0; i < input.size(); i++) 
-    {
-      std::ostringstream element_xpath;
+    // Get the elements one by one, alternating between two readers
+    XMLReader elem[2];
 
-      // Create the query for the element 
-      element_xpath << elem_base_query << "[" << (i+1) << "]";
+    for(int i=0; i < array_size; i++) 
+    {
+      XMLReader& cur = elem[i & 1];
+      std::string query = (i == 0) ? elem_base_query + "[1]" : "following-sibling::" + elem_base_query + "[1]";
 
       // recursively try and read the element.
       try 
       {
-	read(arraytop, element_xpath.str(), input[i]);
+	cur.open((i == 0) ? arraytop : elem[(i-1) & 1], query);
+	read(cur, ".", input[i]);
       } 
       catch (const std::string& e) 
       {
 	error_message << "Failed to match element " << i
-		      << " of array with query " << element_xpath.str()
+		      << " of array  " << s << "  with query " << query
 		      << std::endl
 		      << "Query returned error: " << e;
 	throw error_message.str();
@@ -247,6 +294,15 @@ namespace QDP
   }
 
 
+  //! Read a XML multi1d element
+  template<class T>
+  inline
+  void read(XMLReader& xml, const std::string& s, multi1d<T>& input)
+  {
+    readElems(xml, s, input);
+  }
+
+
   // Specialized versions for basic types
   template<>
   void read(XMLReader& xml, const std::string& s, multi1d<int>& input);
@@ -268,60 +324,45 @@ namespace QDP
   void read(XMLReader& xml, const std::string& s, multi1d<bool>& input);
 
 
-  //---------------------------------------------------------------
-  //---------------------------------------------------------------
-  //! Read a XML Array element
+  //! Read a XML multi2d element
+  /*!
+    Reads what the multi2d writer writes: one "elem" tag per row. All
+    rows must have the same length.
+  */
   template<class T>
   inline
-  void read(XMLReader& xml, const std::string& s, std::vector<T>& input)
+  void read(XMLReader& xml, const std::string& s, multi2d<T>& input)
   {
-    XMLReader arraytop(xml, s);
+    multi1d< multi1d<T> > rows;
+    read(xml, s, rows);
 
-    std::ostringstream error_message;
-    std::string elemName = "elem";
-  
-    // Count the number of elements
-    std::string elem_base_query = elemName;
-	
-    int array_size;
-    try {
-      array_size = arraytop.count(elem_base_query);
-    }
-    catch( const std::string& e) { 
-      error_message << "Exception occurred while counting " << elem_base_query 
-		    << " during array read " << s << std::endl;
-      arraytop.close();
-      throw error_message.str();
-    }
-      
-    // Now resize the array to hold the no of elements.
-    input.resize(array_size);
-
-    // Get the elements one by one
-    for(int i=0; i < input.size(); i++) 
+    int ncols = (rows.size() > 0) ? rows[0].size() : 0;
+    for(int j=1; j < rows.size(); ++j)
     {
-      std::ostringstream element_xpath;
-
-      // Create the query for the element 
-      element_xpath << elem_base_query << "[" << (i+1) << "]";
-
-      // recursively try and read the element.
-      try {
-	read(arraytop, element_xpath.str(), input[i]);
-      } 
-      catch (const std::string& e) 
+      if (rows[j].size() != ncols)
       {
-	error_message << "Failed to match element " << i
-		      << " of array  " << s << "  with query " << element_xpath.str()
-		      << std::endl
-		      << "Query returned error: " << e;
-	arraytop.close();
+	std::ostringstream error_message;
+	error_message << "Row " << j << " of array " << s << " has " << rows[j].size()
+		      << " elements, but row 0 has " << ncols;
 	throw error_message.str();
       }
     }
 
-    // Arraytop should self destruct but just to be sure.
-    arraytop.close();
+    input.resize(rows.size(), ncols);
+    for(int j=0; j < rows.size(); ++j)
+      for(int i=0; i < ncols; ++i)
+	input(j,i) = rows[j][i];
+  }
+
+
+  //---------------------------------------------------------------
+  //---------------------------------------------------------------
+  //! Read a XML Array element
+  template<class T>
+  inline
+  void read(XMLReader& xml, const std::string& s, std::vector<T>& input)
+  {
+    readElems(xml, s, input);
   }
 
 
@@ -614,7 +655,48 @@ namespace QDP
     // Write all the XML to std::string
     void writeXML(const std::string& output);
 
+    //! Write a list of numbers separated by spaces as tag contents
+    /*!
+      The numbers are formatted into a reused buffer and streamed in large
+      chunks. The text is the same as from an ostream with precision 7 for
+      float and 15 for double, unless setRoundTrip(true) was called.
+    */
+    void writeList(const int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const unsigned int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const short int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const unsigned short int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const long int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const unsigned long int* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const float* output, int n);
+    //! Write a list of numbers separated by spaces as tag contents
+    void writeList(const double* output, int n);
+    //! Write a list of 0 and 1 separated by spaces as tag contents
+    void writeList(const bool* output, int n);
+
+    //! Write float and double lists so they read back exactly
+    /*!
+      Each number gets the fewest digits that read back to the same
+      value, up to 9 for float and 17 for double. Off by default, which
+      keeps the text of an ostream with precision 7 and 15. This applies
+      to the multi1d writers of floating point types.
+    */
+    static void setRoundTrip(bool on);
+
+    //! Whether float and double lists are written to read back exactly
+    static bool getRoundTrip();
+
     friend class XMLArrayWriter;
+
+  protected:
+    // The universal list writer
+    template<typename T>
+    void writeListPrimitive(const T* output, int n);
   };
 
 
@@ -887,24 +969,22 @@ namespace QDP
   }
 
 
-#if 0
-  // NEED TO FIX THIS
   //! Write a XML multi2d element
+  /*!
+    Each row is written as an "elem" tag. Rows of numbers are written as
+    lists. Read it back as a multi2d, or as a multi1d of multi1d.
+  */
   template<class T> 
   inline
   void write(XMLWriter& xml, const std::string& s, const multi2d<T>& s1)
   {
-    for(int j=0; j < s1.size1(); ++j)
-      for(int i=0; i < s1.size2(); ++i)
-      {
-	std::ostringstream ost;
-	if (Layout::primaryNode()) 
-	  ost << s << "[ " << i << " ][ " << j << " ]";
-	write(xml, ost.str(), s1[i][j]);
-      }
-  }
+    xml.openTag(s);
 
-#endif
+    for(int j=0; j < s1.size2(); ++j)
+      write(xml, "elem", s1[j]);
+
+    xml.closeTag();
+  }
 
 
 
@@ -1106,6 +1186,7 @@ namespace QDP
     void close();
         
   private:
+    std::vector<char> output_buf;   // must outlive output_stream
     std::ofstream output_stream;
     std::ostream& getOstream(void) {return output_stream;}
   };
@@ -73,16 +73,14 @@ void evaluate(OLattice< TVec >& d,
   REAL ar = a.elem().elem().elem().elem();
   REAL* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
   // cout << "Specialised axpy a ="<< ar << endl;
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_user_arg a = {yptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -136,16 +134,14 @@ void evaluate(OLattice< TVec >& d,
   // - sign as y -= ax <=> y = y-ax = -ax + y = axpy with -a 
   REAL ar = -( a.elem().elem().elem().elem());
   REAL* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_user_arg a = {yptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     ////////////////
     // Original code
     ////////////////
@@ -212,16 +208,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());   
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());   
     
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -294,17 +288,15 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
    
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -374,16 +366,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) {
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
            
-    int total_n_3vec = (s.end()-s.start()+1); 
-    
     ordered_vaxmy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmy3_evaluate_function);
 
     ////////////////
     // Original code
@@ -452,17 +442,15 @@ void evaluate( OLattice< TVec > &d,
   // -ve sign as y - ax = -ax + y  = axpy with -a.
   REAL ar =  -a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
      
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);
-   
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -519,17 +507,15 @@ void evaluate(OLattice< TVec >& d,
   REAL ar = a.elem().elem().elem().elem();
   REAL* aptr = &ar;
   
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
      
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
     // cout << "Specialised axpy a ="<< ar << endl;
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_user_arg a = {yptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -588,16 +574,14 @@ void evaluate(OLattice< TVec >& d,
   REAL ar = -( a.elem().elem().elem().elem());
   REAL* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxpy3_user_arg a = {yptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -669,17 +653,15 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -755,17 +737,15 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
    
-    int total_n_3vec = (s.end()-s.start()+1);   
-    
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -837,16 +817,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxmy3_user_arg a = {zptr, aptr, xptr, yptr, };
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -917,17 +895,15 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  -a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -984,17 +960,15 @@ void evaluate( OLattice< TVec > &d,
 
   REAL one = 1;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxpy3_user_arg a = {zptr, &one, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1050,17 +1024,15 @@ void evaluate( OLattice< TVec > &d,
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
   REAL one=1;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_3vec = (s.end()-s.start()+1);
-   
     ordered_vaxmy3_user_arg a = {zptr, &one, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1116,16 +1088,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = &ar;  
   
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1); 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vscal_user_arg a = {zptr, aptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1177,15 +1147,13 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = &ar;  
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *zptr =  &(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_3vec = (s.end()-s.start()+1);
-   
     ordered_vscal_user_arg a = {zptr, aptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1234,16 +1202,14 @@ void evaluate( OLattice< TVec > &d,
 #endif
   
   REAL ar = a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL* xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL* xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL* zptr = xptr;
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vscal_user_arg a = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1293,15 +1259,13 @@ void evaluate( OLattice< TVec > &d,
 #endif
   
   REAL ar = (REAL)1/a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL* zptr = xptr;
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vscal_user_arg a = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1352,17 +1316,15 @@ void evaluate( OLattice< TVec > &d,
 #endif
   REAL one = 1;
 
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
     //int n_3vec = (s.end() - s.start()+1)*Ns;
-    REAL *xptr = (REAL *)(&x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *)(&d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *)(&x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *)(&d.elem(0).elem(0).elem(0).real());
 
 
-    int total_n_3vec = (s.end()-s.start()+1);   
-    
     ordered_vaxpy3_user_arg a = {yptr, &one, yptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1418,16 +1380,14 @@ void evaluate( OLattice< TVec > &d,
 #endif
   REAL one = 1;
     
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *)(&x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *)(&d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *)(&x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *)(&d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vaxmy3_user_arg a = {yptr, &one, yptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1506,16 +1466,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1604,16 +1562,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);   
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1707,16 +1663,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1797,16 +1751,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);
-    
     ordered_vaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1887,16 +1839,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) {
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_3vec = (s.end()-s.start()+1);    
-    
     ordered_vaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1985,16 +1935,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -2088,16 +2036,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -2177,17 +2123,15 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-    
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     ordered_vaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -138,15 +138,13 @@ void evaluate(OLattice< TVec >& d,
   REAL ar = a.elem().elem().elem().elem();
   REAL* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaypx3_g5_user_arg a = {yptr, aptr, yptr, xptr, xpayz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -203,15 +201,13 @@ void evaluate(OLattice< TVec >& d,
   
   REAL ar = a.elem().elem().elem().elem();
   REAL* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
 
     ordered_vaypx3_g5_user_arg a = {yptr, aptr, yptr, xptr, xmayz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -268,15 +264,13 @@ void evaluate(OLattice< TVec >& d,
   REAL ar = a.elem().elem().elem().elem();
   REAL* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaypx3_g5_user_arg a = {yptr, aptr, yptr, xptr,  xmayz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -328,15 +322,13 @@ void evaluate(OLattice< TVec >& d,
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
   
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
   
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vadd3_g5_user_arg a = {yptr, yptr, xptr, add_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vadd3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vadd3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -388,15 +380,13 @@ void evaluate(OLattice< TVec >& d,
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
 
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
   
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vadd3_g5_user_arg a = {yptr, yptr, xptr, add_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vadd3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vadd3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -447,15 +437,13 @@ void evaluate(OLattice< TVec >& d,
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
-  if( s.hasOrderedRep() ) {
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vadd3_g5_user_arg a = {yptr, yptr, xptr, sub_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vadd3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vadd3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -506,15 +494,13 @@ void evaluate(OLattice< TVec >& d,
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = (REAL *)&(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = (REAL *)&(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vadd3_g5_user_arg a = {yptr, yptr, xptr, sub_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vadd3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vadd3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -677,16 +663,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vaypx3_g5_user_arg a = {zptr, aptr, xptr, yptr, xpayz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -765,16 +749,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vaypx3_g5_user_arg a = {zptr, aptr, xptr, yptr, xmayz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -853,16 +835,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vaypx3_g5_user_arg a = {zptr, aptr, xptr, yptr, xmayz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaypx3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaypx3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -936,16 +916,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_g5_user_arg a = {zptr, aptr, xptr, yptr, axpyz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpy3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1019,16 +997,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_g5_user_arg a = {zptr, aptr, xptr, yptr, axpyz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpy3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1104,17 +1080,15 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_g5_user_arg a = {zptr, aptr, xptr, yptr, axmyz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpy3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1188,16 +1162,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpy3_g5_user_arg a = {zptr, aptr, xptr, yptr, axmyz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpy3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpy3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1257,15 +1229,13 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = &ar;  
 
-  if( s.hasOrderedRep() ) {
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) {
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vscal_g5_user_arg a = {zptr, aptr, xptr, scal_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vscal_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1323,15 +1293,13 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = &ar;  
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vscal_g5_user_arg a = {zptr, aptr, xptr, scal_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vscal_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vscal_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1416,16 +1384,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpby3_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axpbyz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpby3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1515,16 +1481,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpby3_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axpbyz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpby3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1612,16 +1576,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpby3_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axmbyz_g5ProjPlus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpby3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1707,16 +1669,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_vaxpby3_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axmbyz_g5ProjMinus};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_vaxpby3_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vaxpby3_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1789,15 +1749,13 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = &ar;  
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_scal_g5_user_arg a = {zptr, aptr, xptr};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_scal_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_scal_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1883,16 +1841,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_xOpayz_g5_user_arg a = {zptr, aptr, xptr, yptr, xmayz_g5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_xOpayz_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_xOpayz_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -1991,16 +1947,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_axOpbyz_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axpbyz_g5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_axOpbyz_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_axOpbyz_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2094,16 +2048,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_axOpbyz_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, g5_axmbyz};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_axOpbyz_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_axOpbyz_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2214,16 +2166,14 @@ void evaluate( OLattice< TVec > &d,
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_axOpbyz_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axpbyz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_axOpbyz_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_axOpbyz_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2331,17 +2281,15 @@ void evaluate( OLattice< TVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().elem());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_4vec = (s.end()-s.start()+1);
 
     ordered_axOpbyz_g5_user_arg a = {zptr, aptr, xptr, bptr, yptr, axmbyz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_axOpbyz_g5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_axOpbyz_g5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2438,16 +2386,14 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_xOpayz_ig5_user_arg a = {zptr, aptr, xptr, yptr, xpayz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_xOpayz_ig5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_xOpayz_ig5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2545,17 +2491,15 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_xOpayz_ig5_user_arg a = {zptr, aptr, xptr, yptr, xmayz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_xOpayz_ig5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_xOpayz_ig5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2655,15 +2599,13 @@ void evaluate( OLattice< TVec > &d,
 
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     ordered_xOpayz_ig5_user_arg a = {zptr, aptr, zptr, xptr, xpayz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_xOpayz_ig5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_xOpayz_ig5_evaluate_function);
 
     ////////////////
     // Original code
@@ -2762,15 +2704,13 @@ void evaluate( OLattice< TVec > &d,
   REAL ar =  a.elem().elem().elem().elem();
   REAL *aptr = (REAL *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = (s.end()-s.start()+1);
-
     ordered_xOpayz_ig5_user_arg a = {zptr, aptr, zptr, xptr, xmayz_ig5};
 
-    dispatch_to_threads(total_n_4vec, a, ordered_xOpayz_ig5_evaluate_function);
+    dispatch_to_runs(s, a, ordered_xOpayz_ig5_evaluate_function);
 
     ////////////////
     // Original code
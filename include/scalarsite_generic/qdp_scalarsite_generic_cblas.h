@@ -46,14 +46,12 @@ void evaluate( OLattice< CTVec > &d,
   
   REAL *a_start = (REAL *) &(a.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *d_start = &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *d_start = &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vcscal_user_arg a = {d_start, a_start, d_start};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -108,16 +106,14 @@ void evaluate( OLattice< CTVec > &d,
 
   REAL *a_start = (REAL *) &(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
   
-    REAL *d_start = &(d.elem(s.start()).elem(0).elem(0).real());
-    REAL *x_start = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *d_start = &(d.elem(0).elem(0).elem(0).real());
+    REAL *x_start = (REAL *) &(x.elem(0).elem(0).elem(0).real());
 
     ordered_vcscal_user_arg a = {d_start, a_start, x_start};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -176,15 +172,13 @@ void evaluate( OLattice< CTVec > &d,
 
   REAL *a_start = (REAL *) &(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *d_start = &(d.elem(s.start()).elem(0).elem(0).real());
-    REAL *x_start = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *d_start = &(d.elem(0).elem(0).elem(0).real());
+    REAL *x_start = (REAL *) &(x.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcscal_user_arg a = {d_start, a_start, x_start};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcscal_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -239,16 +233,14 @@ void evaluate(OLattice< CTVec >& d,
   const OScalar< CScal >& a = static_cast<const OScalar< CScal > &> (rhs.expression().left());
   
   REAL* ar   = (REAL *)&(a.elem().elem().elem().real());
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vcaxpy3_user_arg a = {yptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -304,15 +296,13 @@ void evaluate(OLattice< CTVec >& d,
   
   REAL* ar   = (REAL *)&(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep()) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {yptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -368,16 +358,14 @@ void evaluate(OLattice< CTVec >& d,
   OScalar<CScal> m_a = -a;
 
   REAL* ar   = (REAL *)&(m_a.elem().elem().elem().real());
-  if( s.hasOrderedRep() ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
     // cout << "Specialised axpy a ="<< ar << endl;
  
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {yptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -434,16 +422,14 @@ void evaluate(OLattice< CTVec >& d,
   
   REAL* ar   = (REAL *)&(m_a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep()  ) { 
-    REAL* xptr = (REAL *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL* xptr = (REAL *)&(x.elem(0).elem(0).elem(0).real());
+    REAL* yptr = &(d.elem(0).elem(0).elem(0).real());
     // cout << "Specialised axpy a ="<< ar << endl;
 
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {yptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -512,17 +498,15 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
 
-    int total_n_3vec = (s.end()-s.start()+1);
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -596,16 +580,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -678,16 +660,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -761,16 +741,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -845,16 +823,14 @@ void evaluate( OLattice< CTVec > &d,
   const OLattice< CTVec >& x = static_cast<const OLattice< CTVec >&>(mulNode.right());
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
-  if( s.hasOrderedRep()) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -931,16 +907,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(a.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1019,16 +993,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(m_a.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
  
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1107,16 +1079,14 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *ar   = (REAL *) &(m_a.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL *zptr =          &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_3vec = (s.end()-s.start()+1);
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL *zptr =          &(d.elem(0).elem(0).elem(0).real());
 
     ordered_vcaxpy3_user_arg a = {zptr, ar, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpy3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1199,17 +1169,15 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1298,17 +1266,15 @@ void evaluate( OLattice< CTVec > &d,
   // Set pointers 
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1403,16 +1369,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1494,16 +1458,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxpby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxpby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1585,16 +1547,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1685,16 +1645,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1789,16 +1747,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
   
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1880,16 +1836,14 @@ void evaluate( OLattice< CTVec > &d,
   REAL *aptr = (REAL *)&(a.elem().elem().elem().real());
   REAL *bptr = (REAL *)&(b.elem().elem().elem().real());
 
-  if( s.hasOrderedRep() ) { 
-    REAL *xptr = (REAL *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL *yptr = (REAL *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL *xptr = (REAL *) &(x.elem(0).elem(0).elem(0).real());
+    REAL *yptr = (REAL *) &(y.elem(0).elem(0).elem(0).real());
+    REAL* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_vcaxmby3_user_arg a = {zptr, aptr, xptr, bptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vcaxmby3_evaluate_function);
+    dispatch_to_runs(s, a, ordered_vcaxmby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -0,0 +1,327 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Generic optimization hooks for checkerboarded fermions
+ *
+ * The sites of a checkerboarded field are stored contiguously, so the
+ * vector updates and reductions of the solvers run as one ordered
+ * stream over the checkerboard. Fields on another checkerboard fall
+ * back to the site by site evaluation.
+ */
+
+#ifndef QDP_SCALARSITE_GENERIC_CBLATTICE_H
+#define QDP_SCALARSITE_GENERIC_CBLATTICE_H
+
+namespace QDP {
+
+namespace CBLatticeInternal
+{
+  //! Start of the field as an array of REAL
+  inline REAL* realPtr(const OCBLattice< TVec >& x)
+  {
+    return (REAL *)&(x.elemCB(0).elem(0).elem(0).real());
+  }
+}
+
+
+// d += Scalar*Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAddAssign& op,
+	      const QDPExpr<BinaryNode<OpMultiply,
+	      Reference< QDPType< TScal, OScalar< TScal > > >,
+	      Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(rhs.expression().right());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
+
+  if (x.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  REAL ar = a.elem().elem().elem().elem();
+  REAL* yptr = CBLatticeInternal::realPtr(d);
+
+  ordered_vaxpy3_user_arg arg = {yptr, &ar, CBLatticeInternal::realPtr(x), yptr};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxpy3_evaluate_function);
+}
+
+// d -= Scalar*Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpSubtractAssign& op,
+	      const QDPExpr<BinaryNode<OpMultiply,
+	      Reference< QDPType< TScal, OScalar< TScal > > >,
+	      Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(rhs.expression().right());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
+
+  if (x.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  // y -= ax is an axpy with -a
+  REAL ar = -a.elem().elem().elem().elem();
+  REAL* yptr = CBLatticeInternal::realPtr(d);
+
+  ordered_vaxpy3_user_arg arg = {yptr, &ar, CBLatticeInternal::realPtr(x), yptr};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxpy3_evaluate_function);
+}
+
+// d = Scalar*Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAssign& op,
+	      const QDPExpr<BinaryNode<OpMultiply,
+	      Reference< QDPType< TScal, OScalar< TScal > > >,
+	      Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(rhs.expression().right());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
+
+  if (x.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  REAL ar = a.elem().elem().elem().elem();
+
+  ordered_vscal_user_arg arg = {CBLatticeInternal::realPtr(d), &ar, CBLatticeInternal::realPtr(x)};
+  dispatch_to_threads(d.numSites(), arg, ordered_vscal_evaluate_function);
+}
+
+// d = Scalar*Vec + Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAssign& op,
+	      const QDPExpr<
+	      BinaryNode<OpAdd,
+	       BinaryNode<OpMultiply,
+	        Reference< QDPType< TScal, OScalar< TScal > > >,
+	        Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	       Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  typedef BinaryNode<OpMultiply,
+    Reference< QDPType< TScal, OScalar< TScal > > >,
+    Reference< QDPType< TVec, OCBLattice< TVec > > > > BN;
+
+  const BN &mulNode = static_cast<const BN&>(rhs.expression().left());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(mulNode.left());
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(mulNode.right());
+  const OCBLattice< TVec >& y = static_cast<const OCBLattice< TVec >&>(rhs.expression().right());
+
+  if (x.checkerboard() != d.checkerboard() || y.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  REAL ar = a.elem().elem().elem().elem();
+
+  ordered_vaxpy3_user_arg arg = {CBLatticeInternal::realPtr(d), &ar,
+				 CBLatticeInternal::realPtr(x), CBLatticeInternal::realPtr(y)};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxpy3_evaluate_function);
+}
+
+// d = Scalar*Vec - Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAssign& op,
+	      const QDPExpr<
+	      BinaryNode<OpSubtract,
+	       BinaryNode<OpMultiply,
+	        Reference< QDPType< TScal, OScalar< TScal > > >,
+	        Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	       Reference< QDPType< TVec, OCBLattice< TVec > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  typedef BinaryNode<OpMultiply,
+    Reference< QDPType< TScal, OScalar< TScal > > >,
+    Reference< QDPType< TVec, OCBLattice< TVec > > > > BN;
+
+  const BN &mulNode = static_cast<const BN&>(rhs.expression().left());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(mulNode.left());
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(mulNode.right());
+  const OCBLattice< TVec >& y = static_cast<const OCBLattice< TVec >&>(rhs.expression().right());
+
+  if (x.checkerboard() != d.checkerboard() || y.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  REAL ar = a.elem().elem().elem().elem();
+
+  ordered_vaxmy3_user_arg arg = {CBLatticeInternal::realPtr(d), &ar,
+				 CBLatticeInternal::realPtr(x), CBLatticeInternal::realPtr(y)};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxmy3_evaluate_function);
+}
+
+// d = Vec + Scalar*Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAssign& op,
+	      const QDPExpr<
+	      BinaryNode<OpAdd,
+	       Reference< QDPType< TVec, OCBLattice< TVec > > >,
+	       BinaryNode<OpMultiply,
+	        Reference< QDPType< TScal, OScalar< TScal > > >,
+	        Reference< QDPType< TVec, OCBLattice< TVec > > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  typedef BinaryNode<OpMultiply,
+    Reference< QDPType< TScal, OScalar< TScal > > >,
+    Reference< QDPType< TVec, OCBLattice< TVec > > > > BN;
+
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(rhs.expression().left());
+  const BN &mulNode = static_cast<const BN&>(rhs.expression().right());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(mulNode.left());
+  const OCBLattice< TVec >& y = static_cast<const OCBLattice< TVec >&>(mulNode.right());
+
+  if (x.checkerboard() != d.checkerboard() || y.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  REAL ar = a.elem().elem().elem().elem();
+
+  ordered_vaxpy3_user_arg arg = {CBLatticeInternal::realPtr(d), &ar,
+				 CBLatticeInternal::realPtr(y), CBLatticeInternal::realPtr(x)};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxpy3_evaluate_function);
+}
+
+// d = Vec - Scalar*Vec
+template<>
+inline
+void evaluate(OCBLattice< TVec >& d,
+	      const OpAssign& op,
+	      const QDPExpr<
+	      BinaryNode<OpSubtract,
+	       Reference< QDPType< TVec, OCBLattice< TVec > > >,
+	       BinaryNode<OpMultiply,
+	        Reference< QDPType< TScal, OScalar< TScal > > >,
+	        Reference< QDPType< TVec, OCBLattice< TVec > > > > >,
+	      OLattice< TVec > > &rhs,
+	      const Subset& s)
+{
+  CBLatticeInternal::checkSubset(s, d.checkerboard());
+
+  typedef BinaryNode<OpMultiply,
+    Reference< QDPType< TScal, OScalar< TScal > > >,
+    Reference< QDPType< TVec, OCBLattice< TVec > > > > BN;
+
+  const OCBLattice< TVec >& x = static_cast<const OCBLattice< TVec >&>(rhs.expression().left());
+  const BN &mulNode = static_cast<const BN&>(rhs.expression().right());
+  const OScalar< TScal >& a = static_cast<const OScalar< TScal >&>(mulNode.left());
+  const OCBLattice< TVec >& y = static_cast<const OCBLattice< TVec >&>(mulNode.right());
+
+  if (x.checkerboard() != d.checkerboard() || y.checkerboard() != d.checkerboard())
+  {
+    CBLatticeInternal::evaluateSites(d, op, rhs);
+    return;
+  }
+
+  // x - ay is an axpy with -a
+  REAL ar = -a.elem().elem().elem().elem();
+
+  ordered_vaxpy3_user_arg arg = {CBLatticeInternal::realPtr(d), &ar,
+				 CBLatticeInternal::realPtr(y), CBLatticeInternal::realPtr(x)};
+  dispatch_to_threads(d.numSites(), arg, ordered_vaxpy3_evaluate_function);
+}
+
+
+// Global norm squared of a checkerboarded vector
+template<>
+inline UnaryReturn<OLattice< TVec >, FnNorm2>::Type_t
+norm2(const OCBLattice< TVec >& s1)
+{
+  DOUBLE lsum = 0;
+  local_sumsq(&lsum, CBLatticeInternal::realPtr(s1), s1.numSites());
+
+  UnaryReturn< OLattice< TVec >, FnNorm2>::Type_t  gsum(lsum);
+  QDPInternal::globalSum(gsum);
+  return gsum;
+}
+
+// Global inner product of checkerboarded vectors
+template<>
+inline BinaryReturn< OLattice<TVec>, OLattice<TVec>, FnInnerProduct>::Type_t
+innerProduct(const OCBLattice< TVec >& v1, const OCBLattice< TVec >& v2)
+{
+  BinaryReturn< OLattice<TVec>, OLattice<TVec>, FnInnerProduct>::Type_t lprod;
+
+  // Inner product is accumulated internally in DOUBLE
+  DOUBLE ip[2];
+  ip[0] = 0;
+  ip[1] = 0;
+
+  if (v1.checkerboard() == v2.checkerboard())
+    l_vcdot(&(ip[0]), &(ip[1]),
+	    CBLatticeInternal::realPtr(v1), CBLatticeInternal::realPtr(v2),
+	    v1.numSites());
+
+  QDPInternal::globalSumArray(ip,2);
+
+  lprod.elem().elem().elem().real() = ip[0];
+  lprod.elem().elem().elem().imag() = ip[1];
+  return lprod;
+}
+
+// Global real part of the inner product of checkerboarded vectors
+template<>
+inline BinaryReturn< OLattice<TVec>, OLattice<TVec>, FnInnerProductReal>::Type_t
+innerProductReal(const OCBLattice< TVec >& v1, const OCBLattice< TVec >& v2)
+{
+  BinaryReturn< OLattice<TVec>, OLattice<TVec>, FnInnerProductReal>::Type_t lprod;
+
+  DOUBLE ip_re = 0;
+
+  if (v1.checkerboard() == v2.checkerboard())
+    l_vcdot_real(&ip_re,
+		 CBLatticeInternal::realPtr(v1), CBLatticeInternal::realPtr(v2),
+		 v1.numSites());
+
+  QDPInternal::globalSum(ip_re);
+
+  lprod.elem().elem().elem().elem() = ip_re;
+  return lprod;
+}
+
+} // namespace QDP
+
+#endif
@@ -87,16 +87,14 @@ void evaluate(OLattice< TVec >& d,
   
   REAL32 ar = a.elem().elem().elem().elem();
   REAL32* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32* xptr = (REAL32 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32* xptr = (REAL32 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL32* yptr = &(d.elem(0).elem(0).elem(0).real());
     // cout << "Specialised axpy a ="<< ar << endl;
 
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {yptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -154,15 +152,13 @@ void evaluate(OLattice< TVec >& d,
   // - sign as y -= ax <=> y = y-ax = -ax + y = axpy with -a 
   REAL32 ar = -( a.elem().elem().elem().elem());
   REAL32* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32* xptr = (REAL32 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32* xptr = (REAL32 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL32* yptr = &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {yptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -232,16 +228,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -315,16 +309,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -395,17 +387,15 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
     
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxmy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -476,16 +466,14 @@ void evaluate( OLattice< TVec > &d,
   // -ve sign as y - ax = -ax + y  = axpy with -a.
   REAL32 ar =  -a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep()) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -538,16 +526,14 @@ void evaluate(OLattice< TVec >& d,
   
   REAL32 ar = a.elem().elem().elem().elem();
   REAL32* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL32* xptr = (REAL32 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL32* xptr = (REAL32 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL32* yptr = &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {yptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -601,16 +587,14 @@ void evaluate(OLattice< TVec >& d,
   // - sign as y -= ax <=> y = y-ax = -ax + y = axpy with -a 
   REAL32 ar = -( a.elem().elem().elem().elem());
   REAL32* aptr = &ar;
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
 
-    REAL32* xptr = (REAL32 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL32* xptr = (REAL32 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL32* yptr = &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {yptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -680,16 +664,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -760,16 +742,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) {
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -918,16 +898,14 @@ void evaluate( OLattice< TVec > &d,
   // -ve sign as y - ax = -ax + y  = axpy with -a.
   REAL32 ar =  -a.elem().elem().elem().elem();
   REAL32 *aptr = (REAL32 *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpy3_user_arg arg = {zptr, aptr, xptr, yptr, vaxpy3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpy3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy3_evaluate_function);
     
     ////////////////
     // Original code
@@ -980,16 +958,14 @@ void evaluate( OLattice< TVec > &d,
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
 
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vOp_user_arg arg = {zptr, xptr, yptr, vadd};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vOp_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vOp_evaluate_function);
     
     ////////////////
     // Original code
@@ -1042,16 +1018,14 @@ void evaluate( OLattice< TVec > &d,
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
 
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vOp_user_arg arg = {zptr, xptr, yptr, vsub};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vOp_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vOp_evaluate_function);
     
     ////////////////
     // Original code
@@ -1106,15 +1080,13 @@ void evaluate( OLattice< TVec > &d,
 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = &ar;  
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vscal_user_arg arg = {zptr, aptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vscal_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1166,15 +1138,13 @@ void evaluate( OLattice< TVec > &d,
 
   REAL32 ar =  a.elem().elem().elem().elem();
   REAL32 *aptr = &ar;  
-  if( s.hasOrderedRep() ) {
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vscal_user_arg arg = {zptr, aptr, xptr};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vscal_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1227,15 +1197,13 @@ void evaluate( OLattice< TVec > &d,
 #endif
   
   REAL32 ar = a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) { 
-    REAL32 * xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 * xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL32 * zptr = xptr;
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vscal_user_arg arg = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vscal_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1285,15 +1253,13 @@ void evaluate( OLattice< TVec > &d,
 #endif
   
   REAL32 ar = (REAL)1/a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) {
-    REAL32 * xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL32 * xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL32 * zptr = xptr;
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vscal_user_arg arg = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vscal_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal_evaluate_function);
     
     ////////////////
     // Original code
@@ -1401,16 +1367,14 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: v -= v" << endl;
 #endif
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
     //int n_3vec = (s.end() - s.start()+1)*24;
-    REAL32 *xptr = (REAL32 *)(&x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *)(&d.elem(s.start()).elem(0).elem(0).real());
+    REAL32 *xptr = (REAL32 *)(&x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *)(&d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vOp_user_arg arg = {yptr, yptr, xptr, vsub};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vOp_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vOp_evaluate_function);
     
     ////////////////
     // Original code
@@ -1486,16 +1450,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
      
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1581,16 +1543,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1682,17 +1642,15 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1771,16 +1729,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1860,16 +1816,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -1958,16 +1912,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -2060,16 +2012,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 * zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 * zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
@@ -2149,16 +2099,14 @@ void evaluate( OLattice< TVec > &d,
   // Set pointers 
   REAL32 *aptr = (REAL32 *)&(a.elem().elem().elem().elem());
   REAL32 *bptr = (REAL32 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
-    REAL32 *xptr = (REAL32 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *yptr = (REAL32 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL32 *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL32 *xptr = (REAL32 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL32 *yptr = (REAL32 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL32 *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_3vec = (s.end()-s.start()+1);
-
     ordered_sse_vaxOpby3_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmby3};
 
-    dispatch_to_threads(total_n_3vec, arg, ordered_sse_vaxOpby3_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpby3_evaluate_function);
     
     ////////////////
     // Original code
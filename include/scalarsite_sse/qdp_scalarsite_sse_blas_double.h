@@ -85,15 +85,13 @@ void evaluate(OLattice< DVec >& d,
   REAL64 ar = a.elem().elem().elem().elem();
   REAL64* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL64* xptr = (REAL64 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64* xptr = (REAL64 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL64* yptr = &(d.elem(0).elem(0).elem(0).real());
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -145,15 +143,13 @@ void evaluate(OLattice< DVec >& d,
   // - sign as y -= ax <=> y = y-ax = -ax + y = axpy with -a 
   REAL64 ar = -( a.elem().elem().elem().elem());
   REAL64* aptr = &ar;
-  if( s.hasOrderedRep() ) { 
-    REAL64* xptr = (REAL64 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = s.end()-s.start()+1;
+  if( s.hasRunRep() ) { 
+    REAL64* xptr = (REAL64 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL64* yptr = &(d.elem(0).elem(0).elem(0).real());
 
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -224,21 +220,19 @@ void evaluate( OLattice< DVec > &d,
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
     
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     //    int n_4vec = (s.end()-s.start()+1);    
     
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
       // y = ax + y => AXPY
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -249,7 +243,7 @@ void evaluate( OLattice< DVec > &d,
       // z = ax + y => AXPYZ
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -322,21 +316,19 @@ void evaluate( OLattice< DVec > &d,
   // Set pointers 
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
       // y = y + ax 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -348,7 +340,7 @@ void evaluate( OLattice< DVec > &d,
 
 	ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 	
-	dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+	dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
 	
 	////////////////
 	// Original code
@@ -417,22 +409,20 @@ void evaluate( OLattice< DVec > &d,
   // Set pointers 
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
-  if( s.hasOrderedRep() ) {
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-    
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxmy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -443,7 +433,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxmyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -512,23 +502,21 @@ void evaluate( OLattice< DVec > &d,
   // -ve sign as y - ax = -ax + y  = axpy with -a.
   REAL64 ar =  -a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -539,7 +527,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -593,16 +581,14 @@ void evaluate(OLattice< DVec >& d,
   REAL64 ar = a.elem().elem().elem().elem();
   REAL64* aptr = &ar;
   
-  if( s.hasOrderedRep() ) { 
-    REAL64* xptr = (REAL64 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64* xptr = (REAL64 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL64* yptr = &(d.elem(0).elem(0).elem(0).real());
     // cout << "Specialised axpy a ="<< ar << endl;
      
-    int total_n_4vec = s.end()-s.start()+1;
-
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -659,15 +645,13 @@ void evaluate(OLattice< DVec >& d,
   REAL64 ar = -( a.elem().elem().elem().elem());
   REAL64* aptr = &ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL64* xptr = (REAL64 *)&(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64* yptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64* xptr = (REAL64 *)&(x.elem(0).elem(0).elem(0).real());
+    REAL64* yptr = &(d.elem(0).elem(0).elem(0).real());
         
-    int total_n_4vec = s.end()-s.start()+1;
-
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -737,23 +721,21 @@ void evaluate( OLattice< DVec > &d,
   // Set pointers 
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-    
     if( zptr == yptr ) {
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -764,7 +746,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -838,21 +820,19 @@ void evaluate( OLattice< DVec > &d,
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
 
-  if( s.hasOrderedRep() ) {
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -862,7 +842,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -933,22 +913,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxmy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -959,7 +937,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxmyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1031,23 +1009,21 @@ void evaluate( OLattice< DVec > &d,
   REAL64 ar =  -a.elem().elem().elem().elem();
   REAL64 *aptr = (REAL64 *)&ar;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, aptr, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1058,7 +1034,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, aptr, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1113,22 +1089,20 @@ void evaluate( OLattice< DVec > &d,
 
   REAL64 one = 1;
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
 
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, &one, xptr, vaxpy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1139,7 +1113,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, &one, xptr, yptr, vaxpyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1193,22 +1167,20 @@ void evaluate( OLattice< DVec > &d,
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&>(rhs.expression().right());
   REAL64 one=1;
 
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpy4_double_user_arg arg = {yptr, &one, xptr, vaxmy4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1219,7 +1191,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpyz4_double_user_arg arg = {zptr, &one, xptr, yptr, vaxmyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpyz4_double_evaluate_function);
       
       ////////////////
       // Original code
@@ -1340,15 +1312,13 @@ void evaluate( OLattice< DVec > &d,
   REAL64 ar =  a.elem().elem().elem().elem();
   REAL64 *aptr = &ar;  
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *zptr =  &(d.elem(0).elem(0).elem(0).real());
     
-    int total_n_4vec = s.end()-s.start()+1;
-
     ordered_sse_vscal4_double_user_arg arg = {zptr,aptr,xptr};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vscal4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -1398,16 +1368,14 @@ void evaluate( OLattice< DVec > &d,
 #endif
   
   REAL64 ar = a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64* xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64* xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL64* zptr = xptr;
     
-    int total_n_4vec = s.end()-s.start()+1;
-
     ordered_sse_vscal4_double_user_arg arg = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vscal4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -1458,15 +1426,13 @@ void evaluate( OLattice< DVec > &d,
 #endif
   
   REAL64 ar = (REAL64)1/a.elem().elem().elem().elem();
-  if( s.hasOrderedRep() ) { 
-    REAL64* xptr = &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64* xptr = &(d.elem(0).elem(0).elem(0).real());
     REAL64* zptr = xptr;
     
-    int total_n_4vec = s.end()-s.start()+1;
-
     ordered_sse_vscal4_double_user_arg arg = {zptr, &ar, xptr};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vscal4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vscal4_double_evaluate_function);
     
     ////////////////
     // Original code
@@ -1519,17 +1485,15 @@ void evaluate( OLattice< DVec > &d,
 #endif
   REAL64 one = 1;
 
-  if( s.hasOrderedRep() ) {
+  if( s.hasRunRep() ) {
 
     
-    REAL64 *xptr = (REAL64 *)(&x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *)(&d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = s.end()-s.start()+1;
+    REAL64 *xptr = (REAL64 *)(&x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *)(&d.elem(0).elem(0).elem(0).real());
 
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, &one, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
     ////////////////
     // Original code
@@ -1584,16 +1548,14 @@ void evaluate( OLattice< DVec > &d,
 #endif
   REAL64 mone = (REAL64)-1;
     
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *)(&x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *)(&d.elem(s.start()).elem(0).elem(0).real());
-
-    int total_n_4vec = s.end()-s.start()+1;
+    REAL64 *xptr = (REAL64 *)(&x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *)(&d.elem(0).elem(0).elem(0).real());
 
     ordered_sse_vaxOpy4_double_user_arg arg = {yptr, &mone, xptr, vaxpy4};
 
-    dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpy4_double_evaluate_function);
+    dispatch_to_runs(s, arg, ordered_sse_vaxOpy4_double_evaluate_function);
       
     ////////////////
     // Original code
@@ -1673,21 +1635,19 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr,bptr, vaxpby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -1698,7 +1658,7 @@ void evaluate( OLattice< DVec > &d,
 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -1790,22 +1750,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
   
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr,bptr, vaxpby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -1815,7 +1773,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -1911,22 +1869,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
 
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxpby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -1936,7 +1892,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2023,21 +1979,19 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxpby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2047,7 +2001,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxpbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2134,22 +2088,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) {
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) {
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
 
 
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxmby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2159,7 +2111,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2252,22 +2204,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
   
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxmby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2277,7 +2227,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2375,22 +2325,20 @@ void evaluate( OLattice< DVec > &d,
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
 
-  if( s.hasOrderedRep() ) { 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+  if( s.hasRunRep() ) { 
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
     
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxmby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2400,7 +2348,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2486,23 +2434,21 @@ void evaluate( OLattice< DVec > &d,
   // Set pointers 
   REAL64 *aptr = (REAL64 *)&(a.elem().elem().elem().elem());
   REAL64 *bptr = (REAL64 *)&(b.elem().elem().elem().elem());
-  if( s.hasOrderedRep() ) { 
+  if( s.hasRunRep() ) { 
 
-    REAL64 *xptr = (REAL64 *) &(x.elem(s.start()).elem(0).elem(0).real());
-    REAL64 *yptr = (REAL64 *) &(y.elem(s.start()).elem(0).elem(0).real());
-    REAL64* zptr =  &(d.elem(s.start()).elem(0).elem(0).real());
+    REAL64 *xptr = (REAL64 *) &(x.elem(0).elem(0).elem(0).real());
+    REAL64 *yptr = (REAL64 *) &(y.elem(0).elem(0).elem(0).real());
+    REAL64* zptr =  &(d.elem(0).elem(0).elem(0).real());
     
 
     // Get the no of 3vecs. s.start() and s.end() are inclusive so add +1
     //int n_4vec = (s.end()-s.start()+1);
 
-    int total_n_4vec = s.end()-s.start()+1;
-   
     if( zptr == yptr ) { 
 
       ordered_sse_vaxOpby4_double_user_arg arg = {yptr, aptr, xptr, bptr, vaxmby4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpby4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpby4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -2512,7 +2458,7 @@ void evaluate( OLattice< DVec > &d,
     else { 
       ordered_sse_vaxOpbyz4_double_user_arg arg = {zptr, aptr, xptr, bptr, yptr, vaxmbyz4};
 
-      dispatch_to_threads(total_n_4vec, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
+      dispatch_to_runs(s, arg, ordered_sse_vaxOpbyz4_double_evaluate_function);
 
       ////////////////
       // Original code
@@ -3,50 +3,120 @@
  */
 
 #include "qdp.h"
-
-#if defined(QDP_DEBUG_MEMORY)
-#include <stack>
-#endif
+#include <vector>
+#include <algorithm>
 
 
 namespace QDP {
 namespace Allocator {
- 
-#if defined(QDP_DEBUG_MEMORY)
+
   // Struct to hold in map
   struct MapVal {
-    MapVal(unsigned char* u, const std::string& f, int l, size_t b) : 
-      unaligned(u), func(f), line(l), bytes(b) {}
+    MapVal(unsigned char* u, int t, size_t b) :
+      unaligned(u), tag(t), bytes(b) {}
 
     unsigned char* unaligned;
-    std::string    func;
-    int            line;
+    int            tag;
     size_t         bytes;
   };
 
   // Convenience typedefs to save typing
 
   // The type of the map to hold the aligned unaligned values
-  typedef map<unsigned char*, MapVal> MapT;
+  typedef std::map<unsigned char*, MapVal> MapT;
+
+  //! Use of memory by one caller or one size class
+  struct UseStats {
+    size_t current;   // bytes held now
+    size_t peak;      // most bytes held at any time
+    size_t at_peak;   // bytes held when the node reached its peak
+    size_t live;      // allocations not yet freed
+    size_t allocs;    // allocations made
+  };
 
   // Func info
   struct FuncInfo_t {
     FuncInfo_t(const char* f, int l) : func(f), line(l) {}
 
-    std::string  func;
+    const char*  func;
     int          line;
   };
 
-  // A stack to hold fun info
-  std::stack<FuncInfo_t> infostack;
-#else
-  typedef std::map<unsigned char*, unsigned char *> MapT;
-
-#endif
+  // Number of size classes, one per power of two
+  const int num_sizes = 8*sizeof(size_t);
 
   // Anonymous namespace
+  //
+  // The counters are updated with the alignment map, which is only
+  // used by the master thread, so they take no lock. A caller is
+  // identified by the address of its name, so tagging costs a lookup
+  // in a small map and no string.
   namespace {
     MapT the_alignment_map;
+
+    std::vector<FuncInfo_t> tags;
+    std::vector<UseStats> by_tag;
+    std::map<std::pair<const char*,int>, int> tag_ids;
+    std::vector<int> infostack;
+
+    UseStats by_size[num_sizes];
+    MemoryStats totals;
+
+    //! Size class of an allocation
+    int sizeClass(size_t n)
+    {
+      int k = 0;
+      while (n > 1)
+      {
+	n >>= 1;
+	++k;
+      }
+      return k;
+    }
+
+    void addUse(UseStats& u, size_t bytes)
+    {
+      u.current += bytes;
+      u.live++;
+      u.allocs++;
+      u.peak = std::max(u.peak, u.current);
+    }
+
+    void removeUse(UseStats& u, size_t bytes)
+    {
+      u.current -= bytes;
+      u.live--;
+    }
+
+    //! Remember who holds the memory at a new peak of the node
+    /*! Walks every caller and size class, so only done when the memory
+     *  profile is on */
+    void markPeak()
+    {
+      for(size_t i=0; i < by_tag.size(); ++i)
+	by_tag[i].at_peak = by_tag[i].current;
+
+      for(int i=0; i < num_sizes; ++i)
+	by_size[i].at_peak = by_size[i].current;
+    }
+
+    int tagId(const char* func, int line)
+    {
+      std::pair<const char*,int> key(func, line);
+      std::map<std::pair<const char*,int>, int>::const_iterator p = tag_ids.find(key);
+      if (p != tag_ids.end())
+	return p->second;
+
+      UseStats u = {0, 0, 0, 0, 0};
+      tags.push_back(FuncInfo_t(func, line));
+      by_tag.push_back(u);
+
+      int id = tags.size() - 1;
+      tag_ids.insert(std::make_pair(key, id));
+      return id;
+    }
+
+    const double mega = 1.0 / (1024.0*1024.0);
   }
 
   // The type returned on map insertion, allows me to check
@@ -59,7 +129,7 @@ namespace Allocator {
   //! So we simply ignore the memory pool hint.
   void*
   QDPDefaultAllocator::allocate(size_t n_bytes,const MemoryPoolHint& mem_pool_hint) {
-    
+
     //! The raw unaligned pointer returned by the allocator
     unsigned char *unaligned;
 
@@ -68,16 +138,16 @@ namespace Allocator {
 
     size_t bytes_to_alloc;
     bytes_to_alloc = n_bytes;
-    if ( n_bytes % (32*1024) == 0 ) { 
+    if ( n_bytes % (32*1024) == 0 ) {
       bytes_to_alloc += 0; // 2 lines bytes to kill cache aliasing
     }
     bytes_to_alloc += QDP_ALIGNMENT_SIZE;
 
     // Try and allocate the memory
-    try { 
+    try {
       unaligned = new unsigned char[ bytes_to_alloc ];
     }
-    catch( std::bad_alloc ) { 
+    catch( std::bad_alloc ) {
       QDPIO::cerr << "Unable to allocate memory in allocate()" << std::endl;
       throw;  // Re throw the bad alloc is the correct behaviour
 
@@ -86,64 +156,139 @@ namespace Allocator {
     // Work out the aligned pointer
     aligned = (unsigned char *)( ( (unsigned long)unaligned + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
 
-#if defined(QDP_DEBUG_MEMORY)
     // Current location
-    FuncInfo_t& info = infostack.top();
+    int tag = infostack.back();
 
     // Insert into the map
     InsertRetVal r = the_alignment_map.insert(
-      make_pair(aligned, MapVal(unaligned, info.func, info.line, bytes_to_alloc)));
-#else
-    // Insert into the map
-    InsertRetVal r = the_alignment_map.insert(std::make_pair(aligned, unaligned));
-#endif
+      std::make_pair(aligned, MapVal(unaligned, tag, bytes_to_alloc)));
 
     // Check success of insertion.
-    if( ! r.second ) { 
+    if( ! r.second ) {
       QDPIO::cerr << "Failed to insert (unaligned,aligned) pair into map" << std::endl;
       QDP_abort(1);
     }
 
+    // Account
+    addUse(by_tag[tag], bytes_to_alloc);
+    addUse(by_size[sizeClass(bytes_to_alloc)], bytes_to_alloc);
+
+    totals.current_bytes += bytes_to_alloc;
+    totals.live_objects++;
+    totals.total_allocs++;
+    if (totals.current_bytes > totals.peak_bytes)
+    {
+      totals.peak_bytes = totals.current_bytes;
+      if (getMemoryProfile())
+	markPeak();
+    }
+
     // Return the aligned pointer
     return (void *)aligned;
   }
 
 
   //! Free an aligned pointer, which was allocated by us.
-  void 
-  QDPDefaultAllocator::free(void *mem) { 
-    unsigned char* unaligned; 
+  void
+  QDPDefaultAllocator::free(void *mem) {
+    unsigned char* unaligned;
 
-    // Look up the original unaligned pointer in the memory. 
+    // Look up the original unaligned pointer in the memory.
     MapT::iterator iter = the_alignment_map.find((unsigned char*)mem);
-    if( iter != the_alignment_map.end() ) 
-    { 
-#if defined(QDP_DEBUG_MEMORY)
+    if( iter != the_alignment_map.end() )
+    {
       // Find the original unaligned pointer
       unaligned = iter->second.unaligned;
-#else
-      // Find the original unaligned pointer
-      unaligned = iter->second;
-#endif
-      
+
+      // Account
+      size_t bytes = iter->second.bytes;
+      removeUse(by_tag[iter->second.tag], bytes);
+      removeUse(by_size[sizeClass(bytes)], bytes);
+
+      totals.current_bytes -= bytes;
+      totals.live_objects--;
+
       // Remove its entry from the map
       the_alignment_map.erase(iter);
 
       // Delete the actual unaligned pointer
       delete [] unaligned;
     }
-    else { 
+    else {
       QDPIO::cerr << "Pointer not found in map" << std::endl;
       QDP_abort(1);
     }
   }
 
 
-#if defined(QDP_DEBUG_MEMORY)
+  //! Current and peak use of memory
+  MemoryStats
+  QDPDefaultAllocator::getStats() const
+  {
+    return totals;
+  }
+
+
+  //! Print the use of memory by allocation size and by caller
+  void
+  QDPDefaultAllocator::printStats()
+  {
+    QDPIO::cout << std::endl << "QDP memory: current "
+		<< totals.current_bytes*mega << " MB, peak " << totals.peak_bytes*mega << " MB, "
+		<< totals.live_objects << " live objects, " << totals.total_allocs << " allocations"
+		<< std::endl;
+
+    char head[200], lin[200];
+    sprintf(head, "  %12s %12s %12s %10s %10s  ",
+	    "at peak[MB]", "current[MB]", "peak[MB]", "live", "allocs");
+
+    // Callers, ordered by what they held at the peak. That is only
+    // recorded with the memory profile on, otherwise by their own peak
+    const bool at_peak = getMemoryProfile();
+    if (! at_peak)
+      QDPIO::cout << "  (holdings at the peak are recorded with -pmem)" << std::endl;
+
+    std::vector< std::pair<size_t,int> > order;
+    for(size_t i=0; i < by_tag.size(); ++i)
+      if (by_tag[i].allocs > 0)
+	order.push_back(std::make_pair(at_peak ? by_tag[i].at_peak : by_tag[i].peak, int(i)));
+
+    std::sort(order.rbegin(), order.rend());
+
+    QDPIO::cout << head << "caller" << std::endl;
+    for(size_t k=0; k < order.size(); ++k)
+    {
+      const UseStats& u = by_tag[order[k].second];
+      const FuncInfo_t& f = tags[order[k].second];
+
+      sprintf(lin, "  %12.3f %12.3f %12.3f %10lu %10lu  ",
+	      u.at_peak*mega, u.current*mega, u.peak*mega,
+	      (unsigned long)u.live, (unsigned long)u.allocs);
+      QDPIO::cout << lin << f.func << ":" << f.line << std::endl;
+    }
+
+    QDPIO::cout << head << "size" << std::endl;
+    for(int i=0; i < num_sizes; ++i)
+    {
+      const UseStats& u = by_size[i];
+      if (u.allocs == 0)
+	continue;
+
+      sprintf(lin, "  %12.3f %12.3f %12.3f %10lu %10lu  ",
+	      u.at_peak*mega, u.current*mega, u.peak*mega,
+	      (unsigned long)u.live, (unsigned long)u.allocs);
+      QDPIO::cout << lin << "[2^" << i << ",2^" << i+1 << ") bytes" << std::endl;
+    }
+  }
+
+
   //! Dump the map
   void
   QDPDefaultAllocator::dump()
   {
+    printStats();
+
+#if defined(QDP_DEBUG_MEMORY)
      if ( Layout::primaryNode() )
      {
        size_t sum = 0;
@@ -152,32 +297,35 @@ namespace Allocator {
        for( CI j = the_alignment_map.begin();
              j != the_alignment_map.end(); j++)
        {
+	 const FuncInfo_t& f = tags[j->second.tag];
 	 sum += j->second.bytes;
-         printf("mem= 0x%x  bytes= %d  bytes/site= %d  line= %d  func= %s\n", j->first, 
-                j->second.bytes, j->second.bytes/Layout::sitesOnNode(), j->second.line, j->second.func.c_str());
+         printf("mem= 0x%lx  bytes= %lu  bytes/site= %lu  line= %d  func= %s\n", (unsigned long)j->first,
+                (unsigned long)j->second.bytes, (unsigned long)(j->second.bytes/Layout::sitesOnNode()),
+		f.line, f.func);
        }
-       printf("total bytes= %d\n", sum);
+       printf("total bytes= %lu\n", (unsigned long)sum);
      }
+#endif
   }
 
   // Setter
   void
   QDPDefaultAllocator::pushFunc(const char* func, int line)
   {
-    infostack.push(FuncInfo_t(func,line));
+    infostack.push_back(tagId(func,line));
   }
 
   // Nuker
   void
   QDPDefaultAllocator::popFunc()
   {
-    if (infostack.empty())
+    if (infostack.size() <= 1)
     {
       QDPIO::cerr << __func__ << ": invalid pop" << std::endl;
       QDP_abort(1);
     }
-  
-    infostack.pop();
+
+    infostack.pop_back();
   }
 
 
@@ -187,41 +335,8 @@ namespace Allocator {
   void
   QDPDefaultAllocator::init()
   {
-    infostack.push(FuncInfo_t(nowhere,0));
+    infostack.push_back(tagId(nowhere,0));
   }
 
-#else
-
-  //! Dump the map
-  void
-  QDPDefaultAllocator::dump()
-  {
-     if ( Layout::primaryNode() )
-     {
-       typedef MapT::const_iterator CI;
-       QDPIO::cout << "Dumping memory map" << std::endl;
-       for( CI j = the_alignment_map.begin();
-             j != the_alignment_map.end(); j++)
-       {
-         printf("mem= 0x%lx  unaligned= 0x%lx\n", (unsigned long)j->first, 
-		(unsigned long)j->second);
-       }
-     }
-  }
-
-  // Setter
-  void
-  QDPDefaultAllocator::pushFunc(const char* func, int line) {}
-
-  // Nuker
-  void
-  QDPDefaultAllocator::popFunc() {}
-
-  // Init
-  void
-  QDPDefaultAllocator::init() {}
-
-#endif
-
 } // namespace Allocator
 } // namespace QDP
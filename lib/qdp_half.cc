@@ -0,0 +1,130 @@
+//
+/*! @file
+ * @brief Half precision (REAL16) word conversions
+ *
+ * Uses the F16C conversion instructions when the compiler targets them,
+ * otherwise falls back to the bit manipulation routines in REAL16.
+ */
+
+#include "qdp.h"
+#include <cmath>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace QDP {
+
+//! Double to float rounding to odd
+/*!
+ * Rounding a double to float and then to half can round twice: a value
+ * just off a half precision tie lands on it. With the inexact floats
+ * made odd the rounding to half sees which side of the tie it was on.
+ */
+static inline float roundOddFloat(double x)
+{
+  float f = float(x);
+  if (double(f) != x && f == f)
+  {
+    union {float f; unsigned int u;} v;
+    v.f = f;
+    if (std::fabs(double(f)) > std::fabs(x))
+      --v.u;                               // toward zero
+    v.u |= 1u;
+    f = v.f;
+  }
+  return f;
+}
+
+
+void convertWords(REAL16* d, const REAL32* s, int n)
+{
+  int i = 0;
+#if defined(__F16C__)
+  for(; i+8 <= n; i += 8)
+  {
+    __m256 v = _mm256_loadu_ps(s+i);
+    _mm_storeu_si128((__m128i*)(d+i), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+  }
+#endif
+  for(; i < n; ++i)
+    d[i].bits = REAL16::floatToBits(s[i]);
+}
+
+
+void convertWords(REAL16* d, const REAL64* s, int n)
+{
+  int i = 0;
+#if defined(__F16C__)
+  float f[8];
+  for(; i+8 <= n; i += 8)
+  {
+    for(int j=0; j < 8; ++j)
+      f[j] = roundOddFloat(s[i+j]);
+    _mm_storeu_si128((__m128i*)(d+i), _mm256_cvtps_ph(_mm256_loadu_ps(f), _MM_FROUND_TO_NEAREST_INT));
+  }
+#endif
+  for(; i < n; ++i)
+    d[i].bits = REAL16::floatToBits(roundOddFloat(s[i]));
+}
+
+
+void convertWords(REAL32* d, const REAL16* s, int n)
+{
+  int i = 0;
+#if defined(__F16C__)
+  for(; i+8 <= n; i += 8)
+  {
+    __m128i h = _mm_loadu_si128((const __m128i*)(s+i));
+    _mm256_storeu_ps(d+i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for(; i < n; ++i)
+    d[i] = REAL16::bitsToFloat(s[i].bits);
+}
+
+
+void convertWords(REAL64* d, const REAL16* s, int n)
+{
+  int i = 0;
+#if defined(__F16C__)
+  for(; i+8 <= n; i += 8)
+  {
+    __m256 v = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(s+i)));
+    _mm256_storeu_pd(d+i,   _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+    _mm256_storeu_pd(d+i+4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+  }
+#endif
+  for(; i < n; ++i)
+    d[i] = REAL16::bitsToFloat(s[i].bits);
+}
+
+
+double localSumSq(const REAL16* s, int n)
+{
+  double sum = 0;
+  int i = 0;
+#if defined(__F16C__)
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  for(; i+8 <= n; i += 8)
+  {
+    __m256 v = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(s+i)));
+    __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+    __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(lo, lo));
+    acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(hi, hi));
+  }
+  double buf[4];
+  _mm256_storeu_pd(buf, _mm256_add_pd(acc0, acc1));
+  sum = (buf[0] + buf[1]) + (buf[2] + buf[3]);
+#endif
+  for(; i < n; ++i)
+  {
+    double x = REAL16::bitsToFloat(s[i].bits);
+    sum += x*x;
+  }
+  return sum;
+}
+
+} // namespace QDP
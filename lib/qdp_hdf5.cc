@@ -282,9 +282,12 @@ namespace QDP {
 		//measure
 		reordermap.resize(Layout::sitesOnNode());
 		
+		const Coord<Nd> nrow(Layout::lattSize());
+		Coord<Nd> coord;
+		
 		unsigned int run=0;
 		for(int site=0; site < Layout::vol(); ++site){
-			multi1d<int> coord = crtesn(site, Layout::lattSize());
+			crtesn(coord, site, nrow);
 			int node = Layout::nodeNumber(coord);
 
 			if(node==mynode){
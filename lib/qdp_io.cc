@@ -6,6 +6,8 @@
 #include "qdp.h"
 #include "qdp_byteorder.h"
 #include <complex>
+#include <thread>
+#include <algorithm>
 
 namespace QDP
 {
@@ -960,6 +962,170 @@ namespace QDP
   }
 
 
+  //--------------------------------------------------------------------------------
+  // Binary buffer reader local to each node
+  BinaryLocalBufferReader::BinaryLocalBufferReader() {checksum=0;}
+
+  // Construct from a string
+  BinaryLocalBufferReader::BinaryLocalBufferReader(const std::string& s) {open(s);}
+
+  BinaryLocalBufferReader::~BinaryLocalBufferReader() {}
+
+  void BinaryLocalBufferReader::open(const std::string& s)
+  {
+    f.clear();
+    f.str(s);
+    checksum = 0;
+  }
+
+  // Clear the stream
+  void BinaryLocalBufferReader::clear()
+  {
+    f.clear();
+    checksum = 0;
+  }
+
+  void BinaryLocalBufferReader::readArrayPrimaryNode(char* input, size_t size, size_t nmemb)
+  {
+    f.read(input, size*nmemb);
+    checksum = QDPUtil::crc32(checksum, input, size*nmemb);
+
+    if (! QDPUtil::big_endian())
+      QDPUtil::byte_swap(input, size, nmemb);
+  }
+
+  void BinaryLocalBufferReader::readArray(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNode(input, size, nmemb);
+  }
+
+  void BinaryLocalBufferReader::readArrayPrimaryNodeLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    f.read(input, size*nmemb);
+
+    if (QDPUtil::big_endian())
+      QDPUtil::byte_swap(input, size, nmemb);
+  }
+
+  void BinaryLocalBufferReader::readArrayLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNodeLittleEndian(input, size, nmemb);
+  }
+
+  void BinaryLocalBufferReader::readDesc(std::string& input)
+  {
+    int n;
+    readArray((char*)&n, sizeof(int), 1);
+
+    input.resize(n);
+    if (n > 0)
+      readArray(&input[0], sizeof(char), n);
+  }
+
+  void BinaryLocalBufferReader::read(std::string& input, size_t maxBytes)
+  {
+    std::getline(f, input);
+    if (input.size() >= maxBytes)
+      input.resize(maxBytes-1);
+
+    checksum = QDPUtil::crc32(checksum, input.data(), input.size());   // no string terminator
+    checksum = QDPUtil::crc32(checksum, "\n", 1);   // account for newline written
+  }
+
+  bool BinaryLocalBufferReader::fail()
+  {
+    return f.fail();
+  }
+
+  QDPUtil::n_uint32_t BinaryLocalBufferReader::getChecksum()
+  {
+    return checksum;
+  }
+
+  std::istream::pos_type BinaryLocalBufferReader::currentPosition()
+  {
+    return f.tellg();
+  }
+
+  void BinaryLocalBufferReader::seek(pos_type pos)
+  {
+    f.seekg(pos);
+    checksum = 0;
+  }
+
+  void BinaryLocalBufferReader::seekBegin(off_type off)
+  {
+    f.seekg(off, std::ios_base::beg);
+    checksum = 0;
+  }
+
+  void BinaryLocalBufferReader::seekRelative(off_type off)
+  {
+    f.seekg(off, std::ios_base::cur);
+    checksum = 0;
+  }
+
+  void BinaryLocalBufferReader::seekEnd(off_type off)
+  {
+    f.seekg(-off, std::ios_base::end);
+    checksum = 0;
+  }
+
+  void BinaryLocalBufferReader::rewind()
+  {
+    f.seekg(0, std::ios_base::beg);
+    checksum = 0;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  // Pipelined broadcast of blocks read on the primary node
+  namespace
+  {
+    //! Read ahead on a helper thread
+    void readAheadBlock(BinaryBlockSource* src, std::string* buf, bool* more)
+    {
+      *more = src->readBlock(*buf);
+    }
+  }
+
+  void broadcastBlocks(BinaryBlockSource& src)
+  {
+    std::string buf[2];
+    int cur = 0;
+
+    bool more = false;
+    if (Layout::primaryNode())
+      more = src.readBlock(buf[cur]);
+
+    for(;;)
+    {
+      QDPInternal::broadcast(more);
+      if (! more)
+	break;
+
+      std::string& now  = buf[cur];
+      std::string& next = buf[1-cur];
+      bool next_more = false;
+
+      // Only the file read runs on the helper thread. The broadcast and
+      // the use of the block, which may communicate, stay on this one.
+      std::thread reader;
+      if (Layout::primaryNode())
+	reader = std::thread(readAheadBlock, &src, &next, &next_more);
+
+      QDPInternal::broadcast_str(now);
+      src.useBlock(now);
+
+      if (reader.joinable())
+	reader.join();
+
+      more = next_more;
+      cur = 1 - cur;
+    }
+  }
+
+
 
   //--------------------------------------------------------------------------------
   // Binary reader support
@@ -1447,6 +1613,294 @@ namespace QDP
   BinaryFileWriter::~BinaryFileWriter() {close();}
 
 
+  //--------------------------------------------------------------------------------
+  // Binary writer local to each node
+  void BinaryLocalWriter::writeArrayPrimaryNode(const char* output, size_t size, size_t nmemb)
+  {
+    if (QDPUtil::big_endian())
+    {
+      internalChecksum() = QDPUtil::crc32(internalChecksum(), output, size*nmemb);
+      getOstream().write(output, size*nmemb);
+    }
+    else
+    {
+      // Swap and write and swap
+      QDPUtil::byte_swap(const_cast<char *>(output), size, nmemb);
+      internalChecksum() = QDPUtil::crc32(internalChecksum(), output, size*nmemb);
+      getOstream().write(output, size*nmemb);
+      QDPUtil::byte_swap(const_cast<char *>(output), size, nmemb);
+    }
+  }
+
+  void BinaryLocalWriter::writeArray(const char* output, size_t size, size_t nmemb)
+  {
+    writeArrayPrimaryNode(output, size, nmemb);
+  }
+
+  bool BinaryLocalWriter::fail()
+  {
+    return getOstream().fail();
+  }
+
+  QDPUtil::n_uint32_t BinaryLocalWriter::getChecksum()
+  {
+    return internalChecksum();
+  }
+
+  std::ostream::pos_type BinaryLocalWriter::currentPosition()
+  {
+    return getOstream().tellp();
+  }
+
+  void BinaryLocalWriter::seek(pos_type pos)
+  {
+    getOstream().seekp(pos);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalWriter::seekBegin(off_type off)
+  {
+    getOstream().seekp(off, std::ios_base::beg);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalWriter::seekRelative(off_type off)
+  {
+    getOstream().seekp(off, std::ios_base::cur);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalWriter::seekEnd(off_type off)
+  {
+    getOstream().seekp(-off, std::ios_base::end);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalWriter::rewind()
+  {
+    getOstream().seekp(0, std::ios_base::beg);
+    internalChecksum() = 0;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  // Binary buffer writer local to each node
+  BinaryLocalBufferWriter::BinaryLocalBufferWriter() {checksum=0;}
+
+  BinaryLocalBufferWriter::BinaryLocalBufferWriter(const std::string& s) {open(s);}
+
+  BinaryLocalBufferWriter::~BinaryLocalBufferWriter() {}
+
+  void BinaryLocalBufferWriter::open(const std::string& s)
+  {
+    f.str(s);
+    checksum = 0;
+  }
+
+  std::string BinaryLocalBufferWriter::str() const
+  {
+    return f.str();
+  }
+
+  void BinaryLocalBufferWriter::clear()
+  {
+    f.str(std::string());
+    f.clear();
+    checksum = 0;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  // Binary file writer local to each node
+  BinaryLocalFileWriter::BinaryLocalFileWriter() {checksum = 0;}
+
+  BinaryLocalFileWriter::BinaryLocalFileWriter(const std::string& p) {checksum = 0; open(p);}
+
+  void BinaryLocalFileWriter::open(const std::string& p) 
+  {
+    checksum = 0;
+    f.open(p.c_str(),std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+
+    if (! f.is_open())
+      QDP_error_exit("BinaryLocalFileWriter: error opening file %s",p.c_str());
+  }
+
+  void BinaryLocalFileWriter::close()
+  {
+    if (f.is_open())
+      f.close();
+  }
+
+  bool BinaryLocalFileWriter::is_open()
+  {
+    return f.is_open();
+  }
+
+  void BinaryLocalFileWriter::flush()
+  {
+    if (f.is_open())
+      f.flush();
+  }
+
+  BinaryLocalFileWriter::~BinaryLocalFileWriter() {close();}
+
+
+  //--------------------------------------------------------------------------------
+  // Binary file writer in the background
+  namespace
+  {
+    //! A file and its contents to write
+    struct AsyncFileTask
+    {
+      std::ofstream f;
+      BinaryChunkBuffer::Chunks_t data;
+      bool          ok;
+    };
+
+    std::thread    async_thread;
+    AsyncFileTask* async_task = 0;
+
+    void asyncFileWrite(AsyncFileTask* task)
+    {
+      for(size_t i=0; i < task->data.size(); ++i)
+      {
+	task->f.write(&(task->data[i][0]), task->data[i].size());
+	std::vector<char>().swap(task->data[i]);   // free as we go
+      }
+      task->f.close();
+      task->ok = ! task->f.fail();
+    }
+  }
+
+  // Chunked output buffer
+  void BinaryChunkBuffer::trim()
+  {
+    if (! chunks.empty())
+      chunks.back().resize(pptr() - pbase());
+  }
+
+  void BinaryChunkBuffer::release(Chunks_t& out)
+  {
+    trim();
+    out.clear();
+    out.swap(chunks);
+    setp(0, 0);
+  }
+
+  BinaryChunkBuffer::int_type BinaryChunkBuffer::overflow(int_type c)
+  {
+    // Start a new chunk
+    trim();
+    chunks.push_back(std::vector<char>(chunk_size));
+    char* p = &(chunks.back()[0]);
+    setp(p, p + chunk_size);
+
+    if (! traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize BinaryChunkBuffer::xsputn(const char* s, std::streamsize n)
+  {
+    std::streamsize done = 0;
+    while (done < n)
+    {
+      if (pptr() == epptr())
+	overflow(traits_type::eof());
+
+      std::streamsize m = std::min<std::streamsize>(n - done, epptr() - pptr());
+      memcpy(pptr(), s + done, m);
+      pbump(m);
+      done += m;
+    }
+    return done;
+  }
+
+  // Wait for the last background write
+  void waitCheckpoint()
+  {
+    bool ok = true;
+
+    if (Layout::primaryNode() && async_task != 0)
+    {
+      async_thread.join();
+      ok = async_task->ok;
+      delete async_task;
+      async_task = 0;
+    }
+
+    QDPInternal::broadcast(ok);
+
+    if (! ok)
+    {
+      QDPIO::cerr << "BinaryAsyncFileWriter: error writing file in the background" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  BinaryAsyncFileWriter::BinaryAsyncFileWriter() : out(&buf) {checksum = 0;}
+
+  BinaryAsyncFileWriter::BinaryAsyncFileWriter(const std::string& p) : out(&buf) {checksum = 0; open(p);}
+
+  void BinaryAsyncFileWriter::open(const std::string& p) 
+  {
+    // Only one file in the background
+    waitCheckpoint();
+
+    checksum = 0;
+    BinaryChunkBuffer::Chunks_t old;
+    buf.release(old);
+    out.clear();
+
+    if (Layout::primaryNode()) 
+      f.open(p.c_str(),std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+
+    if (! is_open())
+      QDP_error_exit("BinaryAsyncFileWriter: error opening file %s",p.c_str());
+  }
+
+  void BinaryAsyncFileWriter::close()
+  {
+    if (is_open())
+    {
+      // Another writer may have started a background write since our open
+      waitCheckpoint();
+
+      if (Layout::primaryNode()) 
+      {
+	async_task = new AsyncFileTask;
+	async_task->f.swap(f);
+	buf.release(async_task->data);
+	async_task->ok = false;
+
+	async_thread = std::thread(asyncFileWrite, async_task);
+      }
+    }
+  }
+
+  // Propagate status to all nodes
+  bool BinaryAsyncFileWriter::is_open()
+  {
+    bool s = QDP_isInitialized();
+
+    if (s)
+    {
+      if (Layout::primaryNode())
+	s = f.is_open();
+
+      QDPInternal::broadcast(s);
+    }
+
+    return s;
+  }
+
+  // Close the file
+  BinaryAsyncFileWriter::~BinaryAsyncFileWriter() {close();}
+
+
   //--------------------------------------------------------------------------------
   // Binary reader/writer support
   // Propagate status to all nodes
@@ -688,7 +688,7 @@ void writeArchiv(BinaryWriter& cfg_out, const multi1d<LatticeColorMatrix>& u,
  * \param u          gauge configuration ( Modify )
  * \param file       path ( Read )
  */    
-void writeArchiv(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, const std::string& file)
+static void writeArchiv(BinaryWriter& cfg_out, ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u)
 {
   Double w_plaq, link;
   mesplq(w_plaq, link, u);
@@ -696,11 +696,30 @@ void writeArchiv(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, co
   header.link = link;
   header.checksum = computeChecksum(u, header.mat_size);
 
-  BinaryFileWriter cfg_out(file);
-
   writeArchivHeader(cfg_out, header);   // write header
   writeArchiv(cfg_out, u, header.mat_size);  // continuing writing after header
+}
+
+void writeArchiv(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, const std::string& file)
+{
+  BinaryFileWriter cfg_out(file);
+  writeArchiv(cfg_out, header, u);
+  cfg_out.close();
+}
 
+
+// Write a QCD archive file in the background
+/*
+ * \ingroup io
+ *
+ * \param header     structure holding config info ( Modify )
+ * \param u          gauge configuration ( Read )
+ * \param file       path ( Read )
+ */    
+void writeArchivAsync(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, const std::string& file)
+{
+  BinaryAsyncFileWriter cfg_out(file);
+  writeArchiv(cfg_out, header, u);
   cfg_out.close();
 }
 
@@ -37,8 +37,61 @@ namespace QDP {
 			return physcoord;
 		}
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+		// The multi1d index functions go through the allocation free ones
+
+#if defined(ARCH_PARSCALAR)
+		//! Returns the logical node number for the corresponding lattice coordinate
+		int nodeNumber(const multi1d<int>& coord)
+		{
+			return nodeNumber(Coord<Nd>(coord));
+		}
+#endif
+
+		//! The linearized site index for the corresponding coordinate
+		int linearSiteIndex(const multi1d<int>& coord)
+		{
+			return linearSiteIndex(Coord<Nd>(coord));
+		}
+
+		//! Reconstruct the lattice coordinate from the node and site number
+		multi1d<int> siteCoords(int node, int linear)
+		{
+			Coord<Nd> coord;
+			siteCoords(coord, node, linear);
+			return coord.toMulti1d();
+		}
+#endif
+
+
 		extern "C" { 
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+			/* Export this to "C" */
+			void QDPXX_getSiteCoords(int coord[], int node, int linear) QDP_CONST {
+				Coord<Nd> wrapped_coords;
+				siteCoords(wrapped_coords, node, linear);
+				for(int i=0; i < Nd; i++) { 
+					coord[i] = wrapped_coords[i];
+				}
+			}
+    
+			int QDPXX_getLinearSiteIndex(const int coord[]) {
+				Coord<Nd> wrapped_coords;
+				for(int i=0; i < Nd; i++) { 
+					wrapped_coords[i]=coord[i];
+				}
+				return linearSiteIndex(wrapped_coords);
+			}
+
+			int QDPXX_nodeNumber(const int coord[]) {
+				Coord<Nd> wrapped_coords;
+				for(int i=0; i < Nd; i++) { 
+					wrapped_coords[i]=coord[i];
+				}
+				return nodeNumber(wrapped_coords);
+			}
+#else
 			/* Export this to "C" */
 			void QDPXX_getSiteCoords(int coord[], int node, int linear) QDP_CONST {
 				multi1d<int> wrapped_coords = siteCoords(node,linear);
@@ -62,6 +115,7 @@ namespace QDP {
 				}
 				return nodeNumber(wrapped_coords);
 			}
+#endif
 		}
 	}
 
@@ -48,6 +48,36 @@ void initDefaultMaps()
 }
 
 
+//! Name of a map in the communication counters
+std::string mapCommName(const MapFunc& func)
+{
+  const multi1d<int>& nrow = Layout::lattSize();
+  multi1d<int> origin(Nd);
+  origin = 0;
+
+  multi1d<int> fcoord = func(origin,+1);
+
+  std::ostringstream os;
+  os << "map(";
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    // Wrapped displacements are shown as the short way round
+    int d = fcoord[mu];
+    if (2*d > nrow[mu])
+      d -= nrow[mu];
+
+    if (mu > 0)
+      os << ",";
+    if (d > 0)
+      os << "+";
+    os << d;
+  }
+  os << ")";
+
+  return os.str();
+}
+
+
 //----------------------------------------------------------------------------
 // ArrayMap
 
@@ -6,6 +6,9 @@
 
 #include <errno.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <sstream>
 
 namespace QDP 
 { 
@@ -14,6 +17,33 @@ namespace QDP
     // Anonymous namespace
     namespace {
       const std::string file_magic="XXXXQDPLazyDiskMapObjFileXXXX";
+
+      //! File positions are kept in 16 bytes, as in MapObjectDisk
+      union pos16_t
+      {
+	unsigned char c[16];
+	uint64_t      p;
+      };
+
+      void writePos(BinaryWriter& bin, uint64_t p)
+      {
+	pos16_t pos;
+	memset(pos.c, 0, sizeof(pos16_t));
+	pos.p = p;
+	bin.writeArray((const char*)&pos, sizeof(pos16_t), 1);
+      }
+
+      uint64_t readPos(BinaryReader& bin)
+      {
+	pos16_t pos;
+	bin.readArray((char*)&pos, sizeof(pos16_t), 1);
+	return pos.p;
+      }
+
+      bool lessPos(const std::pair<std::string,uint64_t>& a, const std::pair<std::string,uint64_t>& b)
+      {
+	return a.second < b.second;
+      }
     };
 
     // Magic string at start of file.
@@ -25,20 +55,9 @@ namespace QDP
       BinaryFileReader reader;
       reader.open(filename);
 
-      std::string read_magic;
-      reader.readDesc(read_magic);
-    
-      // Check magic
-      if (read_magic != MapObjDiskEnv::file_magic) { 
-	QDPIO::cerr << "Magic String Wrong: Expected: " << MapObjDiskEnv::file_magic << " but read: " << read_magic << std::endl;
-	QDP_abort(1);
-      }
-
       MapObjDiskEnv::file_version_t read_version;
-      read(reader, read_version);
-      
       std::string user_data;
-      readDesc(reader, user_data);
+      readHeader(reader, filename, user_data, read_version);
     
       reader.close();
       return user_data;
@@ -65,6 +84,328 @@ namespace QDP
 
       return new_file;
     }
+
+
+    // Name of a shard file
+    std::string shardFileName(const std::string& base, int shard)
+    {
+      std::ostringstream name;
+      name << base << ".shard" << shard;
+      return name.str();
+    }
+
+
+    // The shard files that exist
+    std::vector<std::string> shardFiles(const std::string& base)
+    {
+      int num = 0;
+      if (Layout::primaryNode()) 
+      {
+	struct stat statbuf;
+	while (stat(shardFileName(base, num).c_str(), &statbuf) == 0)
+	  ++num;
+      }
+
+      QDPInternal::broadcast(num);
+
+      std::vector<std::string> files(num);
+      for(int i=0; i < num; ++i)
+	files[i] = shardFileName(base, i);
+
+      return files;
+    }
+
+
+    // Remove the shard files from first on
+    void removeShards(const std::string& base, int first)
+    {
+      if (Layout::primaryNode()) 
+      {
+	for(int i=first; unlink(shardFileName(base, i).c_str()) == 0; ++i)
+	  QDPIO::cout << __func__ << ": removed stale " << shardFileName(base, i) << std::endl;
+
+	if (errno == ENOENT)
+	  errno = 0;	/* In case someone looks at errno. */
+      }
+    }
+
+
+    // Header with a zero link to the metadata
+    void writeHeader(BinaryWriter& bin, const std::string& user_data, file_version_t version)
+    {
+      bin.writeDesc(file_magic);
+      write(bin, version);
+      writeDesc(bin, user_data);
+      writePos(bin, 0);
+    }
+
+
+    // Check the header and find the metadata
+    uint64_t readHeader(BinaryReader& bin, const std::string& file, std::string& user_data, 
+			file_version_t& version)
+    {
+      std::string read_magic;
+      bin.readDesc(read_magic);
+      if (read_magic != file_magic) { 
+	QDPIO::cerr << file << ": Magic String Wrong: Expected: " << file_magic << " but read: " << read_magic << std::endl;
+	QDP_abort(1);
+      }
+
+      read(bin, version);
+      readDesc(bin, user_data);
+      return readPos(bin);
+    }
+
+
+    // Start of the map
+    void writeMapSize(BinaryWriter& bin, unsigned int num_records)
+    {
+      bin.resetChecksum();
+      write(bin, num_records);
+    }
+
+
+    // One map entry
+    void writeMapEntry(BinaryWriter& bin, const std::string& key, uint64_t pos)
+    {
+      writeDesc(bin, key);
+      writePos(bin, pos);
+    }
+
+
+    // End of the map
+    void writeMapChecksum(BinaryWriter& bin)
+    {
+      write(bin, bin.getChecksum());
+    }
+
+
+    // Key/position map
+    void writeMap(BinaryWriter& bin, const std::vector< std::pair<std::string,uint64_t> >& map)
+    {
+      writeMapSize(bin, map.size());
+
+      for(std::vector< std::pair<std::string,uint64_t> >::const_iterator iter = map.begin(); iter != map.end(); ++iter)
+	writeMapEntry(bin, iter->first, iter->second);
+
+      writeMapChecksum(bin);
+    }
+
+
+    // Start of the map
+    unsigned int readMapSize(BinaryReader& bin, uint64_t md_start)
+    {
+      bin.seek(md_start);
+      bin.resetChecksum();
+
+      unsigned int num_records;
+      read(bin, num_records);
+      return num_records;
+    }
+
+
+    // One map entry
+    void readMapEntry(BinaryReader& bin, std::string& key, uint64_t& pos)
+    {
+      readDesc(bin, key);
+      pos = readPos(bin);
+    }
+
+
+    // End of the map
+    void readMapChecksum(BinaryReader& bin, const std::string& file)
+    {
+      QDPUtil::n_uint32_t calc_checksum = bin.getChecksum();
+      QDPUtil::n_uint32_t read_checksum;
+      read(bin, read_checksum);
+      if (read_checksum != calc_checksum) { 
+	QDPIO::cerr << file << ": Mismatched Checksums: Expected: " << calc_checksum << " but read " << read_checksum << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    // Key/position map
+    void readMap(BinaryReader& bin, const std::string& file, uint64_t md_start,
+		 std::vector< std::pair<std::string,uint64_t> >& map)
+    {
+      map.resize(readMapSize(bin, md_start));
+
+      for(size_t i=0; i < map.size(); ++i)
+	readMapEntry(bin, map[i].first, map[i].second);
+
+      readMapChecksum(bin, file);
+    }
+
+
+    // Link from the header to the map
+    void writeMapLink(BinaryWriter& bin, const std::string& user_data, uint64_t md_start)
+    {
+      bin.seek(file_magic.length() + sizeof(int) + sizeof(file_version_t)
+	       + user_data.length() + sizeof(int));
+      writePos(bin, md_start);
+      bin.seekEnd(0);
+      bin.flush();
+    }
+
+
+    // Merge files into one
+    void mergeFiles(const std::vector<std::string>& inputs, const std::string& output)
+    {
+      if (inputs.size() == 0) {
+	QDPIO::cerr << __func__ << ": no input files for " << output << std::endl;
+	QDP_abort(1);
+      }
+
+      BinaryFileWriter out(output);
+      std::string out_user_data;
+      std::vector< std::pair<std::string,uint64_t> > out_map;
+      std::unordered_map<std::string,size_t> seen;
+      uint64_t out_pos = 0;
+      std::vector<char> buf(1);
+
+      for(size_t f=0; f < inputs.size(); ++f)
+      {
+	QDPIO::cout << __func__ << ": copying " << inputs[f] << std::endl;
+
+	BinaryFileReader in(inputs[f]);
+	std::string user_data;
+	std::vector< std::pair<std::string,uint64_t> > map;
+	file_version_t version;
+	uint64_t md_start = readHeader(in, inputs[f], user_data, version);
+	readMap(in, inputs[f], md_start, map);
+
+	if (f == 0)
+	{
+	  out_user_data = user_data;
+	  writeHeader(out, out_user_data);
+	  out_pos = out.currentPosition();
+	}
+
+	// A record runs up to the next one or to the metadata. Copy in file order
+	std::sort(map.begin(), map.end(), lessPos);
+
+	for(size_t i=0; i < map.size(); ++i)
+	{
+	  uint64_t len = ((i+1 < map.size()) ? map[i+1].second : md_start) - map[i].second;
+
+	  if (! seen.insert(std::make_pair(map[i].first, f)).second)
+	    continue;
+
+	  if (Layout::primaryNode())
+	    buf.resize(len + 1);
+
+	  in.seek(map[i].second);
+	  in.readArrayPrimaryNode(&buf[0], 1, len);
+	  out.writeArrayPrimaryNode(&buf[0], 1, len);
+
+	  out_map.push_back(std::make_pair(map[i].first, out_pos));
+	  out_pos += len;
+	}
+
+	in.close();
+      }
+
+      writeMap(out, out_map);
+      writeMapLink(out, out_user_data, out_pos);
+      out.close();
+
+      QDPIO::cout << __func__ << ": wrote " << out_map.size() << " records to " << output << std::endl;
+    }
+
+
+    //--------------------------------------------------------------------------------
+    // Key writer
+    void KeyWriter::writeArrayPrimaryNode(const char* output, size_t size, size_t nmemb)
+    {
+      size_t off = out.size();
+      out.append(output, size*nmemb);
+
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(&out[off], size, nmemb);
+    }
+
+    void KeyWriter::writeArray(const char* output, size_t size, size_t nmemb)
+    {
+      writeArrayPrimaryNode(output, size, nmemb);
+    }
+
+
+    //--------------------------------------------------------------------------------
+    // Key reader
+    const char* KeyReader::take(size_t n)
+    {
+      if (bad || n > len - pos)
+      {
+	bad = true;
+	return 0;
+      }
+
+      const char* p = buf + pos;
+      pos += n;
+      return p;
+    }
+
+    void KeyReader::readArrayPrimaryNode(char* input, size_t size, size_t nmemb)
+    {
+      const char* p = take(size*nmemb);
+      if (p == 0)
+	return;
+
+      memcpy(input, p, size*nmemb);
+
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(input, size, nmemb);
+    }
+
+    void KeyReader::readArray(char* input, size_t size, size_t nmemb)
+    {
+      readArrayPrimaryNode(input, size, nmemb);
+    }
+
+    void KeyReader::readArrayPrimaryNodeLittleEndian(char* input, size_t size, size_t nmemb)
+    {
+      const char* p = take(size*nmemb);
+      if (p == 0)
+	return;
+
+      memcpy(input, p, size*nmemb);
+
+      if (QDPUtil::big_endian())
+	QDPUtil::byte_swap(input, size, nmemb);
+    }
+
+    void KeyReader::readArrayLittleEndian(char* input, size_t size, size_t nmemb)
+    {
+      readArrayPrimaryNodeLittleEndian(input, size, nmemb);
+    }
+
+    void KeyReader::readDesc(std::string& input)
+    {
+      int n = 0;
+      readArray((char*)&n, sizeof(int), 1);
+
+      const char* p = (n >= 0) ? take(n) : 0;
+      if (p == 0)
+      {
+	bad = true;
+	input.clear();
+	return;
+      }
+
+      input.assign(p, n);
+    }
+
+    void KeyReader::read(std::string& input, size_t maxBytes)
+    {
+      // A line, as written by write(BinaryWriter&, const std::string&)
+      const char* p = buf + pos;
+      const char* e = (const char*)memchr(p, '\n', len - pos);
+      size_t n = (e != 0) ? e - p : len - pos;
+
+      input.assign(p, (n < maxBytes) ? n : maxBytes-1);
+      pos += (e != 0) ? n+1 : n;
+    }
   }
     
 }
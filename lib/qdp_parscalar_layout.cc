@@ -58,6 +58,12 @@ namespace QDP
       //! Subgrid lattice size
       multi1d<int> subgrid_nrow;
 
+      //! Subgrid lattice size for the allocation free index functions
+      Coord<Nd> subgrid_nrow_c;
+
+      //! Logical coordinates of every node
+      multi1d< Coord<Nd> > node_coords;
+
       //! Logical node coordinates
       multi1d<int> logical_coord;
 
@@ -148,6 +154,11 @@ namespace QDP
     //! Return the smallest lattice size per node allowed
     multi1d<int> minimalLayoutMapping();
 
+#if QDP_USE_CB2_BLOCK_LAYOUT == 1
+    //! Fix the block size of the blocked layout for the current subgrid
+    void initBlockLayout();
+#endif
+
     //! Initializer for layout
     void init()
     {
@@ -165,7 +176,8 @@ namespace QDP
     //! The linearized site index for the corresponding lexicographic site
     int linearSiteIndex(int site)
     { 
-      multi1d<int> coord = crtesn(site, lattSize());
+      Coord<Nd> coord;
+      crtesn(coord, site, Coord<Nd>(lattSize()));
     
       return linearSiteIndex(coord);
     }
@@ -295,6 +307,8 @@ namespace QDP
 	_layout.subgrid_vol *= _layout.subgrid_nrow[i];
       }
 
+      _layout.subgrid_nrow_c = Coord<Nd>(_layout.subgrid_nrow);
+
       // Diagnostics
       QDPIO::cout << "Lattice initialized:\n";
       QDPIO::cout << "  problem size =";
@@ -328,7 +342,14 @@ namespace QDP
         QDPIO::cout << std::endl;
       } 
 
+#if QDP_USE_CB2_BLOCK_LAYOUT == 1
+      initBlockLayout();
+#endif
+
       // Sanity check - check the QMP node number functions
+      // and keep the node coordinates for siteCoords
+      _layout.node_coords.resize(Layout::numNodes());
+
       for(int node=0; node < Layout::numNodes(); ++node)
       { 
 	multi1d<int> coord = Layout::getLogicalCoordFrom(node);
@@ -336,6 +357,8 @@ namespace QDP
 
 	if (node != node2)
 	  QDP_error_exit("Layout::create - Layout problems, the QMP logical to physical node map functions do not work correctly with this lattice size");
+
+	_layout.node_coords[node] = Coord<Nd>(coord);
       }
 
       // Sanity check - check the layout functions make sense
@@ -384,44 +407,42 @@ namespace QDP
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is a simple lexicographic lattice ordering */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
-      multi1d<int> tmp_coord(Nd);
+      Coord<Nd> tmp_coord;
 
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] % Layout::subgridLattSize()[i];
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] % _layout.subgrid_nrow_c[i];
     
-      return local_site(tmp_coord, Layout::subgridLattSize());
+      return local_site(tmp_coord, _layout.subgrid_nrow_c);
     }
 
 
     //! The node number for the corresponding lattice coordinate
     /*! This layout is a simple lexicographic lattice ordering */
-    int nodeNumber(const multi1d<int>& coord)
+    int nodeNumber(const Coord<Nd>& coord)
     {
-      multi1d<int> tmp_coord(Nd);
+      Coord<Nd> tmp_coord;
 
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] / _layout.subgrid_nrow_c[i];
     
-      return Layout::getNodeNumberFrom(tmp_coord);
+      return QMP_get_node_number_from(tmp_coord.slice());
     }
 
 
     //! Returns the lattice site for some input node and linear index
     /*! This layout is a simple lexicographic lattice ordering */
-    multi1d<int> siteCoords(int node, int linear)
+    void siteCoords(Coord<Nd>& coord, int node, int linear)
     {
-      multi1d<int> coord = getLogicalCoordFrom(node);
-
-      // Get the base (origins) of the absolute lattice coord
-      coord *= Layout::subgridLattSize();
-    
-      // Find the coordinate within a node and accumulate
+      // Find the coordinate within a node
       // This is a lexicographic ordering
-      coord += crtesn(linear, Layout::subgridLattSize());
+      crtesn(coord, linear, _layout.subgrid_nrow_c);
 
-      return coord;
+      // Add on the base (origins) of the absolute lattice coord
+      const Coord<Nd>& node_coord = _layout.node_coords[node];
+      for(int i=0; i < Nd; ++i)
+	coord[i] += node_coord[i] * _layout.subgrid_nrow_c[i];
     }
 
 
@@ -446,10 +467,10 @@ namespace QDP
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] >>= 1;
 
       int cb = 0;
@@ -457,7 +478,7 @@ namespace QDP
 	cb += coord[m];
       cb &= 1;
 
-      multi1d<int> subgrid_cb_coord(Nd);
+      Coord<Nd> subgrid_cb_coord;
       subgrid_cb_coord[0] = (coord[0] >> 1) % subgrid_cb_nrow[0];
       for(int i=1; i < Nd; ++i)
 	subgrid_cb_coord[i] = coord[i] % subgrid_cb_nrow[i];
@@ -472,14 +493,14 @@ namespace QDP
      * but to find the nodeNumber this function resembles a simple lexicographic 
      * layout
      */
-    int nodeNumber(const multi1d<int>& coord)
+    int nodeNumber(const Coord<Nd>& coord)
     {
-      multi1d<int> tmp_coord(Nd);
+      Coord<Nd> tmp_coord;
 
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] / _layout.subgrid_nrow_c[i];
     
-      return Layout::getNodeNumberFrom(tmp_coord);
+      return QMP_get_node_number_from(tmp_coord.slice());
     }
 
 
@@ -488,18 +509,20 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] >>= 1;
 
       // Get the base (origins) of the absolute lattice coord
-      multi1d<int> coord = getLogicalCoordFrom(node);
-      coord *= Layout::subgridLattSize();
+      const Coord<Nd>& node_coord = _layout.node_coords[node];
+      for(int i=0; i < Nd; ++i)
+	coord[i] = node_coord[i] * _layout.subgrid_nrow_c[i];
     
       int cb = linearsite / subgrid_vol_cb;
-      multi1d<int> tmp_coord = crtesn(linearsite % subgrid_vol_cb, subgrid_cb_nrow);
+      Coord<Nd> tmp_coord;
+      crtesn(tmp_coord, linearsite % subgrid_vol_cb, subgrid_cb_nrow);
 
       // Add on position within the node
       // NOTE: the cb for the x-coord is not yet determined
@@ -512,8 +535,6 @@ namespace QDP
       for(int m=1; m < Nd; ++m)
 	cbb += coord[m];
       coord[0] += (cbb & 1);
-
-      return coord;
     }
 
 
@@ -539,10 +560,10 @@ namespace QDP
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() / 2;
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] /= 2;
 
       int cb = 0;
@@ -551,7 +572,7 @@ namespace QDP
       }
       cb &= 1;
 
-      multi1d<int> subgrid_cb_coord(Nd);
+      Coord<Nd> subgrid_cb_coord;
       subgrid_cb_coord[0] = (coord[0] / 2) % subgrid_cb_nrow[0];
       for(int i=1; i < Nd; ++i)
 	subgrid_cb_coord[i] = coord[i] % subgrid_cb_nrow[i];
@@ -566,14 +587,14 @@ namespace QDP
      * but to find the nodeNumber this function resembles a simple lexicographic 
      * layout
      */
-    int nodeNumber(const multi1d<int>& coord)
+    int nodeNumber(const Coord<Nd>& coord)
     {
-      multi1d<int> tmp_coord(Nd);
+      Coord<Nd> tmp_coord;
 
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] / _layout.subgrid_nrow_c[i];
     
-      return Layout::getNodeNumberFrom(tmp_coord);
+      return QMP_get_node_number_from(tmp_coord.slice());
     }
 
 
@@ -582,19 +603,21 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() / 2;
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] /= 2;
 
 
       // Get the base (origins) of the absolute lattice coord
-      multi1d<int> coord = getLogicalCoordFrom(node);
-      coord *= Layout::subgridLattSize();
+      const Coord<Nd>& node_coord = _layout.node_coords[node];
+      for(int i=0; i < Nd; ++i)
+	coord[i] = node_coord[i] * _layout.subgrid_nrow_c[i];
     
       int cb = linearsite / subgrid_vol_cb;
-      multi1d<int> tmp_coord = crtesn(linearsite % subgrid_vol_cb, subgrid_cb_nrow);
+      Coord<Nd> tmp_coord;
+      crtesn(tmp_coord, linearsite % subgrid_vol_cb, subgrid_cb_nrow);
 
       
 
@@ -613,8 +636,6 @@ namespace QDP
 
    
       coord[0] += (cbb & 1);
-
-      return coord;
     }
 
 
@@ -644,10 +665,10 @@ namespace QDP
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 32-style checkerboard lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> (Nd+1);
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] >>= 2;
       for(int i=1; i < Nd; ++i) 
 	subgrid_cb_nrow[i] >>= 1;
@@ -663,7 +684,7 @@ namespace QDP
       subl += (cb & 1) << Nd;   // Final color or checkerboard
 
       // Construct the checkerboard lattice coord
-      multi1d<int> subgrid_cb_coord(Nd);
+      Coord<Nd> subgrid_cb_coord;
 
       subgrid_cb_coord[0] = (coord[0] >> 2) % subgrid_cb_nrow[0];
       for(int i=1; i < Nd; ++i)
@@ -679,14 +700,14 @@ namespace QDP
      * but to find the nodeNumber this function resembles a simple lexicographic 
      * layout
      */
-    int nodeNumber(const multi1d<int>& coord)
+    int nodeNumber(const Coord<Nd>& coord)
     {
-      multi1d<int> tmp_coord(Nd);
+      Coord<Nd> tmp_coord;
 
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] / _layout.subgrid_nrow_c[i];
     
-      return Layout::getNodeNumberFrom(tmp_coord);
+      return QMP_get_node_number_from(tmp_coord.slice());
     }
 
 
@@ -695,20 +716,22 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> (Nd+1);
-      multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
       subgrid_cb_nrow[0] >>= 2;
       for(int i=1; i < Nd; ++i) 
 	subgrid_cb_nrow[i] >>= 1;
 
       // Get the base (origins) of the absolute lattice coord
-      multi1d<int> coord = Layout::getLogicalCoordFrom(node);
-      coord *= Layout::subgridLattSize();
+      const Coord<Nd>& node_coord = _layout.node_coords[node];
+      for(int i=0; i < Nd; ++i)
+	coord[i] = node_coord[i] * _layout.subgrid_nrow_c[i];
     
       int subl = linearsite / subgrid_vol_cb;
-      multi1d<int> tmp_coord = crtesn(linearsite % subgrid_vol_cb, subgrid_cb_nrow);
+      Coord<Nd> tmp_coord;
+      crtesn(tmp_coord, linearsite % subgrid_vol_cb, subgrid_cb_nrow);
 
       // Add on position within the node
       // NOTE: the cb for the x-coord is not yet determined
@@ -725,8 +748,6 @@ namespace QDP
       for(int m=0; m<Nd; ++m)
 	coord[m] ^= (subl & (1 << m)) >> m;
       coord[0] ^= (subl & (1 << Nd)) >> (Nd-1);   // this gets the hypercube cb
-
-      return coord;
     }
 
 
@@ -744,6 +765,135 @@ namespace QDP
     }
   }
 
+#elif QDP_USE_CB2_BLOCK_LAYOUT == 1
+
+#warning "Using a 2 checkerboard (red/black) layout stored in 4d blocks"
+
+  namespace Layout
+  {
+    //! Requested and actual block sizes, in checkerboard sites
+    static multi1d<int> block_req;
+    static multi1d<int> block_size;
+    static Coord<Nd> block_c;
+
+    //! Set the requested block size of the blocked layout
+    void setBlockSize(const multi1d<int>& block) {block_req = block;}
+
+    //! The block size in use by the blocked layout
+    const multi1d<int>& blockSize() {return block_size;}
+
+    //! Fix the block size of the blocked layout for the current subgrid
+    void initBlockLayout()
+    {
+      if (block_req.size() != Nd)
+      {
+	block_req.resize(Nd);
+	block_req = 4;
+      }
+
+      block_size.resize(Nd);
+      for(int i=0; i < Nd; ++i)
+      {
+	int cb_n = (i == 0) ? (_layout.subgrid_nrow[0] >> 1) : _layout.subgrid_nrow[i];
+	int b = std::max(1, std::min(block_req[i], cb_n));
+	while (cb_n % b != 0)
+	  --b;
+
+	block_size[i] = b;
+      }
+      block_c = Coord<Nd>(block_size);
+
+      QDPIO::cout << "  block size =";
+      for(int i=0; i < Nd; ++i)
+	QDPIO::cout << " " << block_size[i];
+      QDPIO::cout << std::endl;
+    }
+
+    //! The linearized site index for the corresponding coordinate
+    /*! 
+     * Each checkerboard of the subgrid is cut into 4d blocks, so the
+     * neighbors in all directions are near in memory. The checkerboards
+     * stay contiguous.
+     */
+    int linearSiteIndex(const Coord<Nd>& coord)
+    {
+      int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
+      subgrid_cb_nrow[0] >>= 1;
+
+      int cb = 0;
+      for(int m=0; m < Nd; ++m)
+	cb += coord[m];
+      cb &= 1;
+
+      Coord<Nd> subgrid_cb_coord;
+      subgrid_cb_coord[0] = (coord[0] >> 1) % subgrid_cb_nrow[0];
+      for(int i=1; i < Nd; ++i)
+	subgrid_cb_coord[i] = coord[i] % subgrid_cb_nrow[i];
+    
+      return block_site(subgrid_cb_coord, subgrid_cb_nrow, block_c) + cb*subgrid_vol_cb;
+    }
+
+
+    //! The node number for the corresponding lattice coordinate
+    /*! This resembles a simple lexicographic layout */
+    int nodeNumber(const Coord<Nd>& coord)
+    {
+      Coord<Nd> tmp_coord;
+
+      for(int i=0; i < Nd; ++i)
+	tmp_coord[i] = coord[i] / _layout.subgrid_nrow_c[i];
+    
+      return QMP_get_node_number_from(tmp_coord.slice());
+    }
+
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    /*! 
+     * This is the inverse of the nodeNumber and linearSiteIndex functions.
+     * The API requires this function to be here.
+     */
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
+    {
+      int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
+      Coord<Nd> subgrid_cb_nrow = _layout.subgrid_nrow_c;
+      subgrid_cb_nrow[0] >>= 1;
+
+      // Get the base (origins) of the absolute lattice coord
+      const Coord<Nd>& node_coord = _layout.node_coords[node];
+      for(int i=0; i < Nd; ++i)
+	coord[i] = node_coord[i] * _layout.subgrid_nrow_c[i];
+    
+      int cb = linearsite / subgrid_vol_cb;
+      Coord<Nd> tmp_coord;
+      block_crtesn(tmp_coord, linearsite % subgrid_vol_cb, subgrid_cb_nrow, block_c);
+
+      // Add on position within the node
+      // NOTE: the cb for the x-coord is not yet determined
+      coord[0] += 2*tmp_coord[0];
+      for(int m=1; m < Nd; ++m)
+	coord[m] += tmp_coord[m];
+
+      // Determine cb including global node cb
+      int cbb = cb;
+      for(int m=1; m < Nd; ++m)
+	cbb += coord[m];
+      coord[0] += (cbb & 1);
+    }
+
+
+    //! Return the smallest lattice size per node allowed
+    /*! Same as the 2 checkerboard layout */
+    multi1d<int> minimalLayoutMapping()
+    {
+      multi1d<int> dim(Nd);
+      dim = 1;
+      dim[0] = 2;       // must have multiple length 2 for cb
+
+      return dim;
+    }
+  }
+
 #else
 
 #error "no appropriate layout defined"
@@ -131,6 +131,9 @@ namespace QDP {
       return;
     }
 
+    // Messages of this map are counted under its displacement
+    comm_id = commProfileId(QDP_COMM_SHIFT, mapCommName(func));
+
     // Finally setup the srce and dest nodes now without my_node
     srcenodes.resize(cnt_srcenodes);
     destnodes.resize(cnt_destnodes);
@@ -236,6 +239,12 @@ namespace QDP {
       QDP_info("soffsets(%d) = %d",i,soffsets(i));
 #endif
 
+    // Position of each off-node site in the receive buffer, in the
+    // order the sites arrive
+    roffsets.resize(nodeSites);
+    for(int i=0, ri=0; i < nodeSites; ++i) 
+      roffsets[i] = (srcnode[i] != my_node) ? ri++ : -1;
+
 
 #if QDP_DEBUG >= 3
     QDP_info("exiting Map::make");
@@ -255,6 +264,9 @@ namespace QDP {
       char *dd_tmp;
       int lleng;
 
+      // Counted as a single broadcast
+      QDPTime_t t0 = commStartTime();
+
       // Only primary node can grab string
       if (Layout::primaryNode()) 
       {
@@ -262,7 +274,7 @@ namespace QDP {
       }
 
       // First must broadcast size of string
-      QDPInternal::broadcast(lleng);
+      QMP_broadcast((void *)&lleng, sizeof(int));
 
       // Now every node can alloc space for string
       dd_tmp = new(std::nothrow) char[lleng];
@@ -274,7 +286,7 @@ namespace QDP {
 	memcpy(dd_tmp, result.c_str(), lleng);
   
       // Now broadcast char array out to all nodes
-      QDPInternal::broadcast((void *)dd_tmp, lleng);
+      QMP_broadcast((void *)dd_tmp, lleng);
 
       // All nodes can now grab char array and make a string, but only
       // need this on non-primary nodes
@@ -285,6 +297,8 @@ namespace QDP {
 
       // Clean-up and boogie
       delete[] dd_tmp;
+
+      if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "string", -1, lleng);
     }
 
     //! Is this a grid architecture
@@ -315,7 +329,9 @@ namespace QDP {
 #endif
 
 //    QMP_route(buffer, count, srce_node, dest_node);
+      QDPTime_t t0 = commStartTime();
       DML_route_bytes((char*)buffer, count, srce_node, dest_node);
+      if (t0) recordComm(t0, QDP_COMM_SEND, "route", "byte", -1, count);
 
 #if QDP_DEBUG >= 2
       QDP_info("finished a route");
@@ -330,6 +346,8 @@ namespace QDP {
       QDP_info("starting a sendToWait, count=%d, destnode=%d", count,dest_node);
 #endif
 
+      QDPTime_t t0 = commStartTime();
+
       QMP_msgmem_t request_msg = QMP_declare_msgmem(send_buf, count);
       QMP_msghandle_t request_mh = QMP_declare_send_to(request_msg, dest_node, 0);
 
@@ -341,6 +359,8 @@ namespace QDP {
       QMP_free_msghandle(request_mh);
       QMP_free_msgmem(request_msg);
 
+      if (t0) recordComm(t0, QDP_COMM_SEND, "send", "byte", -1, count);
+
 #if QDP_DEBUG >= 2
       QDP_info("finished a sendToWait");
 #endif
@@ -354,6 +374,8 @@ namespace QDP {
       QDP_info("starting a recvFromWait, count=%d, srcenode=%d", count, srce_node);
 #endif
 
+      QDPTime_t t0 = commStartTime();
+
       QMP_msgmem_t request_msg = QMP_declare_msgmem(recv_buf, count);
       QMP_msghandle_t request_mh = QMP_declare_receive_from(request_msg, srce_node, 0);
 
@@ -365,6 +387,8 @@ namespace QDP {
       QMP_free_msghandle(request_mh);
       QMP_free_msgmem(request_msg);
 
+      if (t0) recordComm(t0, QDP_COMM_SEND, "recv", "byte", -1, count);
+
 #if QDP_DEBUG >= 2
       QDP_info("finished a recvFromWait");
 #endif
@@ -390,10 +414,14 @@ namespace QDP {
     // Find the location of each site and send to primary node
     int old_node = 0;
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     for(int site=0; site < Layout::vol(); site += xinc)
     {
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
+      int node = Layout::nodeNumber(coord);
 
       // Send nodes must wait for a ready signal from the master node
       // to prevent message pileups on the master node
@@ -409,7 +437,7 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  memcpy(recv_buf+i*sizemem, output+linear*sizemem, sizemem);
 	}
       }
@@ -509,6 +537,8 @@ namespace QDP {
     // Find the location of each site and send to primary node
     int old_node = 0;
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     for(int site=0; site < Layout::vol(); site += xinc)
     {
       // This algorithm is cumbersome. We do not keep the coordinate function for the subset.
@@ -517,7 +547,9 @@ namespace QDP {
       // subgridLattSize strip.
 
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
+      int node = Layout::nodeNumber(coord);
 
       // Send nodes must wait for a ready signal from the master node
       // to prevent message pileups on the master node
@@ -534,7 +566,7 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
 	    memcpy(recv_buf+site_cnt*sizemem, output+linear*sizemem, sizemem);
@@ -592,11 +624,15 @@ namespace QDP {
       QDP_error_exit("Unable to allocate recvbuf\n");
     }
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); site += xinc)
     {
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
+      int node = Layout::nodeNumber(coord);
 
       // Only on primary node read the data
       bin.readArrayPrimaryNode(recv_buf, size, nmemb*xinc);
@@ -620,7 +656,7 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 
 	  memcpy(input+linear*sizemem, recv_buf+i*sizemem, sizemem);
 	}
@@ -696,6 +732,8 @@ namespace QDP {
       QDP_error_exit("Unable to allocate recv_buf_size\n");
     }
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); site += xinc)
     {
@@ -705,7 +743,9 @@ namespace QDP {
       // subgridLattSize strip.
 
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
+      int node = Layout::nodeNumber(coord);
 
       // Find the amount of data to read. Unfortunately, have to ask the remote node
       // Place the result in a send buffer
@@ -714,7 +754,7 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
 	    site_cnt++;
@@ -764,7 +804,7 @@ namespace QDP {
       {
 	for(int i=0,j=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
 	    memcpy(input+linear*sizemem, recv_buf+j*sizemem, sizemem);
@@ -782,120 +822,291 @@ namespace QDP {
   // **************************************************************
   namespace LatticeTimeSliceIO 
   {
-    void readOLatticeSlice(BinaryReader& bin, char* input, 
-			   size_t size, size_t nmemb,
-			   int start_lexico, int stop_lexico)
+    namespace
     {
-      const int xinc = Layout::subgridLattSize()[0];
+      //! Check a range of lexicographic sites is made of whole x-rows of the subgrid
+      void checkSliceRange(const char* func, int start_lexico, int stop_lexico)
+      {
+	const int xinc = Layout::subgridLattSize()[0];
 
-      if ((stop_lexico % xinc) != 0)
+	if ((start_lexico % xinc) != 0 || (stop_lexico % xinc) != 0)
+	{
+	  QDPIO::cerr << func << ": error: start_lexico= " << start_lexico 
+		      << "  stop_lexico= " << stop_lexico << "  xinc= " << xinc << std::endl;
+	  QDP_abort(1);
+	}
+      }
+
+      //! The node holding the x-row starting at site
+      int sliceRowNode(int site)
       {
-	QDPIO::cerr << __func__ << ": erorr: stop_lexico= " << stop_lexico << "  xinc= " << xinc << std::endl;
-	QDP_abort(1);
+	Coord<Nd> coord;
+	crtesn(coord, site, Coord<Nd>(Layout::lattSize()));
+	return Layout::nodeNumber(coord);
       }
 
-      size_t sizemem = size*nmemb;
-      size_t tot_size = sizemem*xinc;
-      char *recv_buf = new(std::nothrow) char[tot_size];
-      if( recv_buf == 0x0 ) { 
-	QDP_error_exit("Unable to allocate recvbuf\n");}
+      //! The bytes held by each node in a range of lexicographic sites
+      void sliceNodeBytes(std::vector<size_t>& bytes, size_t sizemem, 
+			  int start_lexico, int stop_lexico)
+      {
+	const int xinc = Layout::subgridLattSize()[0];
 
-      // Find the location of each site and send to primary node
-      for (int site=start_lexico; site < stop_lexico; site += xinc)
+	bytes.assign(Layout::numNodes(), 0);
+	for (int site=start_lexico; site < stop_lexico; site += xinc)
+	  bytes[sliceRowNode(site)] += sizemem*xinc;
+      }
+
+      //! Start a message to or from another node
+      void startSliceMsg(std::vector<QMP_msgmem_t>& msg, std::vector<QMP_msghandle_t>& mh,
+			 char* buf, size_t count, int node, bool send)
       {
-	// first site in each segment uniquely identifies the node
-	int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+	QMP_msgmem_t m = QMP_declare_msgmem(buf, count);
+	QMP_msghandle_t h = send ? QMP_declare_send_to(m, node, 0) : QMP_declare_receive_from(m, node, 0);
 
-	// Only on primary node read the data
-	bin.readArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+	if (QMP_start(h) != QMP_SUCCESS)
+	  QDP_error_exit("LatticeTimeSliceIO: failed to start a message\n");
+
+	msg.push_back(m);
+	mh.push_back(h);
+      }
 
-	// Send result to destination node. Avoid sending prim-node sending to itself
-	if (node != 0)
+      //! Complete all the messages
+      void waitSliceMsgs(std::vector<QMP_msgmem_t>& msg, std::vector<QMP_msghandle_t>& mh)
+      {
+	for(int i=0; i < mh.size(); ++i)
 	{
-#if 1
-	  // All nodes participate
-	  QDPInternal::route((void *)recv_buf, 0, node, tot_size);
-#else
-	  if (Layout::primaryNode())
-	    QDPInternal::sendToWait((void *)recv_buf, node, tot_size);
-	  if (Layout::nodeNumber() == node)
-	    QDPInternal::recvFromWait((void *)recv_buf, 0, tot_size);
-#endif
+	  QMP_wait(mh[i]);
+	  QMP_free_msghandle(mh[i]);
+	  QMP_free_msgmem(msg[i]);
 	}
+	msg.clear();
+	mh.clear();
+      }
+    }
 
-	if (Layout::nodeNumber() == node)
+
+    SliceGather::SliceGather() : 
+      size(0), nmemb(0), sizemem(0), start_lexico(0), stop_lexico(0)
+    {
+    }
+
+    SliceGather::~SliceGather()
+    {
+      waitSliceMsgs(msg, mh);
+    }
+
+    // Pack the sites of this node and start sending them
+    void SliceGather::start(const char* data, size_t size_, size_t nmemb_,
+			    int start_lexico_, int stop_lexico_)
+    {
+      // Finish any earlier gather
+      wait();
+
+      checkSliceRange(__func__, start_lexico_, stop_lexico_);
+      size    = size_;
+      nmemb   = nmemb_;
+      sizemem = size*nmemb;
+      start_lexico = start_lexico_;
+      stop_lexico  = stop_lexico_;
+
+      const int xinc = Layout::subgridLattSize()[0];
+      const int me = Layout::nodeNumber();
+
+      std::vector<size_t> bytes;
+      sliceNodeBytes(bytes, sizemem, start_lexico, stop_lexico);
+
+      if (Layout::primaryNode())
+      {
+	// Other nodes go to the stage, our own sites go straight to the buffer
+	offset.resize(bytes.size()+1);
+	offset[0] = 0;
+	for(int n=0; n < bytes.size(); ++n)
+	  offset[n+1] = offset[n] + ((n == me) ? 0 : bytes[n]);
+
+	buf.resize(sizemem*(stop_lexico-start_lexico));
+	stage.resize(offset.back());
+
+	for(int n=0; n < bytes.size(); ++n)
+	  if (n != me && bytes[n] > 0)
+	    startSliceMsg(msg, mh, &stage[offset[n]], bytes[n], n, false);
+
+	for (int site=start_lexico; site < stop_lexico; site += xinc)
 	{
+	  if (sliceRowNode(site) != me)
+	    continue;
+
+	  char* dest = &buf[sizemem*(site-start_lexico)];
 	  for(int i=0; i < xinc; ++i)
-	  {
-	    int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
-	    memcpy(input+linear*sizemem, recv_buf+i*sizemem, sizemem);
-	  }
+	    memcpy(dest+i*sizemem, data+Layout::linearSiteIndex(site+i)*sizemem, sizemem);
 	}
       }
+      else
+      {
+	// Pack our own sites in lexicographic order and send in one go
+	stage.resize(bytes[me]);
+
+	char* dest = stage.empty() ? 0 : &stage[0];
+	for (int site=start_lexico; site < stop_lexico; site += xinc)
+	{
+	  if (sliceRowNode(site) != me)
+	    continue;
+
+	  for(int i=0; i < xinc; ++i, dest += sizemem)
+	    memcpy(dest, data+Layout::linearSiteIndex(site+i)*sizemem, sizemem);
+	}
 
-      delete[] recv_buf;
+	if (! stage.empty())
+	  startSliceMsg(msg, mh, &stage[0], stage.size(), 0, true);
+      }
     }
 
- 
-    // Write a time slice of a lattice quantity (time must be most slowly varying)
-    void writeOLatticeSlice(BinaryWriter& bin, const char* output, 
-			    size_t size, size_t nmemb,
-			    int start_lexico, int stop_lexico)
+    // Complete the messages
+    void SliceGather::wait()
     {
+      if (mh.empty())
+	return;
+
+      QDPTime_t t0 = commStartTime();
+      waitSliceMsgs(msg, mh);
+      if (t0) recordComm(t0, QDP_COMM_SEND, "gather", "byte", -1, stage.size());
+
+      if (! Layout::primaryNode())
+	return;
+
+      // Unpack the stage into lexicographic order
       const int xinc = Layout::subgridLattSize()[0];
+      const int me = Layout::nodeNumber();
+      std::vector<size_t> pos(offset.begin(), offset.end()-1);
 
-      if ((stop_lexico % xinc) != 0)
+      for (int site=start_lexico; site < stop_lexico; site += xinc)
       {
-	QDPIO::cerr << __func__ << ": erorr: stop_lexico= " << stop_lexico << "  xinc= " << xinc << std::endl;
-	QDP_abort(1);
+	int node = sliceRowNode(site);
+	if (node == me)
+	  continue;
+
+	memcpy(&buf[sizemem*(site-start_lexico)], &stage[pos[node]], sizemem*xinc);
+	pos[node] += sizemem*xinc;
       }
+    }
 
-      size_t sizemem = size*nmemb;
-      size_t tot_size = sizemem*xinc;
-      char *recv_buf = new(std::nothrow) char[tot_size];
-      if( recv_buf == 0x0 ) { 
-	QDP_error_exit("Unable to allocate recv_buf\n");}
+    // Write the gathered sites
+    void SliceGather::write(BinaryWriter& bin) const
+    {
+      if (Layout::primaryNode() && ! buf.empty())
+	bin.writeArrayPrimaryNode(&buf[0], size, nmemb*(stop_lexico-start_lexico));
+    }
 
-      // Find the location of each site and send to primary node
-      int old_node = 0;
 
-      for (int site=start_lexico; site < stop_lexico; site += xinc)
+    // Send the sites of a range from the primary node to the nodes holding them
+    void scatterOLatticeSlice(const char* buf, char* data, 
+			      size_t sizemem,
+			      int start_lexico, int stop_lexico)
+    {
+      checkSliceRange(__func__, start_lexico, stop_lexico);
+
+      const int xinc = Layout::subgridLattSize()[0];
+      const int me = Layout::nodeNumber();
+
+      std::vector<size_t> bytes;
+      sliceNodeBytes(bytes, sizemem, start_lexico, stop_lexico);
+
+      std::vector<QMP_msgmem_t> msg;
+      std::vector<QMP_msghandle_t> mh;
+      std::vector<char> stage;
+
+      QDPTime_t t0 = commStartTime();
+
+      if (Layout::primaryNode())
       {
-	// first site in each segment uniquely identifies the node
-	int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
-
-	// Send nodes must wait for a ready signal from the master node
-	// to prevent message pileups on the master node
-	if (node != old_node){
-	  // On non-grid machines, use a clear-to-send like protocol
-	  QDPInternal::clearToSend(recv_buf,sizeof(int),node);
-	  old_node = node;}
-    
-	// Copy to buffer: be really careful since max(linear) could vary among nodes
-	if (Layout::nodeNumber() == node){
-	  for(int i=0; i < xinc; ++i){
-	    int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
-	    memcpy(recv_buf+i*sizemem, output+linear*sizemem, sizemem);
+	// Group the sites of the other nodes and send each node its part
+	std::vector<size_t> pos(bytes.size()+1);
+	pos[0] = 0;
+	for(int n=0; n < bytes.size(); ++n)
+	  pos[n+1] = pos[n] + ((n == me) ? 0 : bytes[n]);
+
+	stage.resize(pos.back());
+
+	for (int site=start_lexico; site < stop_lexico; site += xinc)
+	{
+	  int node = sliceRowNode(site);
+	  const char* src = buf + sizemem*(site-start_lexico);
+
+	  if (node == me)
+	  {
+	    for(int i=0; i < xinc; ++i)
+	      memcpy(data+Layout::linearSiteIndex(site+i)*sizemem, src+i*sizemem, sizemem);
+	  }
+	  else
+	  {
+	    memcpy(&stage[pos[node]], src, sizemem*xinc);
+	    pos[node] += sizemem*xinc;
 	  }
 	}
 
-	// Send result to primary node. Avoid sending prim-node sending to itself
-	if (node != 0)
+	size_t off = 0;
+	for(int n=0; n < bytes.size(); ++n)
 	{
-#if 1
-	  // All nodes participate
-	  QDPInternal::route((void *)recv_buf, node, 0, tot_size);
-#else
-	  if (Layout::primaryNode())
-	    QDPInternal::recvFromWait((void *)recv_buf, node, tot_size);
-	  if (Layout::nodeNumber() == node)
-	    QDPInternal::sendToWait((void *)recv_buf, 0, tot_size);
-#endif
+	  if (n == me)
+	    continue;
+	  if (bytes[n] > 0)
+	    startSliceMsg(msg, mh, &stage[off], bytes[n], n, true);
+	  off += bytes[n];
+	}
+
+	waitSliceMsgs(msg, mh);
+      }
+      else if (bytes[me] > 0)
+      {
+	// Receive our own sites in one go
+	stage.resize(bytes[me]);
+	startSliceMsg(msg, mh, &stage[0], stage.size(), 0, false);
+	waitSliceMsgs(msg, mh);
+
+	const char* src = &stage[0];
+	for (int site=start_lexico; site < stop_lexico; site += xinc)
+	{
+	  if (sliceRowNode(site) != me)
+	    continue;
+
+	  for(int i=0; i < xinc; ++i, src += sizemem)
+	    memcpy(data+Layout::linearSiteIndex(site+i)*sizemem, src, sizemem);
 	}
+      }
+
+      if (t0) recordComm(t0, QDP_COMM_SEND, "scatter", "byte", -1, stage.size());
+    }
+
+
+    void readOLatticeSlice(BinaryReader& bin, char* input, 
+			   size_t size, size_t nmemb,
+			   int start_lexico, int stop_lexico)
+    {
+      checkSliceRange(__func__, start_lexico, stop_lexico);
+
+      size_t sizemem = size*nmemb;
 
-	bin.writeArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+      // Only on primary node read the data, then send each node its sites
+      std::vector<char> buf;
+      if (Layout::primaryNode())
+      {
+	buf.resize(sizemem*(stop_lexico-start_lexico));
+	if (! buf.empty())
+	  bin.readArrayPrimaryNode(&buf[0], size, nmemb*(stop_lexico-start_lexico));
       }
-      delete[] recv_buf;
+
+      scatterOLatticeSlice(buf.empty() ? 0 : &buf[0], input, sizemem, start_lexico, stop_lexico);
+    }
+
+ 
+    // Write a time slice of a lattice quantity (time must be most slowly varying)
+    void writeOLatticeSlice(BinaryWriter& bin, const char* output, 
+			    size_t size, size_t nmemb,
+			    int start_lexico, int stop_lexico)
+    {
+      SliceGather gather;
+      gather.start(output, size, nmemb, start_lexico, stop_lexico);
+      gather.wait();
+      gather.write(bin);
     }
   }
 
@@ -1020,10 +1231,13 @@ namespace QDP {
 
     checksum = 0;
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); ++site)
     {
-      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
 
       int node   = Layout::nodeNumber(coord);
       int linear = Layout::linearSiteIndex(coord);
@@ -1160,10 +1374,13 @@ namespace QDP {
       QDP_extract(sa[dd], u[dd], all);
     }
 
+    const Coord<Nd> nrow(Layout::lattSize());
+
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); ++site)
     {
-      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      Coord<Nd> coord;
+      crtesn(coord, site, nrow);
 
       int node   = Layout::nodeNumber(coord);
       int linear = Layout::linearSiteIndex(coord);
@@ -56,9 +56,14 @@ void QDP_initialize(int *argc, char ***argv)
       fprintf(stderr,"    -h        help\n");
       fprintf(stderr,"    -V        %%d [%d] verbose mode for QMP\n", 
 	      QMP_verboseP);
-#if defined(QDP_USE_PROFILING)   
       fprintf(stderr,"    -p        %%d [%d] profile level\n", 
 	      getProfileLevel());
+      fprintf(stderr,"    -pout     %%s    also write the profile to <prefix>.json and .csv\n");
+      fprintf(stderr,"    -pcomm          count shift, reduction and broadcast messages\n");
+      fprintf(stderr,"    -pmem           print the use of memory by caller and size\n");
+      fprintf(stderr,"    -proofline      measure the node roofline for the perf region report\n");
+#if defined(QDP_USE_LIBXML2)
+      fprintf(stderr,"    -xmllocal       broadcast XML input files once and parse them on every node\n");
 #endif
 
       // logical geometry info
@@ -88,13 +93,33 @@ void QDP_initialize(int *argc, char ***argv)
     {
       QMP_verboseP = 1;
     }
-#if defined(QDP_USE_PROFILING)   
     else if (strcmp((*argv)[i], "-p")==0) 
     {
       int lev;
       sscanf((*argv)[++i], "%d", &lev);
       setProgramProfileLevel(lev);
     }
+    else if (strcmp((*argv)[i], "-pout")==0) 
+    {
+      setProfileOutput((*argv)[++i]);
+    }
+    else if (strcmp((*argv)[i], "-pcomm")==0) 
+    {
+      setCommProfile(true);
+    }
+    else if (strcmp((*argv)[i], "-pmem")==0) 
+    {
+      setMemoryProfile(true);
+    }
+    else if (strcmp((*argv)[i], "-proofline")==0) 
+    {
+      setPerfRoofline(true);
+    }
+#if defined(QDP_USE_LIBXML2)
+    else if (strcmp((*argv)[i], "-xmllocal")==0) 
+    {
+      XMLReader::setLocalParse(true);
+    }
 #endif
     else if (strcmp((*argv)[i], "-geom")==0) 
     {
@@ -210,6 +235,17 @@ void QDP_finalize()
     QDP_abort(1);
   }
 
+  // Finish any checkpoint written in the background
+  waitCheckpoint();
+
+  // Report the perf regions while the threads are still up
+  printPerfRegions();
+  finalizePerfRegions();
+
+  if (getMemoryProfile())
+    Allocator::theQDPAllocator::Instance().printStats();
+
+  printCommProfile();
   printProfile();
 
 #if defined(QDP_USE_HDF5)
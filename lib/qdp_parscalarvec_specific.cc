@@ -137,6 +137,9 @@ void Map::make(const MapFunc& func)
     return;
   }
 
+  // Messages of this map are counted under its displacement
+  comm_id = commProfileId(QDP_COMM_SHIFT, mapCommName(func));
+
   // Finally setup the srce and dest nodes now without my_node
   srcenodes.resize(cnt_srcenodes);
   destnodes.resize(cnt_destnodes);
@@ -261,6 +264,9 @@ namespace QDPInternal
     char *dd_tmp;
     int lleng;
 
+    // Counted as a single broadcast
+    QDPTime_t t0 = commStartTime();
+
     // Only primary node can grab string
     if (Layout::primaryNode()) 
     {
@@ -268,7 +274,7 @@ namespace QDPInternal
     }
 
     // First must broadcast size of string
-    QDPInternal::broadcast(lleng);
+    QMP_broadcast((void *)&lleng, sizeof(int));
 
     // Now every node can alloc space for string
     dd_tmp = new char[lleng];
@@ -280,7 +286,7 @@ namespace QDPInternal
       memcpy(dd_tmp, result.c_str(), lleng);
   
     // Now broadcast char array out to all nodes
-    QDPInternal::broadcast((void *)dd_tmp, lleng);
+    QMP_broadcast((void *)dd_tmp, lleng);
 
     // All nodes can now grab char array and make a string, but only
     // need this on non-primary nodes
@@ -291,6 +297,8 @@ namespace QDPInternal
 
     // Clean-up and boogie
     delete[] dd_tmp;
+
+    if (t0) recordComm(t0, QDP_COMM_BROADCAST, "bcast", "string", -1, lleng);
   }
 
 
@@ -303,7 +311,9 @@ namespace QDPInternal
 #endif
 
 //    QMP_route(buffer, count, srce_node, dest_node);
+    QDPTime_t t0 = commStartTime();
     DML_route_bytes((char*)buffer, count, srce_node, dest_node);
+    if (t0) recordComm(t0, QDP_COMM_SEND, "route", "byte", -1, count);
 
 #if QDP_DEBUG >= 2
     QDP_info("finished a route");
@@ -318,6 +328,8 @@ namespace QDPInternal
     QDP_info("starting a sendToWait, count=%d, destnode=%d", count,dest_node);
 #endif
 
+    QDPTime_t t0 = commStartTime();
+
     QMP_msgmem_t request_msg = QMP_declare_msgmem(send_buf, count);
     QMP_msghandle_t request_mh = QMP_declare_send_to(request_msg, dest_node, 0);
 
@@ -329,6 +341,8 @@ namespace QDPInternal
     QMP_free_msghandle(request_mh);
     QMP_free_msgmem(request_msg);
 
+    if (t0) recordComm(t0, QDP_COMM_SEND, "send", "byte", -1, count);
+
 #if QDP_DEBUG >= 2
     QDP_info("finished a sendToWait");
 #endif
@@ -342,6 +356,8 @@ namespace QDPInternal
     QDP_info("starting a recvFromWait, count=%d, srcenode=%d", count, srce_node);
 #endif
 
+    QDPTime_t t0 = commStartTime();
+
     QMP_msgmem_t request_msg = QMP_declare_msgmem(recv_buf, count);
     QMP_msghandle_t request_mh = QMP_declare_receive_from(request_msg, srce_node, 0);
 
@@ -353,6 +369,8 @@ namespace QDPInternal
     QMP_free_msghandle(request_mh);
     QMP_free_msgmem(request_msg);
 
+    if (t0) recordComm(t0, QDP_COMM_SEND, "recv", "byte", -1, count);
+
 #if QDP_DEBUG >= 2
     QDP_info("finished a recvFromWait");
 #endif
@@ -0,0 +1,551 @@
+/*! @file
+ * @brief Hardware counter regions
+ *
+ * Regions counted with perf_event_open, with a fallback to the clock
+ * alone, and the roofline they are reported against.
+ */
+
+#include "qdp.h"
+#include <map>
+#include <deque>
+#include <algorithm>
+
+#if defined(HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+namespace QDP {
+
+namespace
+{
+  // Hardware events of a region
+  enum {PERF_CYCLES, PERF_INSTRUCTIONS, PERF_LLC_MISSES, PERF_NUM_EVENTS};
+
+  // Bytes moved from memory by one last level cache miss
+  const double cache_line = 64;
+
+  //! The counters opened by one thread
+  /*!
+   * The events are read together as a group. An event the machine does
+   * not have is left out of the group, with pos -1.
+   */
+  struct PerfThreadEvents
+  {
+    int state;    // 0 not tried yet, 1 open, -1 not available
+    int leader;
+    int fds[PERF_NUM_EVENTS];
+    int pos[PERF_NUM_EVENTS];
+    int nopen;
+
+    PerfThreadEvents() : state(0), leader(-1), nopen(0)
+    {
+      for(int e=0; e < PERF_NUM_EVENTS; ++e)
+	fds[e] = pos[e] = -1;
+    }
+  };
+
+  //! Counts of one region on one thread
+  struct PerfRegionThread
+  {
+    double count;
+    double ns;
+    double events[PERF_NUM_EVENTS];
+    bool   counted;       // whether the hardware counters were read
+
+    QDPTime_t start_ns;
+    unsigned long long start_events[PERF_NUM_EVENTS];
+    bool   running;
+
+    PerfRegionThread() {clear();}
+
+    void clear()
+    {
+      count = ns = 0;
+      counted = running = false;
+      for(int e=0; e < PERF_NUM_EVENTS; ++e)
+	events[e] = 0;
+    }
+  };
+}
+
+
+//! A region, kept under its name
+struct PerfRegionData
+{
+  std::string name;
+  double flops;
+  double bytes;
+  std::vector<PerfRegionThread> threads;
+};
+
+
+namespace
+{
+  // Indexed by thread. Sized once, when the first region is made and
+  // so before any region is started. After that each thread only
+  // touches its own entry. Threads beyond the size are not counted
+  std::vector<PerfThreadEvents> thread_events;
+
+  // Regions in the order they were made. A deque keeps each region
+  // where it is while others are added, so a PerfRegion holds its
+  // address and never looks in here outside the registration lock
+  std::deque<PerfRegionData> regions;
+  std::map<std::string,PerfRegionData*> region_ids;
+
+  // Whether the roofline is wanted in the report
+  bool roofline_wanted = false;
+  bool roofline_measured = false;
+
+  inline int perfThread()
+  {
+#if defined(QDP_USE_OMP_THREADS)
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+
+#if defined(HAVE_LINUX_PERF_EVENT_H) && defined(__NR_perf_event_open)
+  //! Open one event of the calling thread
+  int openEvent(unsigned long long config, int group)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+  }
+
+  //! Open the events of the calling thread
+  void openEvents(PerfThreadEvents& ev)
+  {
+    const unsigned long long config[PERF_NUM_EVENTS] =
+      {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+
+    ev.state = -1;
+    for(int e=0; e < PERF_NUM_EVENTS; ++e)
+    {
+      int fd = openEvent(config[e], ev.leader);
+      if (fd < 0)
+	continue;
+
+      if (ev.leader < 0)
+	ev.leader = fd;
+
+      ev.fds[e] = fd;
+      ev.pos[e] = ev.nopen++;
+      ev.state = 1;
+    }
+  }
+
+  //! Read the events of the calling thread, false if they are not available
+  bool readEvents(PerfThreadEvents& ev, unsigned long long* val)
+  {
+    if (ev.state == 0)
+      openEvents(ev);
+
+    if (ev.state < 0)
+      return false;
+
+    unsigned long long buf[1 + PERF_NUM_EVENTS];
+    if (::read(ev.leader, buf, sizeof(buf)) < (ssize_t)((1 + ev.nopen)*sizeof(buf[0])))
+      return false;
+
+    for(int e=0; e < PERF_NUM_EVENTS; ++e)
+      val[e] = (ev.pos[e] >= 0) ? buf[1 + ev.pos[e]] : 0;
+
+    return true;
+  }
+
+  //! Close the events of a thread, so they can be opened again
+  void closeEvents(PerfThreadEvents& ev)
+  {
+    for(int e=0; e < PERF_NUM_EVENTS; ++e)
+      if (ev.fds[e] >= 0)
+	::close(ev.fds[e]);
+
+    ev = PerfThreadEvents();
+  }
+#else
+  bool readEvents(PerfThreadEvents& ev, unsigned long long* val)
+  {
+    ev.state = -1;
+    return false;
+  }
+
+  void closeEvents(PerfThreadEvents& ev)
+  {
+    ev = PerfThreadEvents();
+  }
+#endif
+
+
+  //! Find the roofline of the node
+  /*! The compute peak is what the library's compiler flags make of a dense loop */
+  PerfRoofline measureRoofline()
+  {
+    PerfRoofline r;
+
+    // Triad over arrays well beyond the caches, best of a few passes
+    const int n = 1 << 23;
+    double *a = new double[n];
+    double *b = new double[n];
+    double *c = new double[n];
+
+#pragma omp parallel for
+    for(int i=0; i < n; ++i)
+    {
+      a[i] = 0;
+      b[i] = 1;
+      c[i] = 2;
+    }
+
+    double best = 0;
+    for(int pass=0; pass < 5; ++pass)
+    {
+      QDPTime_t t0 = getClockTimeNs();
+#pragma omp parallel for
+      for(int i=0; i < n; ++i)
+	a[i] = b[i] + 0.5*c[i];
+      double ns = getClockTimeNs() - t0;
+
+      if (ns > 0)
+	best = std::max(best, 3.0*sizeof(double)*n/ns);
+    }
+    r.bandwidth = best;
+
+    delete[] c;
+    delete[] b;
+    delete[] a;
+
+    // Independent multiply-adds that fit in registers, on every thread
+    const int iter = 1 << 22;
+    const int nth = qdpNumThreads();
+    std::vector<double> sink(nth, 0.0);
+
+    QDPTime_t t0 = getClockTimeNs();
+#pragma omp parallel for
+    for(int th=0; th < nth; ++th)
+    {
+      double x[16];
+      for(int j=0; j < 16; ++j)
+	x[j] = 1.0 + j*1.0e-3;
+
+      for(int it=0; it < iter; ++it)
+	for(int j=0; j < 16; ++j)
+	  x[j] = x[j]*0.999999 + 1.0e-7;
+
+      for(int j=0; j < 16; ++j)
+	sink[th] += x[j];
+    }
+    double ns = getClockTimeNs() - t0;
+
+    // Keep the loop from being thrown away
+    if (sink[0] == 0.123)
+      QDPIO::cout << sink[0] << std::endl;
+
+    r.peak = (ns > 0) ? 2.0*16*double(iter)*nth/ns : 0;
+
+    return r;
+  }
+}
+
+
+const PerfRoofline&
+perfRoofline()
+{
+  static PerfRoofline r;
+
+  if (! roofline_measured)
+  {
+    r = measureRoofline();
+    roofline_measured = true;
+  }
+
+  return r;
+}
+
+
+bool
+setPerfRoofline(bool on)
+{
+  bool old = roofline_wanted;
+  roofline_wanted = on;
+  return old;
+}
+
+bool getPerfRoofline() {return roofline_wanted;}
+
+
+bool
+perfCountersAvailable()
+{
+  int tid = perfThread();
+  if (tid >= int(thread_events.size()))
+    return false;
+
+  unsigned long long val[PERF_NUM_EVENTS];
+  return readEvents(thread_events[tid], val);
+}
+
+
+PerfRegion::PerfRegion(const std::string& name)
+{
+#pragma omp critical (qdp_perfregion_register)
+  {
+    if (thread_events.empty())
+      thread_events.resize(qdpNumThreads());
+
+    const int nth = thread_events.size();
+
+    std::map<std::string,PerfRegionData*>::const_iterator p = region_ids.find(name);
+    if (p != region_ids.end())
+    {
+      data = p->second;
+    }
+    else
+    {
+      PerfRegionData d;
+      d.name = name;
+      d.flops = d.bytes = 0;
+      d.threads.resize(nth);
+      regions.push_back(d);
+
+      data = &(regions.back());
+      region_ids.insert(std::make_pair(name, data));
+    }
+  }
+}
+
+
+void
+PerfRegion::start()
+{
+  int tid = perfThread();
+  PerfRegionData& d = *data;
+  if (tid >= int(d.threads.size()) || tid >= int(thread_events.size()))
+    return;
+
+  PerfRegionThread& t = d.threads[tid];
+  if (t.running)
+  {
+    QDPIO::cerr << "PerfRegion::start: region " << d.name << " is already running" << std::endl;
+    return;
+  }
+
+  t.counted = readEvents(thread_events[tid], t.start_events);
+  t.running = true;
+  t.start_ns = getClockTimeNs();
+}
+
+
+void
+PerfRegion::stop()
+{
+  QDPTime_t stop_ns = getClockTimeNs();
+
+  int tid = perfThread();
+  PerfRegionData& d = *data;
+  if (tid >= int(d.threads.size()) || tid >= int(thread_events.size()))
+    return;
+
+  PerfRegionThread& t = d.threads[tid];
+  if (! t.running)
+  {
+    QDPIO::cerr << "PerfRegion::stop: region " << d.name << " is not running" << std::endl;
+    return;
+  }
+
+  unsigned long long val[PERF_NUM_EVENTS];
+  if (t.counted && readEvents(thread_events[tid], val))
+  {
+    for(int e=0; e < PERF_NUM_EVENTS; ++e)
+      t.events[e] += val[e] - t.start_events[e];
+  }
+  else
+    t.counted = false;
+
+  t.count++;
+  t.ns += stop_ns - t.start_ns;
+  t.running = false;
+}
+
+
+void
+PerfRegion::addFlops(unsigned long long flops)
+{
+#pragma omp atomic
+  data->flops += flops;
+}
+
+
+void
+PerfRegion::addBytes(unsigned long long bytes)
+{
+#pragma omp atomic
+  data->bytes += bytes;
+}
+
+
+void
+PerfRegion::reset()
+{
+  PerfRegionData& d = *data;
+  d.flops = d.bytes = 0;
+  for(size_t th=0; th < d.threads.size(); ++th)
+    d.threads[th].clear();
+}
+
+
+namespace
+{
+  //! Print one region
+  void reportRegion(const PerfRegionData& d, const PerfRoofline* roof)
+  {
+    // Threads run concurrently, so the time is the slowest thread's
+    double ns = 0, count = 0;
+    double events[PERF_NUM_EVENTS] = {0, 0, 0};
+    int nthreads = 0;
+    bool counted = true;
+
+    for(size_t th=0; th < d.threads.size(); ++th)
+    {
+      const PerfRegionThread& t = d.threads[th];
+      if (t.count == 0)
+	continue;
+
+      ++nthreads;
+      ns = std::max(ns, t.ns);
+      count = std::max(count, t.count);
+      counted = counted && t.counted;
+      for(int e=0; e < PERF_NUM_EVENTS; ++e)
+	events[e] += t.events[e];
+    }
+
+    if (nthreads == 0)
+      return;
+
+    double bytes = (d.bytes > 0) ? d.bytes : (counted ? cache_line*events[PERF_LLC_MISSES] : 0);
+    double gflops = (ns > 0) ? d.flops/ns : 0;
+    double gbytes = (ns > 0) ? bytes/ns : 0;
+
+    char lin[256];
+    sprintf(lin, "  %-24s %8.0f %3d %12.3f %9.3f",
+	    d.name.c_str(), count, nthreads, ns*1.0e-6, gflops);
+    QDPIO::cout << lin;
+
+    // Without counters the traffic is only known if it was given
+    if (bytes > 0)
+      sprintf(lin, " %9.3f", gbytes);
+    else
+      sprintf(lin, " %9s", "-");
+    QDPIO::cout << lin;
+
+    // Attainable rate at the arithmetic intensity of the region
+    if (roof != 0 && d.flops > 0 && bytes > 0)
+    {
+      double intensity = d.flops / bytes;
+      double bound = std::min(roof->peak, intensity*roof->bandwidth);
+      sprintf(lin, " %7.3f %9.3f %6.1f%%", intensity, bound, (bound > 0) ? 100*gflops/bound : 0.0);
+    }
+    else
+      sprintf(lin, " %7s %9s %7s", "-", "-", "-");
+    QDPIO::cout << lin;
+
+    if (counted)
+    {
+      sprintf(lin, " %6.2f %12.0f",
+	      (events[PERF_CYCLES] > 0) ? events[PERF_INSTRUCTIONS]/events[PERF_CYCLES] : 0.0,
+	      events[PERF_LLC_MISSES]);
+      QDPIO::cout << lin;
+    }
+    QDPIO::cout << std::endl;
+
+    // Each thread, to spot an imbalance
+    if (nthreads > 1 && counted)
+    {
+      for(size_t th=0; th < d.threads.size(); ++th)
+      {
+	const PerfRegionThread& t = d.threads[th];
+	if (t.count == 0)
+	  continue;
+
+	sprintf(lin, "    thread %-3d %12.3f ms %14.0f cycles %14.0f instr %12.0f LLC misses",
+		int(th), t.ns*1.0e-6, t.events[PERF_CYCLES], t.events[PERF_INSTRUCTIONS],
+		t.events[PERF_LLC_MISSES]);
+	QDPIO::cout << lin << std::endl;
+      }
+    }
+  }
+
+  void reportHeader(const PerfRoofline* roof)
+  {
+    QDPIO::cout << std::endl << "QDP perf regions: ";
+    if (roof != 0)
+      QDPIO::cout << "roofline " << roof->peak << " GFlop/s, " << roof->bandwidth << " GB/s per node";
+    else
+      QDPIO::cout << "roofline not measured (-proofline)";
+    QDPIO::cout << "; counters "
+		<< (perfCountersAvailable() ? "available" : "not available, times only") << std::endl;
+
+    char lin[256];
+    sprintf(lin, "  %-24s %8s %3s %12s %9s %9s %7s %9s %7s %6s %12s",
+	    "region", "calls", "thr", "time[ms]", "GF/s", "GB/s", "flop/B", "bound", "%bound",
+	    "IPC", "LLC misses");
+    QDPIO::cout << lin << std::endl;
+  }
+}
+
+
+namespace
+{
+  //! The roofline if it was asked for or measured already, else none
+  const PerfRoofline* reportRoofline()
+  {
+    if (roofline_wanted || roofline_measured)
+      return &perfRoofline();
+
+    return 0;
+  }
+}
+
+
+void
+PerfRegion::report()
+{
+  const PerfRoofline* roof = reportRoofline();
+  reportHeader(roof);
+  reportRegion(*data, roof);
+}
+
+
+void
+printPerfRegions()
+{
+  if (regions.empty())
+    return;
+
+  const PerfRoofline* roof = reportRoofline();
+  reportHeader(roof);
+  for(size_t i=0; i < regions.size(); ++i)
+    reportRegion(regions[i], roof);
+}
+
+
+void
+finalizePerfRegions()
+{
+  for(size_t th=0; th < thread_events.size(); ++th)
+    closeEvents(thread_events[th]);
+}
+
+} // namespace QDP;
@@ -8,20 +8,27 @@
 
 #include "qdp.h"
 #include <time.h>
-
-#if defined(QDP_USE_PROFILING)   
+#include <stdlib.h>
 #include <stack>
-#include <queue>
-#endif
+#include <map>
+#include <algorithm>
+#include <fstream>
 
 
 namespace QDP {
 
+#if defined(QDP_USE_PROFILING)
+// Configured with profiling: on from the start unless the program says otherwise
+static int prof_level = 0;
+static int prog_prof_level = 1;
+#else
 static int prof_level = 0;
 static int prog_prof_level = 0;
-#ifdef QDP_USE_PROFILING
-static bool prof_init = false;
 #endif
+static bool prof_init = false;
+static bool prog_prof_set = false;
+static bool comm_prof = false;
+static bool mem_prof = false;
 int getProfileLevel() {return prof_level;}
 int getProgramProfileLevel() {return prog_prof_level;}
 
@@ -37,70 +44,149 @@ getClockTime()
   //  return (double)clock()/CLOCKS_PER_SEC;
 }
 
+QDPTime_t
+getClockTimeNs()
+{
+  struct timespec tp;
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  return((unsigned long)tp.tv_sec * 1000000000 + (unsigned long)tp.tv_nsec);
+}
+
 
 //--------------------------------------------------------------------------------------
-// Selectively turn on profiling
+// Profile data
 //--------------------------------------------------------------------------------------
 
-#if ! defined(QDP_USE_PROFILING)   
+namespace
+{
+  //! One profiled expression
+  struct ProfileEntry_t
+  {
+    std::string       expr;
+    QDPProfileCost_t  cost;
+  };
 
-//--------------------------------------------------------------------------------------
-// No profiling
-//--------------------------------------------------------------------------------------
+  //! Accumulated timings of an expression on one thread
+  struct ProfileCounter_t
+  {
+    unsigned long  count;
+    QDPTime_t      ns;
+    double         sites;
 
-void initProfile(const std::string& file, const std::string& caller, int line) {}
-void closeProfile() {}
-void printProfile() {}
-int setProfileLevel(int n) {return prof_level;}
-int setProgramProfileLevel(int n) {return prog_prof_level;}
+    ProfileCounter_t() : count(0), ns(0), sites(0) {}
+  };
 
-void pushProfileInfo(int level, const std::string& file, const std::string& caller, int line) {}
-void popProfileInfo() {}
+  // A stack to hold profile info
+  std::stack<QDPProfileInfo_t> infostack;
 
-#else   // Profiling enabled
+  // The expressions, looked up by their text. Changed under a lock.
+  std::vector<ProfileEntry_t> entries;
+  std::map<std::string,int> entry_ids;
 
-//--------------------------------------------------------------------------------------
-// Profiling enabled
-//--------------------------------------------------------------------------------------
+  // Counters of each thread, indexed by expression. The last one is
+  // shared by threads beyond the ones known at startup and is locked.
+  std::vector< std::vector<ProfileCounter_t> > counters;
 
-// A stack to hold profile info
-std::stack<QDPProfileInfo_t> infostack;
+  std::string prof_output;
 
-// A queue for the profile data
-std::queue<QDPProfileHead_t> profqueue;
+  // Communication counters, looked up by kind and name
+  std::vector<QDPCommStat_t> comm_stats;
+  std::map<std::string,int> comm_ids;
 
+  const char* commKindName(int kind)
+  {
+    static const char* names[] = {"shift", "sum", "bcast", "send"};
+    return names[kind];
+  }
 
+  inline int profileThread()
+  {
+#if defined(QDP_USE_OMP_THREADS)
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
 
-void
-QDPProfile_t::init()
-{
-  time = 0;
-  expr = "";
-  count = 0;
-  next = 0;
-}
+  inline void addCounter(std::vector<ProfileCounter_t>& c, int id, QDPTime_t ns, int nsites)
+  {
+    if (c.size() <= (size_t)id)
+      c.resize(id+1);
 
-void 
-QDPProfile_t::print()
-{
-  if ((getProfileLevel() & 2) > 0)
+    c[id].count++;
+    c[id].ns += ns;
+    c[id].sites += nsites;
+  }
+
+  //! Totals of one expression over threads and nodes
+  struct ProfileTotal_t
+  {
+    std::string       expr;
+    QDPProfileCost_t  cost;
+    double            count;
+    double            ns;
+    double            sites;
+
+    bool operator<(const ProfileTotal_t& a) const {return ns > a.ns;}
+  };
+
+  std::string jsonEscape(const std::string& s)
   {
-    QDPIO::cout << expr
-		<< "\t[" << time << "]" << std::endl;
+    std::string r;
+    for(size_t i=0; i < s.size(); ++i)
+    {
+      if (s[i] == '"' || s[i] == '\\')
+	r += '\\';
+      r += s[i];
+    }
+    return r;
+  }
+
+  std::string csvEscape(const std::string& s)
+  {
+    std::string r = "\"";
+    for(size_t i=0; i < s.size(); ++i)
+    {
+      if (s[i] == '"')
+	r += '"';
+      r += s[i];
+    }
+    return r + "\"";
   }
 }
 
-void 
+
+void
 initProfile(const std::string& file, const std::string& caller, int line)
 {
   if (prof_init)
     return;
 
-  pushProfileInfo(0, file, caller, line);
+  // The environment may switch profiling on without touching the
+  // program; -p on the command line takes precedence
+  const char* env = getenv("QDP_PROFILE");
+  if (env != 0 && ! prog_prof_set)
+    setProgramProfileLevel(atoi(env));
+
+  const char* env_out = getenv("QDP_PROFILE_OUTPUT");
+  if (env_out != 0 && prof_output.empty())
+    setProfileOutput(env_out);
+
+  const char* env_comm = getenv("QDP_COMM_PROFILE");
+  if (env_comm != 0 && atoi(env_comm) != 0)
+    setCommProfile(true);
+
+  const char* env_mem = getenv("QDP_MEMORY_PROFILE");
+  if (env_mem != 0 && atoi(env_mem) != 0)
+    setMemoryProfile(true);
+
+  counters.resize(qdpNumThreads() + 1);
+
+  pushProfileInfo(getProgramProfileLevel(), file, caller, line);
   prof_init = true;
 }
 
-void 
+void
 closeProfile()
 {
   if (! prof_init)
@@ -109,50 +195,396 @@ closeProfile()
   popProfileInfo();
 }
 
-void 
+void
+setProfileOutput(const std::string& prefix)
+{
+  prof_output = prefix;
+}
+
+void
+registerProfile(QDPProfile_t* qp, const std::string& expr, const QDPProfileCost_t& cost)
+{
+#pragma omp critical (qdp_profile_register)
+  {
+    if (qp->id < 0)
+    {
+      std::map<std::string,int>::const_iterator p = entry_ids.find(expr);
+      if (p != entry_ids.end())
+      {
+	qp->id = p->second;
+      }
+      else
+      {
+	ProfileEntry_t e;
+	e.expr = expr;
+	e.cost = cost;
+	entries.push_back(e);
+
+	qp->id = entries.size() - 1;
+	entry_ids.insert(std::make_pair(expr, qp->id));
+      }
+    }
+  }
+}
+
+void
+recordProfile(int id, QDPTime_t ns, int nsites)
+{
+  if (counters.empty())
+    return;
+
+  int tid = profileThread();
+  if (tid < int(counters.size()) - 1)
+  {
+    addCounter(counters[tid], id, ns, nsites);
+  }
+  else
+  {
+#pragma omp critical (qdp_profile_overflow)
+    addCounter(counters.back(), id, ns, nsites);
+  }
+
+  if ((getProfileLevel() & 2) > 0)
+  {
+#pragma omp critical (qdp_profile_register)
+    QDPIO::cout << entries[id].expr
+		<< "\t[" << ns << " ns]" << std::endl;
+  }
+}
+
+void
 printProfile()
 {
-  if (profqueue.size() == 0)
+  // Every node takes part: the primary node's expressions are the list
+  // that is reduced, which is all of them for an SPMD program
+  std::string names;
+  for(size_t i=0; i < entries.size(); ++i)
+    names += entries[i].expr + '\n';
+
+  QDPInternal::broadcast(names);
+
+  if (names.empty())
     return;
 
-  while(! profqueue.empty())
+  std::vector<ProfileTotal_t> tot;
+  for(size_t beg=0, end; (end = names.find('\n', beg)) != std::string::npos; beg = end+1)
   {
-    QDPProfileHead_t& head = profqueue.front();
+    ProfileTotal_t t;
+    t.expr = names.substr(beg, end-beg);
+    t.count = t.ns = t.sites = 0;
+    tot.push_back(t);
+  }
 
-    if (head.start != 0)
-    {
-      QDPProfile_t *qp = head.start;
+  const int n = tot.size();
+  std::vector<double> sums(3*n, 0.0);
+
+  for(int i=0; i < n; ++i)
+  {
+    std::map<std::string,int>::const_iterator p = entry_ids.find(tot[i].expr);
+    if (p == entry_ids.end())
+      continue;
 
-      QDPIO::cout << std::endl
-		  << "func = " << head.info.caller 
-		  << "   line = " << head.info.line 
-		  << "   file = " << head.info.file
-		  << std::endl;
+    int id = p->second;
+    tot[i].cost = entries[id].cost;
 
-      while(qp)
-      {
-	if (qp->count > 0)
-	{
-//	  QDPIO::cout << "   " << qp->count << "  [" << qp->time << "]  " << qp->expr << std::endl;
-
-	  // Gag, I still have not really grokked the fricken SL iostream field
-	  // width manipulators. Drop down to low tech just to get out
-	  // the bleaping thing. Note: the real problem is the QDPIO::cout class
-	  // is not really a stream instantiation, hence the needed member functions
-	  // are not there. Sigh.
-	  char lin[80];  // more than adequate
-	  sprintf(lin, "  %7d   [%8d]  ", qp->count, qp->time);
-	  QDPIO::cout << lin << qp->expr << std::endl;
-	}
-
-	qp = qp->next;
-      }
+    for(size_t th=0; th < counters.size(); ++th)
+    {
+      if (counters[th].size() <= (size_t)id)
+	continue;
+
+      const ProfileCounter_t& c = counters[th][id];
+      sums[3*i+0] += c.count;
+      sums[3*i+1] += c.ns;
+      sums[3*i+2] += c.sites;
     }
+  }
+
+  QDPInternal::globalSumArray(&(sums[0]), 3*n);
+
+  // Nodes run concurrently, so times are averaged over them
+  const double nodes = Layout::numNodes();
+  double total_ns = 0;
+  for(int i=0; i < n; ++i)
+  {
+    tot[i].count = sums[3*i+0];
+    tot[i].ns    = sums[3*i+1] / nodes;
+    tot[i].sites = sums[3*i+2];
+    total_ns += tot[i].ns;
+  }
+
+  std::stable_sort(tot.begin(), tot.end());
+
+  QDPIO::cout << std::endl << "QDP profile: " << n << " expressions, "
+	      << total_ns*1.0e-9 << " s" << std::endl;
 
-    profqueue.pop();
+  char lin[160];
+  sprintf(lin, "  %10s %12s %6s %10s %9s %9s  ",
+	  "calls", "time[ms]", "%", "ns/call", "GB/s", "GF/s");
+  QDPIO::cout << lin << "expression" << std::endl;
+
+  for(int i=0; i < n; ++i)
+  {
+    const ProfileTotal_t& t = tot[i];
+    double bytes = t.cost.bytes * t.sites;
+    double flops = t.cost.flops * t.sites;
+
+    sprintf(lin, "  %10.0f %12.3f %6.2f %10.0f %9.3f %9.3f  ",
+	    t.count, t.ns*1.0e-6, (total_ns > 0) ? 100*t.ns/total_ns : 0.0,
+	    (t.count > 0) ? t.ns*nodes/t.count : 0.0,
+	    (t.ns > 0) ? bytes/t.ns : 0.0,
+	    (t.ns > 0) ? flops/t.ns : 0.0);
+    QDPIO::cout << lin << t.expr << std::endl;
+  }
+
+  if (prof_output.empty() || ! Layout::primaryNode())
+    return;
+
+  std::ofstream json((prof_output + ".json").c_str());
+  json.precision(15);
+  json << "{\n  \"nodes\": " << Layout::numNodes()
+       << ",\n  \"total_ns\": " << total_ns
+       << ",\n  \"expressions\": [";
+  for(int i=0; i < n; ++i)
+  {
+    const ProfileTotal_t& t = tot[i];
+    json << ((i == 0) ? "\n" : ",\n")
+	 << "    {\"expr\": \"" << jsonEscape(t.expr) << "\""
+	 << ", \"calls\": " << t.count
+	 << ", \"ns\": " << t.ns
+	 << ", \"sites\": " << t.sites
+	 << ", \"bytes\": " << t.cost.bytes * t.sites
+	 << ", \"flops\": " << t.cost.flops * t.sites << "}";
+  }
+  json << "\n  ]\n}\n";
+
+  std::ofstream csv((prof_output + ".csv").c_str());
+  csv.precision(15);
+  csv << "calls,ns,sites,bytes,flops,expr\n";
+  for(int i=0; i < n; ++i)
+  {
+    const ProfileTotal_t& t = tot[i];
+    csv << t.count << "," << t.ns << "," << t.sites << ","
+	<< t.cost.bytes * t.sites << "," << t.cost.flops * t.sites << ","
+	<< csvEscape(t.expr) << "\n";
   }
 }
 
+//--------------------------------------------------------------------------------------
+// Communication counters
+//--------------------------------------------------------------------------------------
+
+bool
+setCommProfile(bool on)
+{
+  bool old = comm_prof;
+  comm_prof = on;
+  return old;
+}
+
+bool getCommProfile() {return comm_prof;}
+
+int
+commProfileId(QDPCommKind_t kind, const std::string& name)
+{
+  std::string key = std::string(commKindName(kind)) + '\t' + name;
+
+  std::map<std::string,int>::const_iterator p = comm_ids.find(key);
+  if (p != comm_ids.end())
+    return p->second;
+
+  QDPCommStat_t c;
+  c.name = name;
+  c.kind = kind;
+  comm_stats.push_back(c);
+
+  int id = comm_stats.size() - 1;
+  comm_ids.insert(std::make_pair(key, id));
+  return id;
+}
+
+void
+recordComm(int id, double bytes, QDPTime_t pack_ns, QDPTime_t wait_ns, QDPTime_t unpack_ns)
+{
+  QDPCommStat_t& c = comm_stats[id];
+  c.count++;
+  c.bytes += bytes;
+  c.pack_ns += pack_ns;
+  c.wait_ns += wait_ns;
+  c.unpack_ns += unpack_ns;
+}
+
+void
+recordComm(QDPTime_t start, QDPCommKind_t kind, const char* op, const char* word, int len,
+	   double bytes)
+{
+  if (start == 0)
+    return;
+
+  QDPTime_t ns = getClockTimeNs() - start;
+
+  std::ostringstream os;
+  // A varying length would make a new site of every call
+  os << op << "(" << word << "[";
+  if (len < 0)
+    os << "n";
+  else
+    os << len;
+  os << "])";
+  recordComm(commProfileId(kind, os.str()), bytes, 0, ns, 0);
+}
+
+std::vector<QDPCommStat_t>
+getCommStats()
+{
+  return comm_stats;
+}
+
+void
+resetCommStats()
+{
+  for(size_t i=0; i < comm_stats.size(); ++i)
+  {
+    QDPCommStat_t& c = comm_stats[i];
+    c.count = c.bytes = c.pack_ns = c.wait_ns = c.unpack_ns = 0;
+  }
+}
+
+void
+printCommProfile()
+{
+  // The reductions of the report are not counted
+  bool old = setCommProfile(false);
+
+  // As for the expressions, the primary node's call sites are reduced
+  std::string names;
+  for(size_t i=0; i < comm_stats.size(); ++i)
+    names += std::string(commKindName(comm_stats[i].kind)) + '\t' + comm_stats[i].name + '\n';
+
+  QDPInternal::broadcast(names);
+
+  if (names.empty())
+  {
+    setCommProfile(old);
+    return;
+  }
+
+  std::vector<std::string> keys;
+  for(size_t beg=0, end; (end = names.find('\n', beg)) != std::string::npos; beg = end+1)
+    keys.push_back(names.substr(beg, end-beg));
+
+  // Totals of each site, then the wait time of each node to find the slowest
+  const int n = keys.size();
+  const int nodes = Layout::numNodes();
+  const int nsum = 5;
+  std::vector<double> sums(nsum*n + nodes*n, 0.0);
+
+  for(int i=0; i < n; ++i)
+  {
+    std::map<std::string,int>::const_iterator p = comm_ids.find(keys[i]);
+    if (p == comm_ids.end())
+      continue;
+
+    const QDPCommStat_t& c = comm_stats[p->second];
+    sums[nsum*i+0] = c.count;
+    sums[nsum*i+1] = c.bytes;
+    sums[nsum*i+2] = c.pack_ns;
+    sums[nsum*i+3] = c.wait_ns;
+    sums[nsum*i+4] = c.unpack_ns;
+    sums[nsum*n + n*Layout::nodeNumber() + i] = c.wait_ns;
+  }
+
+  QDPInternal::globalSumArray(&(sums[0]), sums.size());
+
+  setCommProfile(old);
+
+  // Sorted by the average wait
+  std::vector< std::pair<double,int> > order;
+  for(int i=0; i < n; ++i)
+    if (sums[nsum*i+0] > 0)
+      order.push_back(std::make_pair(-sums[nsum*i+3], i));
+
+  std::stable_sort(order.begin(), order.end());
+
+  std::vector<double> max_wait(n, 0.0);
+  for(int node=0; node < nodes; ++node)
+    for(int i=0; i < n; ++i)
+      max_wait[i] = std::max(max_wait[i], sums[nsum*n + n*node + i]);
+
+  QDPIO::cout << std::endl << "QDP communications: " << order.size() << " call sites on " 
+	      << nodes << " nodes, times averaged over nodes" << std::endl;
+
+  char lin[200];
+  sprintf(lin, "  %-6s %10s %12s %10s %10s %10s %10s %10s %9s  ",
+	  "kind", "calls", "MB", "pack[ms]", "wait[ms]", "max[ms]", "unpack[ms]", "us/call", "GB/s");
+  QDPIO::cout << lin << "site" << std::endl;
+
+  for(size_t k=0; k < order.size(); ++k)
+  {
+    int i = order[k].second;
+    const double* s = &(sums[nsum*i]);
+    const double calls = s[0] / nodes;
+    const double wait  = s[3] / nodes;
+    std::string::size_type tab = keys[i].find('\t');
+
+    sprintf(lin, "  %-6s %10.0f %12.3f %10.3f %10.3f %10.3f %10.3f %10.2f %9.3f  ",
+	    keys[i].substr(0, tab).c_str(), s[0], s[1]*1.0e-6,
+	    s[2]*1.0e-6/nodes, wait*1.0e-6, max_wait[i]*1.0e-6, s[4]*1.0e-6/nodes,
+	    (calls > 0) ? wait*1.0e-3/calls : 0.0,
+	    (wait > 0) ? s[1]/nodes/wait : 0.0);
+    QDPIO::cout << lin << keys[i].substr(tab+1) << std::endl;
+  }
+
+  if (prof_output.empty() || ! Layout::primaryNode())
+    return;
+
+  std::ofstream json((prof_output + "_comm.json").c_str());
+  json.precision(15);
+  json << "{\n  \"nodes\": " << nodes << ",\n  \"sites\": [";
+  for(size_t k=0; k < order.size(); ++k)
+  {
+    int i = order[k].second;
+    const double* s = &(sums[nsum*i]);
+    std::string::size_type tab = keys[i].find('\t');
+
+    json << ((k == 0) ? "\n" : ",\n")
+	 << "    {\"kind\": \"" << keys[i].substr(0, tab) << "\""
+	 << ", \"site\": \"" << jsonEscape(keys[i].substr(tab+1)) << "\""
+	 << ", \"calls\": " << s[0]
+	 << ", \"bytes\": " << s[1]
+	 << ", \"pack_ns\": " << s[2]/nodes
+	 << ", \"wait_ns\": " << s[3]/nodes
+	 << ", \"max_wait_ns\": " << max_wait[i]
+	 << ", \"unpack_ns\": " << s[4]/nodes << "}";
+  }
+  json << "\n  ]\n}\n";
+
+  std::ofstream csv((prof_output + "_comm.csv").c_str());
+  csv.precision(15);
+  csv << "kind,calls,bytes,pack_ns,wait_ns,max_wait_ns,unpack_ns,site\n";
+  for(size_t k=0; k < order.size(); ++k)
+  {
+    int i = order[k].second;
+    const double* s = &(sums[nsum*i]);
+    std::string::size_type tab = keys[i].find('\t');
+
+    csv << keys[i].substr(0, tab) << "," << s[0] << "," << s[1] << ","
+	<< s[2]/nodes << "," << s[3]/nodes << "," << max_wait[i] << "," << s[4]/nodes << ","
+	<< csvEscape(keys[i].substr(tab+1)) << "\n";
+  }
+}
+
+
+bool
+setMemoryProfile(bool on)
+{
+  bool old = mem_prof;
+  mem_prof = on;
+  return old;
+}
+
+bool getMemoryProfile() {return mem_prof;}
+
+
 int
 setProfileLevel(int n)
 {
@@ -166,6 +598,7 @@ setProgramProfileLevel(int n)
 {
   int old = prog_prof_level;
   prog_prof_level = n;
+  prog_prof_set = true;
   return old;
 }
 
@@ -176,15 +609,12 @@ void pushProfileInfo(int level, const std::string& file, const std::string& call
 
   setProfileLevel(level);
 
-  QDPProfileHead_t  head(infostack.top());
-  profqueue.push(head);
-
   if ((level & 2) > 0)
   {
     QDPIO::cout << std::endl
-		<< "func = " << head.info.caller 
-		<< "   line = " << head.info.line 
-		<< "   file = " << head.info.file
+		<< "func = " << info.caller
+		<< "   line = " << info.line
+		<< "   file = " << info.file
 		<< std::endl;
   }
 }
@@ -203,27 +633,4 @@ void popProfileInfo()
   infostack.pop();
 }
 
-void
-registerProfile(QDPProfile_t* qp)
-{
-  if (profqueue.empty())
-  {
-    QDPIO::cerr << "registerProfile: profile queue empty" << std::endl;
-    QDP_abort(1);
-  }
-
-  QDPProfileHead_t& head = profqueue.back();
-  if (head.start == 0)
-  {
-    head.start = head.end = qp;
-  }
-  else
-  {
-    head.end->next = qp;
-    head.end = qp;
-  }
-}
-
-#endif  // ! defined(QDP_USE_PROFILING)
-
 } // namespace QDP;
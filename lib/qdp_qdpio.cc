@@ -11,25 +11,17 @@ namespace QDP
   //-----------------------------------------
   static int get_node_number(const int coord[])
   {
-    multi1d<int> crd(Nd);
-    crd = coord;   // an array copy
-    int node = Layout::nodeNumber(crd);
-    return node;
+    return Layout::QDPXX_nodeNumber(coord);
   }
 
   static int get_node_index(const int coord[])
   {
-    multi1d<int> crd(Nd);
-    crd = coord;   // an array copy
-    int linear = Layout::linearSiteIndex(crd);
-    return linear;
+    return Layout::QDPXX_getLinearSiteIndex(coord);
   }
 
   static void get_coords(int coord[], int node, int linear)
   {
-    multi1d<int> crd = Layout::siteCoords(node, linear);
-    for(int i=0; i < Nd; ++i)
-      coord[i] = crd[i];
+    Layout::QDPXX_getSiteCoords(coord, node, linear);
   }
 
   static int get_sites_on_node(int node) 
@@ -24,6 +24,31 @@ namespace RNG
   Seed ran_mult_n;
   //! The lattice of skewed RNG multipliers
   LatticeSeed *lattice_ran_mult;
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  //! The skewed RNG multipliers packed into words
+  RanWord *lattice_ran_mult_word = 0;
+
+  //! The seeds live modulo 2^47
+  static const RanWord ran_mask = (RanWord(1) << 47) - 1;
+
+  //! Counter of the counter based generator
+  RanWord ran_counter = 0;
+
+  //! Generator used by random() and gaussian()
+  static RNGType ran_type = RNG_LCG;
+
+  //! Whether the layout has been created, so the LCG multipliers can be made
+  static bool ran_layout_ready = false;
+
+  //! Pack the four 12 bit limbs of a seed
+  static RanWord packSeed(const PSeed< RScalar<INTEGER32> >& s)
+  {
+    return RanWord(s.elem(0).elem())
+      | (RanWord(s.elem(1).elem()) << 12)
+      | (RanWord(s.elem(2).elem()) << 24)
+      | (RanWord(s.elem(3).elem()) << 36);
+  }
+#endif
 
     //! Find the number of bits required to represent x.
   int numbits(int x)
@@ -43,7 +68,15 @@ namespace RNG
   //! Initialize the random number generator with a default seed
   void initDefaultRNG()
   {
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+    ran_layout_ready = true;
+
+    // The counter based generator needs no setup
+    if (ran_type == RNG_LCG)
+      RNG::initRNG();
+#else
     RNG::initRNG();
+#endif
 
     Seed seed = 11;
     RNG::setrn(seed);
@@ -158,6 +191,17 @@ namespace RNG
 
     *lattice_ran_mult = lattice_ran_mult_tmp;
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+    delete[] lattice_ran_mult_word;
+    lattice_ran_mult_word = new(std::nothrow) RanWord[Layout::sitesOnNode()];
+    if( lattice_ran_mult_word == 0x0 ) { 
+      QDP_error_exit("Unable to allocate ran_mult words\n");
+    }
+
+    for(int i=0; i < Layout::sitesOnNode(); ++i)
+      lattice_ran_mult_word[i] = packSeed(lattice_ran_mult->elem(i).elem());
+#endif
+
     QDPIO::cout << "Finished init of RNG" << std::endl; 
 
     setProfileLevel(old_profile_level);
@@ -170,6 +214,13 @@ namespace RNG
   {
     if (lattice_ran_mult)
        delete lattice_ran_mult;
+    lattice_ran_mult = 0;
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+    delete[] lattice_ran_mult_word;
+    lattice_ran_mult_word = 0;
+    ran_layout_ready = false;
+#endif
   }
 
 
@@ -177,6 +228,9 @@ namespace RNG
   void setrn(const Seed& seed)
   {
     ran_seed = seed;
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+    ran_counter = 0;
+#endif
   }
 
 
@@ -283,6 +337,158 @@ namespace RNG
     skewed_seed = ran_tmp2;
   }
 
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  RanWord seedToWord(const Seed& seed)
+  {
+    return packSeed(seed.elem().elem());
+  }
+
+
+  void wordToSeed(Seed& seed, RanWord w)
+  {
+    PSeed< RScalar<INTEGER32> >& s = seed.elem().elem();
+    s.elem(0).elem() = INTEGER32(w & 4095);
+    s.elem(1).elem() = INTEGER32((w >> 12) & 4095);
+    s.elem(2).elem() = INTEGER32((w >> 24) & 4095);
+    s.elem(3).elem() = INTEGER32((w >> 36) & 2047);
+  }
+
+
+  void ranPowers(RanWord* pw, int n, RanWord mult)
+  {
+    RanWord p = 1;
+    for(int k=0; k < n; ++k)
+    {
+      pw[k] = p;
+      p = (p * mult) & ran_mask;
+    }
+  }
+
+
+  //! Scalar random number generator over a whole stream
+  /*!
+   * Multiplication modulo 2^47 is the low bits of the 64 bit product, so
+   * each step is one integer multiply. The conversion repeats the
+   * operations of seedToFloat in single precision, so the numbers are
+   * bit for bit those of sranf.
+   */
+  void fillUniforms(float* u, int n, RanWord skewed_seed, const RanWord* pw)
+  {
+    // Same operation order and REAL32 arithmetic as seedToFloat
+    const REAL32 twom11 = REAL32(1.0 / 2048.0);
+    const REAL32 twom12 = REAL32(1.0 / 4096.0);
+
+    for(int k=0; k < n; ++k)
+    {
+      RanWord w = (skewed_seed * pw[k]) & ran_mask;
+
+      REAL32 d = twom12 * REAL32(INTEGER32(w & 4095));
+      d = twom12 * (REAL32(INTEGER32((w >> 12) & 4095)) + d);
+      d = twom12 * (REAL32(INTEGER32((w >> 24) & 4095)) + d);
+      d = twom11 * (REAL32(INTEGER32(w >> 36)) + d);
+
+      u[k] = d;
+    }
+  }
+
+
+  void setRNGType(RNGType type)
+  {
+    ran_type = type;
+
+    // Build the multipliers if the layout skipped them
+    if (type == RNG_LCG && ran_layout_ready && lattice_ran_mult_word == 0)
+      initRNG();
+  }
+
+
+  RNGType getRNGType()
+  {
+    return ran_type;
+  }
+
+
+  void setrn(const CounterSeed& seed)
+  {
+    ran_seed    = seed.key;
+    ran_counter = seed.counter;
+  }
+
+
+  void savern(CounterSeed& seed)
+  {
+    seed.key     = ran_seed;
+    seed.counter = ran_counter;
+  }
+
+
+  RanWord globalSiteIndex(int linear)
+  {
+    // Same lexicographic ordering as the LCG multipliers in initRNG
+    Coord<Nd> coord;
+    Layout::siteCoords(coord, Layout::nodeNumber(), linear);
+    const multi1d<int>& nrow = Layout::lattSize();
+
+    RanWord site = coord[Nd-1];
+    for(int m=Nd-2; m >= 0; --m)
+      site = site*nrow[m] + coord[m];
+
+    return site;
+  }
+
+
+  //! 32x32 -> 64 bit multiply split in high and low words
+  static inline void mulhilo(unsigned int a, unsigned int b, unsigned int& hi, unsigned int& lo)
+  {
+    RanWord p = RanWord(a) * RanWord(b);
+    hi = (unsigned int)(p >> 32);
+    lo = (unsigned int)(p);
+  }
+
+
+  //! Philox-4x32-10 of Salmon et al, SC11
+  static inline void philox4x32(unsigned int c[4], unsigned int k0, unsigned int k1)
+  {
+    for(int r=0; r < 10; ++r)
+    {
+      unsigned int hi0, lo0, hi1, lo1;
+      mulhilo(0xD2511F53u, c[0], hi0, lo0);
+      mulhilo(0xCD9E8D57u, c[2], hi1, lo1);
+
+      c[0] = hi1 ^ c[1] ^ k0;
+      c[1] = lo1;
+      c[2] = hi0 ^ c[3] ^ k1;
+      c[3] = lo0;
+
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+  }
+
+
+  void fillCounterUniforms(float* u, int n, RanWord key, RanWord site, RanWord counter)
+  {
+    // (x + 1/2) / 2^23 from the top 23 bits is exact in single precision
+    // and never 0 or 1, so it is safe for the log of Box-Muller
+    const float twom23 = 1.0f / 8388608.0f;
+
+    for(int k=0, block=0; k < n; ++block)
+    {
+      unsigned int c[4];
+      c[0] = block;
+      c[1] = (unsigned int)(site);
+      c[2] = (unsigned int)(counter);
+      c[3] = (unsigned int)(counter >> 32);
+
+      philox4x32(c, (unsigned int)(key), (unsigned int)(key >> 32));
+
+      for(int j=0; j < 4 && k < n; ++j, ++k)
+	u[k] = (float(c[j] >> 9) + 0.5f) * twom23;
+    }
+  }
+#endif
+
 };
 
 } // namespace QDP;
@@ -89,24 +89,40 @@ void QDP_initialize(int *argc, char ***argv)
     fprintf(stderr,"Usage:    %s options\n",(*argv)[0]);
     fprintf(stderr,"options:\n");
     fprintf(stderr,"    -h        help\n");
-#if defined(QDP_USE_PROFILING)   
     fprintf(stderr,"    -p        %%d [%d] profile level\n", 
 	    getProfileLevel());
-#endif
+    fprintf(stderr,"    -pout     %%s    also write the profile to <prefix>.json and .csv\n");
+    fprintf(stderr,"    -pcomm          count shift, reduction and broadcast messages\n");
+    fprintf(stderr,"    -pmem           print the use of memory by caller and size\n");
+    fprintf(stderr,"    -proofline      measure the node roofline for the perf region report\n");
 
     exit(1);
   }
 
   for (int i=1; i<*argc; i++) 
   {
-#if defined(QDP_USE_PROFILING)   
     if (strcmp((*argv)[i], "-p")==0) 
     {
       int lev;
       sscanf((*argv)[++i], "%d", &lev);
       setProgramProfileLevel(lev);
     }
-#endif
+    else if (strcmp((*argv)[i], "-pout")==0) 
+    {
+      setProfileOutput((*argv)[++i]);
+    }
+    else if (strcmp((*argv)[i], "-pcomm")==0) 
+    {
+      setCommProfile(true);
+    }
+    else if (strcmp((*argv)[i], "-pmem")==0) 
+    {
+      setMemoryProfile(true);
+    }
+    else if (strcmp((*argv)[i], "-proofline")==0) 
+    {
+      setPerfRoofline(true);
+    }
 
     if (i >= *argc) 
     {
@@ -123,6 +139,12 @@ bool QDP_isInitialized() {return isInit;}
 //! Turn off the machine
 void QDP_finalize()
 {
+  // Finish any checkpoint written in the background
+  waitCheckpoint();
+
+  // Report the perf regions while the threads are still up
+  printPerfRegions();
+  finalizePerfRegions();
 
 #if defined(QDP_USE_HDF5)
   H5close();
@@ -148,6 +170,10 @@ void QDP_finalize()
     qmt_finalize();
 #endif 
 
+  if (getMemoryProfile())
+    Allocator::theQDPAllocator::Instance().printStats();
+
+  printCommProfile();
   printProfile();
 
   isInit = false;
@@ -38,6 +38,9 @@ namespace QDP
       //! Lattice size
       multi1d<int> nrow;
 
+      //! Lattice size for the allocation free index functions
+      Coord<Nd> nrow_c;
+
       //! Subgrid lattice volume
       int subgrid_vol;
 
@@ -92,6 +95,9 @@ namespace QDP
     //! Returns the logical node number for the corresponding lattice coordinate
     int nodeNumber(const multi1d<int>& coord) {return 0;}
 
+    //! Returns the logical node number for the corresponding lattice coordinate
+    int nodeNumber(const Coord<Nd>& coord) {return 0;}
+
     //! Returns the number of nodes
     int numNodes() {return 1;}
 
@@ -159,7 +165,10 @@ namespace QDP
     //! The linearized site index for the corresponding lexicographic site
     int linearSiteIndex(int lexicosite)
     {
-      return linearSiteIndex(crtesn(lexicosite, lattSize()));
+      Coord<Nd> coord;
+      crtesn(coord, lexicosite, _layout.nrow_c);
+
+      return linearSiteIndex(coord);
     }
 
     //! Initializer for all the layout defaults
@@ -181,6 +190,11 @@ namespace QDP
       setIONodeGridDefaults();	
     }
 
+#if QDP_USE_CB2_BLOCK_LAYOUT == 1
+    //! Fix the block size of the blocked layout for the current lattice
+    void initBlockLayout();
+#endif
+
     //! Initializer for layout
     void create()
     {
@@ -196,6 +210,7 @@ namespace QDP
 	_layout.vol *= _layout.nrow[i];
 
       _layout.subgrid_vol = _layout.vol;
+      _layout.nrow_c = Coord<Nd>(_layout.nrow);
   
       _layout.logical_coord.resize(Nd);
       _layout.logical_size.resize(Nd);
@@ -234,12 +249,17 @@ namespace QDP
       QDPIO::cout << "  total volume = " << _layout.vol << std::endl;
       QDPIO::cout << "  subgrid volume = " << _layout.vol << std::endl;
 
+#if QDP_USE_CB2_BLOCK_LAYOUT == 1
+      initBlockLayout();
+#endif
 
       // Sanity check - check the layout functions make sense
 #pragma omp parallel for
       for(int i=0; i < _layout.vol; ++i) 
       {
-	int j = Layout::linearSiteIndex(Layout::siteCoords(Layout::nodeNumber(),i));
+	Coord<Nd> coord;
+	Layout::siteCoords(coord, Layout::nodeNumber(), i);
+	int j = Layout::linearSiteIndex(coord);
 
 #if QDP_DEBUG >= 3
 	{
@@ -279,16 +299,16 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
-      return crtesn(linearsite, lattSize());
+      crtesn(coord, linearsite, _layout.nrow_c);
     }
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is a simple lexicographic lattice ordering */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
-      return local_site(coord, lattSize());
+      return local_site(coord, _layout.nrow_c);
     }
   }
 
@@ -306,39 +326,37 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int vol_cb = vol() >> 1;
-      multi1d<int> cb_nrow = lattSize();
+      Coord<Nd> cb_nrow = _layout.nrow_c;
       cb_nrow[0] >>= 1;
 
       int cb = linearsite / vol_cb;
-      multi1d<int> coord = crtesn(linearsite % vol_cb, cb_nrow);
+      crtesn(coord, linearsite % vol_cb, cb_nrow);
 
       int cbb = cb;
-      for(int m=1; m<coord.size(); ++m)
+      for(int m=1; m<Nd; ++m)
 	cbb += coord[m];
       cbb = cbb & 1;
 
       coord[0] = 2*coord[0] + cbb;
-
-      return coord;
     }
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int vol_cb = vol() >> 1;
-      multi1d<int> cb_nrow = lattSize();
+      Coord<Nd> cb_nrow = _layout.nrow_c;
       cb_nrow[0] >>= 1;
 
-      multi1d<int> cb_coord = coord;
+      Coord<Nd> cb_coord = coord;
 
       cb_coord[0] >>= 1;    // Number of checkerboards
     
       int cb = 0;
-      for(int m=0; m<coord.size(); ++m)
+      for(int m=0; m<Nd; ++m)
 	cb += coord[m];
       cb = cb & 1;
 
@@ -366,42 +384,40 @@ namespace QDP
      * NB: Time is local and fastest running 
      */
 
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int vol_cb = vol() / 2;
-      multi1d<int> cb_nrow = lattSize();
+      Coord<Nd> cb_nrow = _layout.nrow_c;
       cb_nrow[0] /=2;
 
       int cb = linearsite / vol_cb;
 
       // This now uses crtesn with the t running fastest
-      multi1d<int> coord = crtesn(linearsite % vol_cb, cb_nrow);
+      crtesn(coord, linearsite % vol_cb, cb_nrow);
 
       int cbb = cb;
-      for(int m=1; m<coord.size()-1; ++m) // Nd-1 checkerboard
+      for(int m=1; m<Nd-1; ++m) // Nd-1 checkerboard
 	cbb += coord[m];
 
       cbb = cbb & 1;
 
       coord[0] = 2*coord[0] + cbb;
-
-      return coord;
     }
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int vol_cb = vol() / 2;
-      multi1d<int> cb_nrow = lattSize();
+      Coord<Nd> cb_nrow = _layout.nrow_c;
       cb_nrow[0] /= 2;
 
-      multi1d<int> cb_coord = coord;
+      Coord<Nd> cb_coord = coord;
 
       cb_coord[0] /= 2;    // Number of checkerboards
     
       int cb = 0;
-      for(int m=0; m<coord.size()-1; ++m) // 3d checkerboard
+      for(int m=0; m<Nd-1; ++m) // 3d checkerboard
 	cb += coord[m];
 
       cb = cb & 1;
@@ -425,16 +441,16 @@ namespace QDP
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
     {
       int vol_cb = vol() >> (Nd+1);
-      multi1d<int> cb_nrow(Nd);
-      cb_nrow[0] = lattSize()[0] >> 2;
+      Coord<Nd> cb_nrow;
+      cb_nrow[0] = _layout.nrow_c[0] >> 2;
       for(int i=1; i < Nd; ++i) 
-	cb_nrow[i] = lattSize()[i] >> 1;
+	cb_nrow[i] = _layout.nrow_c[i] >> 1;
 
       int subl = linearsite / vol_cb;
-      multi1d<int> coord = crtesn(linearsite % vol_cb, cb_nrow);
+      crtesn(coord, linearsite % vol_cb, cb_nrow);
 
       int cb = 0;
       for(int m=1; m<Nd; ++m)
@@ -449,19 +465,17 @@ namespace QDP
       for(int m=0; m<Nd; ++m)
 	coord[m] ^= (subl & (1 << m)) >> m;
       coord[0] ^= (subl & (1 << Nd)) >> (Nd-1);   // this gets the hypercube cb
-
-      return coord;
     }
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 32-style checkerboard lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    int linearSiteIndex(const Coord<Nd>& coord)
     {
       int vol_cb = vol() >> (Nd+1);
-      multi1d<int> cb_nrow(Nd);
-      cb_nrow[0] = lattSize()[0] >> 2;
+      Coord<Nd> cb_nrow;
+      cb_nrow[0] = _layout.nrow_c[0] >> 2;
       for(int i=1; i < Nd; ++i) 
-	cb_nrow[i] = lattSize()[i] >> 1;
+	cb_nrow[i] = _layout.nrow_c[i] >> 1;
 
       int subl = coord[Nd-1] & 1;
       for(int m=Nd-2; m >= 0; --m)
@@ -474,7 +488,7 @@ namespace QDP
       subl += (cb & 1) << Nd;   // Final color or checkerboard
 
       // Construct the checkerboard lattice coord
-      multi1d<int> cb_coord(Nd);
+      Coord<Nd> cb_coord;
 
       cb_coord[0] = coord[0] >> 2;
       for(int m=1; m < Nd; ++m)
@@ -484,6 +498,96 @@ namespace QDP
     }
   }
 
+#elif QDP_USE_CB2_BLOCK_LAYOUT == 1
+
+#warning "Using a 2 checkerboard (red/black) layout stored in 4d blocks"
+
+  namespace Layout
+  {
+    //! Requested and actual block sizes, in checkerboard sites
+    static multi1d<int> block_req;
+    static multi1d<int> block_size;
+    static Coord<Nd> block_c;
+
+    //! Set the requested block size of the blocked layout
+    void setBlockSize(const multi1d<int>& block) {block_req = block;}
+
+    //! The block size in use by the blocked layout
+    const multi1d<int>& blockSize() {return block_size;}
+
+    //! Fix the block size of the blocked layout for the current lattice
+    void initBlockLayout()
+    {
+      if (block_req.size() != Nd)
+      {
+	block_req.resize(Nd);
+	block_req = 4;
+      }
+
+      block_size.resize(Nd);
+      for(int i=0; i < Nd; ++i)
+      {
+	int cb_n = (i == 0) ? (_layout.nrow[0] >> 1) : _layout.nrow[i];
+	int b = std::max(1, std::min(block_req[i], cb_n));
+	while (cb_n % b != 0)
+	  --b;
+
+	block_size[i] = b;
+      }
+      block_c = Coord<Nd>(block_size);
+
+      QDPIO::cout << "  block size =";
+      for(int i=0; i < Nd; ++i)
+	QDPIO::cout << " " << block_size[i];
+      QDPIO::cout << std::endl;
+    }
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    /*! 
+     * This is the inverse of the nodeNumber and linearSiteIndex functions.
+     * The API requires this function to be here.
+     */
+    void siteCoords(Coord<Nd>& coord, int node, int linearsite) // ignore node
+    {
+      int vol_cb = vol() >> 1;
+      Coord<Nd> cb_nrow = _layout.nrow_c;
+      cb_nrow[0] >>= 1;
+
+      int cb = linearsite / vol_cb;
+      block_crtesn(coord, linearsite % vol_cb, cb_nrow, block_c);
+
+      int cbb = cb;
+      for(int m=1; m<Nd; ++m)
+	cbb += coord[m];
+      cbb = cbb & 1;
+
+      coord[0] = 2*coord[0] + cbb;
+    }
+
+    //! The linearized site index for the corresponding coordinate
+    /*! 
+     * Each checkerboard is cut into 4d blocks, so the neighbors in all
+     * directions are near in memory. The checkerboards stay contiguous.
+     */
+    int linearSiteIndex(const Coord<Nd>& coord)
+    {
+      int vol_cb = vol() >> 1;
+      Coord<Nd> cb_nrow = _layout.nrow_c;
+      cb_nrow[0] >>= 1;
+
+      Coord<Nd> cb_coord = coord;
+
+      cb_coord[0] >>= 1;    // Number of checkerboards
+    
+      int cb = 0;
+      for(int m=0; m<Nd; ++m)
+	cb += coord[m];
+      cb = cb & 1;
+
+      return block_site(cb_coord, cb_nrow, block_c) + cb*vol_cb;
+    }
+  }
+
 #else
 
 #error "no appropriate layout defined"
@@ -30,7 +30,9 @@ namespace Layout
 #pragma omp parallel for
     for(int i=0; i < nodeSites; ++i) 
     {
-      Integer cc = Layout::siteCoords(nodeNumber,i)[mu];
+      Coord<Nd> coord;
+      Layout::siteCoords(coord, nodeNumber, i);
+      Integer cc = coord[mu];
       d.elem(i) = cc.elem();
     }
 
@@ -71,6 +73,10 @@ void Set::make(const SetFunc& fun)
 
   // Create the array holding the array of sitetable info
   sitetables.resize(nsubset_indices);
+  siteruns.resize(nsubset_indices);
+
+  // The inverse tables are made on demand
+  sitepos.resize(nsubset_indices);
 
   // Loop over linear sites determining their color
   /* This OMP pragma added by Jacques. Should be OK since in the end 
@@ -178,6 +184,32 @@ void Set::make(const SetFunc& fun)
 
     sub[cb].make(ordRep, start, end, &(sitetables[cb]), cb, this);
 
+    // Compress the sitetable into contiguous runs
+    int num_runs = 0;
+    for(int i=0; i < num_sitetable; ++i)
+      if (i == 0 || sitetable[i] != sitetable[i-1]+1)
+	++num_runs;
+
+    multi1d<SiteRun>& runs = siteruns[cb];
+    runs.resize(num_runs);
+
+    for(int i=0, r=-1; i < num_sitetable; ++i)
+    {
+      if (i == 0 || sitetable[i] != sitetable[i-1]+1)
+      {
+	++r;
+	runs[r].start  = sitetable[i];
+	runs[r].length = 0;
+	runs[r].offset = i;
+      }
+      ++runs[r].length;
+    }
+
+    // Only worth looping over runs when they are not too short
+    bool runRep = (num_runs > 0) && (num_sitetable >= 4*num_runs);
+
+    sub[cb].makeRuns(runRep, &(siteruns[cb]));
+
 #if QDP_DEBUG >= 2
     QDP_info("Subset(%d)",cb);
 #endif
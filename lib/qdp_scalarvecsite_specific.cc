@@ -71,6 +71,9 @@ void Set::make(const SetFunc& func)
   // Create the array holding the array of sitetable info
   sitetables.resize(nsubset_indices);
 
+  // The inverse tables are made on demand
+  sitepos.resize(nsubset_indices);
+
   // Loop over linear sites determining their color
   for(int linear=0; linear < nodeSites; ++linear)
   {
@@ -130,21 +130,32 @@ namespace QDP
   void Subset::make(bool _rep, int _start, int _end, multi1d<int>* ind, int cb, Set* _set)
   {
     ordRep    = _rep;
+    runRep    = false;
     startSite = _start;
     endSite   = _end;
     sub_index = cb;
     sitetable = ind;
+    siteruns  = 0;
     set       = _set;
   }
 
+  //! Attach the run-length form of the site table
+  void Subset::makeRuns(bool _rep, multi1d<SiteRun>* runs)
+  {
+    runRep    = _rep;
+    siteruns  = runs;
+  }
+
   //! Simple constructor called to produce a Subset from inside a Set
   void Subset::make(const Subset& s)
   {
     ordRep    = s.ordRep;
+    runRep    = s.runRep;
     startSite = s.startSite;
     endSite   = s.endSite;
     sub_index = s.sub_index;
     sitetable = s.sitetable;
+    siteruns  = s.siteruns;
     set       = s.set;
   }
 
@@ -162,9 +173,46 @@ namespace QDP
     sub = s.sub;
     lat_color = s.lat_color;
     sitetables = s.sitetables;
+    siteruns = s.siteruns;
+    sitepos = s.sitepos;
     return *this;
   }
 
+
+  //-----------------------------------------------------------------------------
+  //! Position of each site within the sitetable of a subset
+  /*!
+   * Made on first use, since only the checkerboarded fields need it.
+   * Sites outside the subset are given the size of the sitetable.
+   */
+  const multi1d<int>& Set::sitePositions(int subset_index) const
+  {
+#pragma omp critical (qdp_set_sitepos)
+    {
+      multi1d<int>& pos = sitepos[subset_index];
+      if (pos.size() == 0)
+      {
+	const multi1d<int>& tab = sitetables[subset_index];
+	const int nodeSites = Layout::sitesOnNode();
+
+	pos.resize(nodeSites);
+	for(int i=0; i < nodeSites; ++i)
+	  pos[i] = tab.size();
+
+	for(int j=0; j < tab.size(); ++j)
+	  pos[tab[j]] = j;
+      }
+    }
+
+    return sitepos[subset_index];
+  }
+
+  //! Position of each site of the node within the site table
+  const multi1d<int>& Subset::sitePositions() const
+  {
+    return set->sitePositions(sub_index);
+  }
+
   //-----------------------------------------------------------------------------
 
 } // namespace QDP;
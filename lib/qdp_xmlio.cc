@@ -5,6 +5,11 @@
 
 #include "qdp.h"
 #include <list>
+#include <cerrno>
+#include <cstdlib>
+#include <cctype>
+#include <cstdio>
+#include <limits>
 
 namespace QDP 
 {
@@ -13,37 +18,95 @@ namespace QDP
 
   //--------------------------------------------------------------------------------
   // XML classes
+  // Parse new documents on every node?
+  static bool xml_local_parse = false;
+
+  void XMLReader::setLocalParse(bool on) {xml_local_parse = on;}
+
+  bool XMLReader::getLocalParse() {return xml_local_parse;}
+
+  // Write floating point lists with the fewest digits that read back exactly?
+  static bool xml_round_trip = false;
+
+  void XMLWriter::setRoundTrip(bool on) {xml_round_trip = on;}
+
+  bool XMLWriter::getRoundTrip() {return xml_round_trip;}
+
+  // Read the rest of a stream
+  static void slurp(std::istream& is, std::string& doc)
+  {
+    std::ostringstream os;
+    os << is.rdbuf();
+    doc = os.str();
+  }
+
   // XML reader class
-  XMLReader::XMLReader() {iop=derived=false;}
+  XMLReader::XMLReader() {iop=derived=local=false;}
 
   XMLReader::XMLReader(const std::string& filename)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(filename);
   }
 
   XMLReader::XMLReader(std::istream& is)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(is);
   }
 
   XMLReader::XMLReader(const XMLBufferWriter& mw)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(mw);
   }
 
   XMLReader::XMLReader(XMLReader& old, const std::string& xpath) : BasicXPathReader() 
   {
-    iop = false;
+    iop = local = false;
     derived = true;
     open(old, xpath);
   }
 
 
+  void XMLReader::openLocal(std::string& doc)
+  {
+    // One message for the whole document
+    QDPInternal::broadcast_str(doc);
+
+    std::istringstream is(doc);
+    BasicXPathReader::open(is);
+
+    iop = true;
+    derived = false;
+    local = true;
+  }
+
   void XMLReader::open(const std::string& filename)
   {
+    if (xml_local_parse)
+    {
+      std::string doc;
+      if (Layout::primaryNode())
+      {
+#if defined(USE_REMOTE_QIO)
+	QDPUtil::RemoteInputFileStream f;
+	f.open(filename.c_str(),std::ifstream::in);
+#else
+	std::ifstream f;
+	f.open(filename.c_str(), std::ios::binary);
+#endif
+	if (f.fail())
+	{
+	  QDPIO::cerr << "Error opening read file = " << filename << std::endl;
+	  QDP_abort(1);
+	}
+	slurp(f, doc);
+      }
+      openLocal(doc);
+      return;
+    }
+
     if (Layout::primaryNode())
     {
 #if 0
@@ -70,19 +133,39 @@ namespace QDP
 
     iop = true;
     derived = false;
+    local = false;
   }
 
   void XMLReader::open(std::istream& is)
   {
+    if (xml_local_parse)
+    {
+      std::string doc;
+      if (Layout::primaryNode())
+	slurp(is, doc);
+      openLocal(doc);
+      return;
+    }
+
     if (Layout::primaryNode())
       BasicXPathReader::open(is);
 
     iop = true;
     derived = false;
+    local = false;
   }
 
   void XMLReader::open(const XMLBufferWriter& mw)
   {
+    if (xml_local_parse)
+    {
+      std::string doc;
+      if (Layout::primaryNode())
+	doc = const_cast<XMLBufferWriter&>(mw).str()+"\n";
+      openLocal(doc);
+      return;
+    }
+
     if (Layout::primaryNode())
     {  
       std::istringstream is(const_cast<XMLBufferWriter&>(mw).str()+"\n");
@@ -91,11 +174,17 @@ namespace QDP
 
     iop = true;
     derived = false;
+    local = false;
   }
 
   void XMLReader::open(XMLReader& old, const std::string& xpath)
   {
-    if( Layout::primaryNode()) 
+    close();
+
+    // A derived reader lives wherever its parent does
+    local = old.local;
+
+    if (local || Layout::primaryNode()) 
     {
       BasicXPathReader::open((BasicXPathReader&)old, xpath);
     }
@@ -108,11 +197,12 @@ namespace QDP
   {
     if (is_open()) 
     {
-      if (Layout::primaryNode()) 
+      if (local || Layout::primaryNode()) 
 	BasicXPathReader::close();
 
       iop = false;
       derived = false;
+      local = false;
     }
   }
 
@@ -128,6 +218,12 @@ namespace QDP
   // Overloaded Reader Functions
   void XMLReader::get(const std::string& xpath, std::string& result)
   {
+    if (local)
+    {
+      BasicXPathReader::get(xpath, result);
+      return;
+    }
+
     // Only primary node can grab string
     if (Layout::primaryNode()) 
       BasicXPathReader::get(xpath, result);
@@ -173,6 +269,43 @@ namespace QDP
     readPrimitive<bool>(xpath, result);
   }
    
+  void XMLReader::get(const std::string& xpath, multi1d<int>& result)
+  {
+    readArray<int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<unsigned int>& result)
+  {
+    readArray<unsigned int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<short int>& result)
+  {
+    readArray<short int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<unsigned short int>& result)
+  {
+    readArray<unsigned short int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<long int>& result)
+  {
+    readArray<long int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<unsigned long int>& result)
+  {
+    readArray<unsigned long int>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<float>& result)
+  {
+    readArray<float>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<double>& result)
+  {
+    readArray<double>(xpath, result);
+  }
+  void XMLReader::get(const std::string& xpath, multi1d<bool>& result)
+  {
+    readArray<bool>(xpath, result);
+  }
+   
   void XMLReader::getAttribute(const std::string& xpath,
 			       const std::string& attrib_name, 
 			       int& result){
@@ -182,6 +315,12 @@ namespace QDP
   template<typename T>
   void XMLReader::readPrimitive(const std::string& xpath, T& result)
   {
+    if (local)
+    {
+      BasicXPathReader::get(xpath, result);
+      return;
+    }
+
     if (Layout::primaryNode()) {
       BasicXPathReader::get(xpath, result);
     }
@@ -190,11 +329,158 @@ namespace QDP
     QDPInternal::broadcast(result);
   }
 
+  // Number parsers for the list reader. Each reads one token at p,
+  // moves p past it and returns false if the token is not a number.
+  namespace
+  {
+    inline bool endOfToken(const char* p)
+    {
+      return *p == '\0' || isspace((unsigned char)*p);
+    }
+
+    inline bool parseWord(const char*& p, long int& v)
+    {
+      char* end;
+      errno = 0;
+      v = strtol(p, &end, 10);
+      bool ok = (end != p) && (errno == 0) && endOfToken(end);
+      p = end;
+      return ok;
+    }
+
+    inline bool parseWord(const char*& p, unsigned long int& v)
+    {
+      char* end;
+      errno = 0;
+      v = strtoul(p, &end, 10);
+      bool ok = (end != p) && (errno == 0) && endOfToken(end);
+      p = end;
+      return ok;
+    }
+
+    inline bool parseWord(const char*& p, double& v)
+    {
+      char* end;
+      v = strtod(p, &end);
+      bool ok = (end != p) && endOfToken(end);
+      p = end;
+      return ok;
+    }
+
+    inline bool parseWord(const char*& p, float& v)
+    {
+      char* end;
+      v = strtof(p, &end);
+      bool ok = (end != p) && endOfToken(end);
+      p = end;
+      return ok;
+    }
+
+    // Narrower types go through long with a range check
+    template<typename T, typename W>
+    inline bool parseNarrow(const char*& p, T& v)
+    {
+      W w;
+      if (! parseWord(p, w))
+	return false;
+
+      v = T(w);
+      return W(v) == w;
+    }
+
+    inline bool parseWord(const char*& p, int& v)            {return parseNarrow<int,long int>(p, v);}
+    inline bool parseWord(const char*& p, short int& v)      {return parseNarrow<short int,long int>(p, v);}
+    inline bool parseWord(const char*& p, unsigned int& v)   {return parseNarrow<unsigned int,unsigned long int>(p, v);}
+    inline bool parseWord(const char*& p, unsigned short int& v) {return parseNarrow<unsigned short int,unsigned long int>(p, v);}
+
+    // Booleans are written as 0 or 1
+    inline bool parseWord(const char*& p, bool& v)
+    {
+      long int w;
+      if (! parseWord(p, w) || (w != 0 && w != 1))
+	return false;
+
+      v = (w == 1);
+      return true;
+    }
+
+    inline const char* skipSpace(const char* p)
+    {
+      while (*p != '\0' && isspace((unsigned char)*p))
+	++p;
+      return p;
+    }
+
+    //! Parse a whitespace separated list; returns the length or -1 on error
+    template<typename T>
+    int parseList(const std::string& list_string, multi1d<T>& result)
+    {
+      // Count the tokens first so the result is allocated once
+      int n = 0;
+      for(const char* p = skipSpace(list_string.c_str()); *p != '\0'; p = skipSpace(p))
+      {
+	++n;
+	while (*p != '\0' && ! isspace((unsigned char)*p))
+	  ++p;
+      }
+
+      result.resize(n);
+
+      const char* p = list_string.c_str();
+      for(int i=0; i < n; ++i)
+      {
+	p = skipSpace(p);
+	if (! parseWord(p, result[i]))
+	  return -1;
+      }
+
+      return n;
+    }
+  }
+
+  template<typename T>
+  void XMLReader::readArray(const std::string& xpath, multi1d<T>& result)
+  {
+    int n = 0;
+
+    if (local || Layout::primaryNode())
+    {
+      std::string list_string;
+      BasicXPathReader::get(xpath, list_string);
+      n = parseList(list_string, result);
+    }
+
+    // The length, then the values in one message
+    if (! local)
+    {
+      QDPInternal::broadcast(n);
+
+      if (n >= 0 && ! Layout::primaryNode())
+	result.resize(n);
+
+      if (n > 0)
+	QDPInternal::broadcast((void*)&result[0], n*sizeof(T));
+    }
+
+    if (n < 0)
+    {
+      std::ostringstream error_message;
+      error_message << "Error in reading array " << xpath << std::endl;
+      throw error_message.str();
+    }
+  }
+
   template<typename T>
   void XMLReader::readAttrPrimitive(const std::string& xpath, 
 				    const std::string& attrib_name, 
 				    T& result)
   {
+    if (local)
+    {
+      BasicXPathReader::getAttribute(xpath, attrib_name, result);
+      return;
+    }
+
     if (Layout::primaryNode()) {
       BasicXPathReader::getAttribute(xpath, attrib_name, result);
     }
@@ -208,6 +494,12 @@ namespace QDP
     std::ostringstream newos;
     std::string s;
 
+    if (local)
+    {
+      BasicXPathReader::print(os);
+      return;
+    }
+
     if (Layout::primaryNode())
     {
       BasicXPathReader::print(newos);
@@ -224,6 +516,15 @@ namespace QDP
     std::ostringstream newos;
     std::string s;
 
+    if (local)
+    {
+      if (is_derived())
+	BasicXPathReader::printChildren(os);
+      else
+	BasicXPathReader::printRoot(os);
+      return;
+    }
+
     if (Layout::primaryNode())
     {
       if (is_derived())
@@ -242,6 +543,9 @@ namespace QDP
   int XMLReader::count(const std::string& xpath)
   {
     int n;
+    if (local)
+      return BasicXPathReader::count(xpath);
+
     if (Layout::primaryNode())
       n = BasicXPathReader::count(xpath);
 
@@ -253,7 +557,7 @@ namespace QDP
   // Namespace Registration?
   void XMLReader::registerNamespace(const std::string& prefix, const std::string& uri)
   {
-    if (Layout::primaryNode())
+    if (local || Layout::primaryNode())
       BasicXPathReader::registerNamespace(prefix, uri);
   }
 
@@ -311,46 +615,19 @@ namespace QDP
   template<typename T>
   void readArrayPrimitive(XMLReader& xml, const std::string& s, multi1d<T>& result)
   {
-    std::ostringstream error_message;
-  
-    // Try reading the list as a string
-    std::string list_string;
-    read(xml, s, list_string);
-
-    // Count the number of elements
-    std::istringstream list_stream(list_string);
-	
-    int array_size = 0;
-    T dummy;
-    while(list_stream >> dummy)
-      ++array_size;
-
-    if ((! list_stream.eof()) && list_stream.fail())
-    {
-      error_message << "Error in reading array " << s << std::endl;
-      throw error_message.str();
-    }
-
-    // It is not an error to have a zero-length array
-    //  if (array_size == 0)
-    //  {
-    //    error_message << "Something wrong with reading array " << list_string << std::endl;
-    //    throw error_message.str();
-    //  }
-      
-    // Now resize the array to hold the no of elements.
-    result.resize(array_size);
+    xml.get(s, result);
+  }
 
-    // Get the elements one by one
-    // I do not understand why, but use a new stringstream
-    //  list_stream.str(list_string);
-    std::istringstream list_stream2(list_string);
+  //! Read a XML multi1d element of QDP words through their plain type
+  template<typename T, typename W>
+  void readArrayWord(XMLReader& xml, const std::string& s, multi1d<T>& result)
+  {
+    multi1d<W> words;
+    xml.get(s, words);
 
-    for(int i=0; i < result.size(); i++) 
-    {
-      // read the element.
-      list_stream2 >> result[i];
-    }
+    result.resize(words.size());
+    for(int i=0; i < words.size(); i++) 
+      result[i] = words[i];
   }
 
   template<>
@@ -401,22 +678,22 @@ namespace QDP
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Integer>& result)
   {
-    readArrayPrimitive<Integer>(xml, xpath, result);
+    readArrayWord<Integer,int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Real32>& result)
   {
-    readArrayPrimitive<Real32>(xml, xpath, result);
+    readArrayWord<Real32,float>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Real64>& result)
   {
-    readArrayPrimitive<Real64>(xml, xpath, result);
+    readArrayWord<Real64,double>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Boolean>& result)
   {
-    readArrayPrimitive<Boolean>(xml, xpath, result);
+    readArrayWord<Boolean,bool>(xml, xpath, result);
   }
 
 
@@ -744,6 +1021,167 @@ namespace QDP
   }
 
 
+  // Number formatting for the list writer. Each writes one number at buf
+  // and returns the number of characters, at most max_word_len.
+  namespace
+  {
+    const int max_word_len = 32;
+
+    // Chunk of text handed to the stream at a time
+    const int list_chunk = 64*1024;
+
+    std::vector<char> list_buf;
+
+    inline int formatWord(char* buf, unsigned long int v)
+    {
+      char tmp[24];
+      int n = 0;
+      do
+      {
+	tmp[n++] = '0' + char(v % 10);
+	v /= 10;
+      }
+      while (v != 0);
+
+      for(int i=0; i < n; ++i)
+	buf[i] = tmp[n-1-i];
+
+      return n;
+    }
+
+    inline int formatWord(char* buf, long int v)
+    {
+      if (v >= 0)
+	return formatWord(buf, (unsigned long int)v);
+
+      buf[0] = '-';
+      return 1 + formatWord(buf+1, 0UL - (unsigned long int)v);
+    }
+
+    inline int formatWord(char* buf, int v)                {return formatWord(buf, (long int)v);}
+    inline int formatWord(char* buf, short int v)          {return formatWord(buf, (long int)v);}
+    inline int formatWord(char* buf, unsigned int v)       {return formatWord(buf, (unsigned long int)v);}
+    inline int formatWord(char* buf, unsigned short int v) {return formatWord(buf, (unsigned long int)v);}
+
+    inline int formatWord(char* buf, bool v)
+    {
+      buf[0] = v ? '1' : '0';
+      return 1;
+    }
+
+    // The same digits as an ostream with precision 7 and 15. In round
+    // trip mode, the fewest digits that read back to the same value. Any
+    // number of digits up to digits10 is exact if more digits are, so
+    // the search starts there
+    inline int formatWord(char* buf, float v)
+    {
+      if (! xml_round_trip)
+	return snprintf(buf, max_word_len, "%.7g", double(v));
+
+      int n = 0;
+      for(int prec = std::numeric_limits<float>::digits10; prec <= std::numeric_limits<float>::max_digits10; ++prec)
+      {
+	n = snprintf(buf, max_word_len, "%.*g", prec, double(v));
+	if (strtof(buf, 0) == v)
+	  break;
+      }
+      return n;
+    }
+
+    inline int formatWord(char* buf, double v)
+    {
+      if (! xml_round_trip)
+	return snprintf(buf, max_word_len, "%.15g", v);
+
+      int n = 0;
+      for(int prec = std::numeric_limits<double>::digits10; prec <= std::numeric_limits<double>::max_digits10; ++prec)
+      {
+	n = snprintf(buf, max_word_len, "%.*g", prec, v);
+	if (strtod(buf, 0) == v)
+	  break;
+      }
+      return n;
+    }
+  }
+
+  template<typename T>
+  void XMLWriter::writeListPrimitive(const T* output, int n)
+  {
+    if (! Layout::primaryNode())
+      return;
+
+    if (list_buf.size() < size_t(list_chunk + max_word_len + 1))
+      list_buf.resize(list_chunk + max_word_len + 1);
+
+    char* buf = &list_buf[0];
+    int pos = 0;
+    bool first_chunk = true;
+
+    for(int i=0; i < n; ++i)
+    {
+      if (pos >= list_chunk)
+      {
+	// The first chunk goes through the writer so it knows the tag
+	// has contents, the rest straight to the stream
+	if (first_chunk)
+	  XMLSimpleWriter::write(std::string(buf, pos));
+	else
+	  getOstream().write(buf, pos);
+
+	first_chunk = false;
+	pos = 0;
+      }
+
+      if (i > 0)
+	buf[pos++] = ' ';
+
+      pos += formatWord(buf+pos, output[i]);
+    }
+
+    if (first_chunk)
+      XMLSimpleWriter::write(std::string(buf, pos));
+    else
+      getOstream().write(buf, pos);
+  }
+
+  void XMLWriter::writeList(const int* output, int n)
+  {
+    writeListPrimitive<int>(output, n);
+  }
+  void XMLWriter::writeList(const unsigned int* output, int n)
+  {
+    writeListPrimitive<unsigned int>(output, n);
+  }
+  void XMLWriter::writeList(const short int* output, int n)
+  {
+    writeListPrimitive<short int>(output, n);
+  }
+  void XMLWriter::writeList(const unsigned short int* output, int n)
+  {
+    writeListPrimitive<unsigned short int>(output, n);
+  }
+  void XMLWriter::writeList(const long int* output, int n)
+  {
+    writeListPrimitive<long int>(output, n);
+  }
+  void XMLWriter::writeList(const unsigned long int* output, int n)
+  {
+    writeListPrimitive<unsigned long int>(output, n);
+  }
+  void XMLWriter::writeList(const float* output, int n)
+  {
+    writeListPrimitive<float>(output, n);
+  }
+  void XMLWriter::writeList(const double* output, int n)
+  {
+    writeListPrimitive<double>(output, n);
+  }
+  void XMLWriter::writeList(const bool* output, int n)
+  {
+    writeListPrimitive<bool>(output, n);
+  }
+
+
   // Push a group name
   void push(XMLWriter& xml, const std::string& s) {xml.openStruct(s);}
 
@@ -869,21 +1307,30 @@ namespace QDP
   template<typename T>
   void writeArrayPrimitive(XMLWriter& xml, const std::string& s, const multi1d<T>& s1)
   {
-    std::ostringstream output;
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
     // Write the array - do not use a normal string write
     xml.openTag(s);
-    xml << output.str();
+    xml.writeList(s1.slice(), s1.size());
     xml.closeTag();
   }
 
+  // Write an array of QDP words through their plain type
+  template<typename T, typename W>
+  void writeArrayWord(XMLWriter& xml, const std::string& s, const multi1d<T>& s1,
+		      W (*conv)(const T&))
+  {
+    multi1d<W> words(s1.size());
+    if (Layout::primaryNode())
+      for(int i=0; i < s1.size(); i++) 
+	words[i] = conv(s1[i]);
+
+    writeArrayPrimitive<W>(xml, s, words);
+  }
+
+  static int    wordInt(const Integer& d)    {return toInt(d);}
+  static float  wordFloat(const Real32& d)   {return toFloat(d);}
+  static double wordDouble(const Real64& d)  {return toDouble(d);}
+  static bool   wordBool(const Boolean& d)   {return toBool(d);}
+
 
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<int>& output)
@@ -916,40 +1363,14 @@ namespace QDP
     writeArrayPrimitive<unsigned long int>(xml, xpath, output);
   }
   template<>
-  void write(XMLWriter& xml, const std::string& s, const multi1d<float>& s1)
+  void write(XMLWriter& xml, const std::string& xpath, const multi1d<float>& output)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeArrayPrimitive<float>(xml, xpath, output);
   }
   template<>
-  void write(XMLWriter& xml, const std::string& s, const multi1d<double>& s1)
+  void write(XMLWriter& xml, const std::string& xpath, const multi1d<double>& output)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeArrayPrimitive<double>(xml, xpath, output);
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<bool>& output)
@@ -959,48 +1380,22 @@ namespace QDP
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<Integer>& output)
   {
-    writeArrayPrimitive<Integer>(xml, xpath, output);
+    writeArrayWord(xml, xpath, output, wordInt);
   }
   template<>
-  void write(XMLWriter& xml, const std::string& s, const multi1d<Real32>& s1)
+  void write(XMLWriter& xml, const std::string& xpath, const multi1d<Real32>& output)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeArrayWord(xml, xpath, output, wordFloat);
   }
   template<>
-  void write(XMLWriter& xml, const std::string& s, const multi1d<Real64>& s1)
+  void write(XMLWriter& xml, const std::string& xpath, const multi1d<Real64>& output)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeArrayWord(xml, xpath, output, wordDouble);
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<Boolean>& output)
   {
-    writeArrayPrimitive<Boolean>(xml, xpath, output);
+    writeArrayWord(xml, xpath, output, wordBool);
   }
 
 
@@ -1321,6 +1716,10 @@ namespace QDP
   {
     if (Layout::primaryNode())
     {
+      // Hand the file large blocks; the buffer must be set before opening
+      output_buf.resize(1024*1024);
+      output_stream.rdbuf()->pubsetbuf(&output_buf[0], output_buf.size());
+
       output_stream.open(filename.c_str(), std::ofstream::out);
       if (output_stream.fail())
       {